@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 struct Command;
 struct UnitDef;
@@ -20,6 +21,10 @@ class CGroupHandler;
 class CGroup;
 class CUnit;
 
+namespace netcode {
+	class RawPacket;
+}
+
 /** Generalized legacy callback interface backend */
 class CAICallback
 {
@@ -27,10 +32,15 @@ private:
 	int team = -1;
 
 	bool allowOrders = true;
+	bool queueOrders = false;
+
+	/// packets (orders, shares, map-draws, ...) held back while queueOrders is set
+	std::vector< std::shared_ptr<const netcode::RawPacket> > queuedPackets;
 
 private:
 	// utility methods
 	void verify();
+	void SendOrderPacket(std::shared_ptr<const netcode::RawPacket> packet);
 
 	/// Returns the unit if the ID is valid
 	CUnit* GetUnit(int unitId) const;
@@ -47,6 +57,9 @@ public:
 	CAICallback(int teamId);
 
 	void AllowOrders(bool b) { allowOrders = b; }
+	/// hold back (true) or send (false, including all held back) outgoing packets
+	void QueueOrders(bool b);
+	bool IsQueueingOrders() const { return queueOrders; }
 
 	void SendStartPos(bool ready, float3 pos);
 	void SendTextMsg(const char* text, int zone);
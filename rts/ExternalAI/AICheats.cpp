@@ -148,9 +148,10 @@ static inline bool unit_IsNeutral(CUnit* unit) {
 	return unit->IsNeutral();
 }
 
-static int myAllyTeamId = -1;
+// per-thread, AI's can be updated concurrently (AIParallelUpdate)
+static thread_local int myAllyTeamId = -1;
 
-/// You have to set myAllyTeamId before callign this function. NOT thread safe!
+/// You have to set myAllyTeamId before calling this function.
 static inline bool unit_IsEnemy(CUnit* unit) {
 	return (!teamHandler.Ally(unit->allyteam, myAllyTeamId) && !unit_IsNeutral(unit));
 }
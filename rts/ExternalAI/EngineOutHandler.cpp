@@ -5,6 +5,7 @@
 #include "ExternalAI/SkirmishAIWrapper.h"
 #include "ExternalAI/SkirmishAIData.h"
 #include "ExternalAI/SkirmishAIHandler.h"
+#include "ExternalAI/SSkirmishAICallbackImpl.h"
 #include "ExternalAI/AILibraryManager.h"
 #include "ExternalAI/Interface/AISCommands.h"
 #include "Game/GlobalUnsynced.h"
@@ -19,9 +20,16 @@
 #include "Sim/Units/CommandAI/Command.h"
 #include "Sim/Weapons/WeaponDef.h"
 #include "Net/Protocol/NetProtocol.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/Log/ILog.h"
 #include "System/TimeProfiler.h"
 #include "System/SafeUtil.h"
+#include "System/Threading/ThreadPool.h"
+
+#include <algorithm>
+
+
+CONFIG(bool, AIParallelUpdate).defaultValue(false).description("Update native Skirmish AI's in parallel; AI's that use cheats or are not written in C or C++ are still updated one at a time.");
 
 
 CR_BIND(CEngineOutHandler, )
@@ -29,6 +37,9 @@ CR_REG_METADATA(CEngineOutHandler, (
 	CR_IGNORED(hostSkirmishAIs),
 	CR_IGNORED(teamSkirmishAIs),
 	CR_IGNORED(activeSkirmishAIs),
+	CR_IGNORED(sortedSkirmishAIs),
+	CR_IGNORED(parallelSkirmishAIs),
+	CR_IGNORED(parallelUpdate),
 
 	CR_POSTLOAD(PostLoad)
 ))
@@ -88,6 +99,15 @@ void CEngineOutHandler::Destroy() {
 	}
 
 
+void CEngineOutHandler::Init()
+{
+	activeSkirmishAIs.reserve(16);
+	sortedSkirmishAIs.reserve(16);
+	parallelSkirmishAIs.reserve(16);
+
+	parallelUpdate = configHandler->GetBool("AIParallelUpdate");
+}
+
 void CEngineOutHandler::PostLoad()
 {
 	AI_SCOPED_TIMER();
@@ -127,7 +147,45 @@ void CEngineOutHandler::Save(std::ostream* s, const uint8_t skirmishAIId) {
 
 void CEngineOutHandler::Update() {
 	AI_SCOPED_TIMER();
-	DO_FOR_SKIRMISH_AIS(Update(gs->frameNum))
+
+	if (!parallelUpdate || activeSkirmishAIs.size() == 1) {
+		DO_FOR_SKIRMISH_AIS(Update(gs->frameNum))
+		return;
+	}
+
+	sortedSkirmishAIs.assign(activeSkirmishAIs.begin(), activeSkirmishAIs.end());
+	parallelSkirmishAIs.clear();
+
+	std::sort(sortedSkirmishAIs.begin(), sortedSkirmishAIs.end());
+
+	for (uint8_t aiID: sortedSkirmishAIs) {
+		if (!hostSkirmishAIs[aiID].CanUpdateMT())
+			continue;
+
+		parallelSkirmishAIs.push_back(aiID);
+		skirmishAiCallback_QueueOrders(&hostSkirmishAIs[aiID], true);
+	}
+
+	// the simulation is halted until all AI's return, so they can read its
+	// state concurrently; callbacks that are not safe for this serialize on
+	// their own, orders are held back and sent below
+	for_mt(0, parallelSkirmishAIs.size(), [&](const int i) {
+		hostSkirmishAIs[ parallelSkirmishAIs[i] ].UpdateMT(gs->frameNum);
+	});
+
+	// send the held back orders and update the remaining AI's in order of
+	// their ID's, such that the packet stream is independent of thread timings
+	for (size_t i = 0, j = 0, n = sortedSkirmishAIs.size(); i < n; i++) {
+		const uint8_t aiID = sortedSkirmishAIs[i];
+
+		if (j < parallelSkirmishAIs.size() && parallelSkirmishAIs[j] == aiID) {
+			skirmishAiCallback_QueueOrders(&hostSkirmishAIs[aiID], false);
+			j++;
+			continue;
+		}
+
+		hostSkirmishAIs[aiID].Update(gs->frameNum);
+	}
 }
 
 
@@ -31,7 +31,7 @@ public:
 	static void Create();
 	static void Destroy();
 
-	void Init() { activeSkirmishAIs.reserve(16); }
+	void Init();
 	void Kill() {
 		PreDestroy();
 
@@ -116,6 +116,12 @@ private:
 	std::array<std::vector<uint8_t>, MAX_TEAMS> teamSkirmishAIs;
 
 	std::vector<uint8_t> activeSkirmishAIs;
+	/// activeSkirmishAIs in ID order, and the subset of those which
+	/// are updated concurrently (see AIParallelUpdate)
+	std::vector<uint8_t> sortedSkirmishAIs;
+	std::vector<uint8_t> parallelSkirmishAIs;
+
+	bool parallelUpdate = false;
 };
 
 #define eoh CEngineOutHandler::GetInstance()
@@ -375,6 +375,54 @@ struct SSkirmishAICallback {
 
 	float             (CALLING_CONV *Game_getTeamResourceExcess)(int skirmishAIId, int otherTeamId, int resourceId);
 
+	/**
+	 * Returns the sum of what all units of another team made of a resource
+	 * during the last slow-update (see Unit_getResourceMake).
+	 * Allways works for allied teams.
+	 * Works for all teams when cheating is enabled.
+	 * @return summed production of the requested resource, or -1.0 on an invalid request
+	 */
+	float             (CALLING_CONV *Game_getTeamResourceUnitsMake)(int skirmishAIId, int otherTeamId, int resourceId);
+
+	/**
+	 * Returns the sum of what all units of another team used of a resource
+	 * during the last slow-update (see Unit_getResourceUse).
+	 * Allways works for allied teams.
+	 * Works for all teams when cheating is enabled.
+	 * @return summed usage of the requested resource, or -1.0 on an invalid request
+	 */
+	float             (CALLING_CONV *Game_getTeamResourceUnitsUse)(int skirmishAIId, int otherTeamId, int resourceId);
+
+	/**
+	 * Returns how many units of a kind another team has; maintained by the
+	 * engine, so this is cheaper than iterating over the team's units.
+	 * Allways works for allied teams.
+	 * Works for all teams when cheating is enabled.
+	 * @param unitCountType 0: all, 1: finished, 2: being built,
+	 *   3: mobile (excluding aircraft), 4: static, 5: aircraft,
+	 *   6: builders (including factories), 7: factories, 8: armed
+	 * @return number of units, or -1 on an invalid request
+	 */
+	int               (CALLING_CONV *Game_getTeamUnitCount)(int skirmishAIId, int otherTeamId, int unitCountType);
+
+	/**
+	 * Returns the summed build-speed (as in UnitDef_getBuildSpeed) of all
+	 * finished builders and factories of another team.
+	 * Allways works for allied teams.
+	 * Works for all teams when cheating is enabled.
+	 * @return total build-power, or -1.0 on an invalid request
+	 */
+	float             (CALLING_CONV *Game_getTeamBuildPower)(int skirmishAIId, int otherTeamId);
+
+	/**
+	 * Returns the part of Game_getTeamBuildPower belonging to builders and
+	 * factories that are currently building, repairing, reclaiming, etc.
+	 * Allways works for allied teams.
+	 * Works for all teams when cheating is enabled.
+	 * @return used build-power, or -1.0 on an invalid request
+	 */
+	float             (CALLING_CONV *Game_getTeamBuildPowerUsed)(int skirmishAIId, int otherTeamId);
+
 	/// Returns true, if the two supplied ally-teams are currently allied
 	bool              (CALLING_CONV *Game_isAllied)(int skirmishAIId, int firstAllyTeamId, int secondAllyTeamId);
 
@@ -1125,6 +1173,32 @@ struct SSkirmishAICallback {
 	 */
 	int               (CALLING_CONV *getSelectedUnits)(int skirmishAIId, int* unitIds, int unitIds_sizeMax); //$ FETCHER:MULTI:IDs:Unit:unitIds
 
+	/**
+	 * Fills columnar arrays with the state of all units this AI can currently
+	 * see, in one pass instead of one call per unit and attribute.
+	 * Covers all units in this teams ally-team plus all others that are in
+	 * LOS or radar, or all units on the map if cheats are enabled.
+	 * Every value matches what the corresponding Unit_get* function would
+	 * return, eg. radar-only units have a def and team of -1, an approximate
+	 * position and a health of -1.
+	 * Any of the arrays may be NULL; if all of them are, units_sizeMax is
+	 * ignored and the number of all visible units is returned.
+	 * @param unitIds, unitDefIds, teamIds, healths one value per unit
+	 * @param positions_AposF3, velocities_AposF3 three values per unit
+	 * @param losStates one value per unit, bit-field of
+	 *   1: in LOS, 2: in radar, 4: previously in LOS,
+	 *   8: continuously in radar since last in LOS;
+	 *   allied units (and all units when cheating) report 15
+	 * @param units_sizeMax maximum number of units to write
+	 * @return number of units written (or counted)
+	 * @see Unit_getDef
+	 * @see Unit_getTeam
+	 * @see Unit_getPos
+	 * @see Unit_getVel
+	 * @see Unit_getHealth
+	 */
+	int               (CALLING_CONV *getUnitsSnapshot)(int skirmishAIId, int* unitIds, int* unitDefIds, int* teamIds, float* positions_AposF3, float* velocities_AposF3, float* healths, int* losStates, int units_sizeMax);
+
 	/**
 	 * Returns the unit's unitdef struct from which you can read all
 	 * the statistics of the unit, do NOT try to change any values in it.
@@ -1664,6 +1738,16 @@ struct SSkirmishAICallback {
 	 */
 	void              (CALLING_CONV *Map_getResourceMapSpotsNearest)(int skirmishAIId, int resourceId, float* pos_posF3, float* return_posF3_out); //$ REF:resourceId->Resource
 
+	/**
+	 * Returns how deep each square of the resource-map is already being
+	 * extracted by existing extractors, in the layout of Map_getResourceMapRaw.
+	 * A new extractor only gains from squares where its own extraction depth
+	 * (see UnitDef_getExtractsResource) exceeds this value, so together with
+	 * Map_getResourceMapRaw this tells what is left to take across the whole
+	 * map in one call.
+	 */
+	int               (CALLING_CONV *Map_getResourceMapExtraction)(int skirmishAIId, int resourceId, float* extractions, int extractions_sizeMax); //$ REF:resourceId->Resource ARRAY:extractions
+
 	/**
 	 * Returns the archive hash of the map.
 	 * Use this for reference to the map, eg. in a cache-file, wherever human
@@ -1869,6 +1953,20 @@ struct SSkirmishAICallback {
 	 */
 	int               (CALLING_CONV *getFeaturesIn)(int skirmishAIId, float* pos_posF3, float radius, bool spherical, int* featureIds, int featureIds_sizeMax); //$ REF:MULTI:featureIds->Feature
 
+	/**
+	 * Fills columnar arrays with the state of all features returned by
+	 * getFeatures, in one pass instead of one call per feature and attribute.
+	 * Any of the arrays may be NULL; if all of them are, features_sizeMax is
+	 * ignored and the number of all visible features is returned.
+	 * @param featureIds, featureDefIds, healths, reclaimLefts one value per feature
+	 * @param positions_AposF3 three values per feature
+	 * @param resources two values per feature, the metal and energy it yields
+	 *   when reclaimed completely, ie. not yet scaled by reclaimLeft
+	 * @param features_sizeMax maximum number of features to write
+	 * @return number of features written (or counted)
+	 */
+	int               (CALLING_CONV *getFeaturesSnapshot)(int skirmishAIId, int* featureIds, int* featureDefIds, float* positions_AposF3, float* healths, float* reclaimLefts, float* resources, int features_sizeMax);
+
 	int               (CALLING_CONV *Feature_getDef)(int skirmishAIId, int featureId); //$ REF:RETURN->FeatureDef
 
 	float             (CALLING_CONV *Feature_getHealth)(int skirmishAIId, int featureId);
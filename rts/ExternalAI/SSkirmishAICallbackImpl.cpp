@@ -44,6 +44,7 @@
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/QuadField.h" // for quadField.GetFeaturesExact(pos, radius)
 #include "System/SafeCStrings.h"
+#include "System/Threading/SpringThreading.h"
 #include "System/SpringMath.h"
 #include "System/FileSystem/ArchiveScanner.h"
 #include "System/Log/ILog.h"
@@ -65,6 +66,15 @@ static constexpr size_t MAX_NUM_MARKERS = 16384;
 static inline CAICallback* GetCallBack(int skirmishAIId) { return &AI_LEGACY_CALLBACKS[skirmishAIId].first; }
 static inline CAICheats* GetCheatCallBack(int skirmishAIId) { return &AI_LEGACY_CALLBACKS[skirmishAIId].second; }
 
+// held by callbacks that touch engine state which is unsafe to access from
+// more than one thread (QuadField queries, path-manager, VFS, logging, lazy
+// caches, static buffers, Lua, ...) since with AIParallelUpdate enabled AI's
+// run their EVENT_UPDATE concurrently; plain getters do not need it because
+// the simulation does not advance while AI's are being updated
+static spring::recursive_mutex AI_CALLBACK_MUTEX;
+
+#define AI_CALLBACK_SERIALIZED() std::lock_guard<spring::recursive_mutex> lock(AI_CALLBACK_MUTEX)
+
 
 static void CheckSkirmishAIId(int skirmishAIId, const char* caller) {
 	if (skirmishAIId >= 0 && skirmishAIId < MAX_AIS)
@@ -206,17 +216,12 @@ static float getRulesParamFloatValueByName(
 	const char* rulesParamName,
 	float defaultValue
 ) {
-	float value = defaultValue;
-	const std::string key(rulesParamName);
-	const auto it = params.find(key);
-
-	if (it == params.end())
-		return value;
+	const LuaRulesParams::Param* param = params.Find(rulesParamName);
 
-	if (modParamIsVisible(it->second, losMask))
-		value = it->second.valueInt;
+	if (param == nullptr || !modParamIsVisible(*param, losMask))
+		return defaultValue;
 
-	return value;
+	return param->valueInt;
 }
 
 static const char* getRulesParamStringValueByName(
@@ -225,17 +230,12 @@ static const char* getRulesParamStringValueByName(
 	const char* rulesParamName,
 	const char* defaultValue
 ) {
-	const char* value = defaultValue;
-	const std::string key(rulesParamName);
-	const auto it = params.find(key);
-
-	if (it == params.end())
-		return value;
+	const LuaRulesParams::Param* param = params.Find(rulesParamName);
 
-	if (modParamIsVisible(it->second, losMask))
-		value = it->second.valueString.c_str();
+	if (param == nullptr || !modParamIsVisible(*param, losMask))
+		return defaultValue;
 
-	return value;
+	return param->valueString.c_str();
 }
 
 
@@ -645,6 +645,8 @@ EXPORT(int) skirmishAiCallback_Engine_handleCommand(
 	int commandTopic,
 	void* commandData
 ) {
+	AI_CALLBACK_SERIALIZED();
+
 	int ret = 0;
 
 	CAICallback* clb = GetCallBack(skirmishAIId);
@@ -654,6 +656,37 @@ EXPORT(int) skirmishAiCallback_Engine_handleCommand(
 	if (skirmishAiCallback_Cheats_isEnabled(skirmishAIId))
 		clbCheat = GetCheatCallBack(skirmishAIId);
 
+	// during a parallel update other AI's read the simulation without taking
+	// AI_CALLBACK_MUTEX, so Lua (which can change anything) and chat actions
+	// may not run until this AI is updated serially again; packets (orders,
+	// map-draws, ...) are queued instead and sent in AI-id order afterwards
+	if (clb->IsQueueingOrders()) {
+		switch (commandTopic) {
+			case COMMAND_CALL_LUA_RULES: {
+				SCallLuaRulesCommand* cmd = static_cast<SCallLuaRulesCommand*>(commandData);
+
+				if (cmd->ret_outData != nullptr)
+					cmd->ret_outData[0] = '\0';
+
+				return -1;
+			} break;
+			case COMMAND_CALL_LUA_UI: {
+				SCallLuaUICommand* cmd = static_cast<SCallLuaUICommand*>(commandData);
+
+				if (cmd->ret_outData != nullptr)
+					cmd->ret_outData[0] = '\0';
+
+				return -1;
+			} break;
+			case COMMAND_SEND_TEXT_MESSAGE:
+			case COMMAND_SET_LAST_POS_MESSAGE: {
+				return -1;
+			} break;
+			default: {
+			} break;
+		}
+	}
+
 	switch (commandTopic) {
 		case COMMAND_CHEATS_SET_MY_INCOME_MULTIPLIER: {
 			const SSetMyIncomeMultiplierCheatCommand* cmd = static_cast<SSetMyIncomeMultiplierCheatCommand*>(commandData);
@@ -1318,6 +1351,8 @@ EXPORT(const char*) skirmishAiCallback_SkirmishAI_OptionValues_getValueByKey(int
 
 
 EXPORT(void) skirmishAiCallback_Log_log(int skirmishAIId, const char* const msg) {
+	AI_CALLBACK_SERIALIZED();
+
 	CheckSkirmishAIId(skirmishAIId, __func__);
 
 	const CSkirmishAILibraryInfo* info = getSkirmishAILibraryInfo(skirmishAIId);
@@ -1327,6 +1362,8 @@ EXPORT(void) skirmishAiCallback_Log_log(int skirmishAIId, const char* const msg)
 }
 
 EXPORT(void) skirmishAiCallback_Log_exception(int skirmishAIId, const char* const msg, int severity, bool die) {
+	AI_CALLBACK_SERIALIZED();
+
 	CheckSkirmishAIId(skirmishAIId, __func__);
 
 	const CSkirmishAILibraryInfo* info = getSkirmishAILibraryInfo(skirmishAIId);
@@ -1351,14 +1388,20 @@ EXPORT(int) skirmishAiCallback_DataDirs_Roots_getSize(int UNUSED_skirmishAIId) {
 }
 
 EXPORT(bool) skirmishAiCallback_DataDirs_Roots_getDir(int UNUSED_skirmishAIId, char* path, int pathMaxSize, int dirIndex) {
+	AI_CALLBACK_SERIALIZED();
+
 	return aiInterfaceCallback_DataDirs_Roots_getDir(-1, path, pathMaxSize, dirIndex);
 }
 
 EXPORT(bool) skirmishAiCallback_DataDirs_Roots_locatePath(int UNUSED_skirmishAIId, char* path, int pathMaxSize, const char* const relPath, bool writeable, bool create, bool dir) {
+	AI_CALLBACK_SERIALIZED();
+
 	return aiInterfaceCallback_DataDirs_Roots_locatePath(-1, path, pathMaxSize, relPath, writeable, create, dir);
 }
 
 EXPORT(char*) skirmishAiCallback_DataDirs_Roots_allocatePath(int UNUSED_skirmishAIId, const char* const relPath, bool writeable, bool create, bool dir) {
+	AI_CALLBACK_SERIALIZED();
+
 	return aiInterfaceCallback_DataDirs_Roots_allocatePath(-1, relPath, writeable, create, dir);
 }
 
@@ -1378,6 +1421,8 @@ EXPORT(bool) skirmishAiCallback_DataDirs_locatePath(
 	bool dir,
 	bool common
 ) {
+	AI_CALLBACK_SERIALIZED();
+
 	assert(relPath != nullptr);
 
 	const char ps = skirmishAiCallback_DataDirs_getPathSeparator(skirmishAIId);
@@ -1403,6 +1448,8 @@ EXPORT(char*) skirmishAiCallback_DataDirs_allocatePath(
 	bool dir,
 	bool common
 ) {
+	AI_CALLBACK_SERIALIZED();
+
 	static char path[2048];
 
 	if (!skirmishAiCallback_DataDirs_locatePath(skirmishAIId, &path[0], sizeof(path), relPath, writeable, create, dir, common))
@@ -1413,6 +1460,8 @@ EXPORT(char*) skirmishAiCallback_DataDirs_allocatePath(
 
 
 EXPORT(const char*) skirmishAiCallback_DataDirs_getWriteableDir(int skirmishAIId) {
+	AI_CALLBACK_SERIALIZED();
+
 	CheckSkirmishAIId(skirmishAIId, __func__);
 
 	static std::vector<std::string> writeableDataDirs;
@@ -1449,6 +1498,16 @@ EXPORT(bool) skirmishAiCallback_Cheats_isEnabled(int skirmishAIId) {
 
 EXPORT(bool) skirmishAiCallback_Cheats_setEnabled(int skirmishAIId, bool enabled)
 {
+	AI_CALLBACK_SERIALIZED();
+
+	// cheats modify the simulation directly, which is not allowed while other
+	// AI's are reading it during a parallel update (see CanUpdateMT); the AI
+	// can try again from a later serial event
+	if (enabled && GetCallBack(skirmishAIId)->IsQueueingOrders()) {
+		LOG_L(L_WARNING, "[%s] SkirmishAI (id %i, team %i) can not enable cheats during a parallel update", __func__, skirmishAIId, AI_TEAM_IDS[skirmishAIId]);
+		return false;
+	}
+
 	if ((AI_CHEAT_FLAGS[skirmishAIId].first = enabled) && !AI_CHEAT_FLAGS[skirmishAIId].second) {
 		LOG("[%s] SkirmishAI (id %i, team %i) is using cheats!", __func__, skirmishAIId, AI_TEAM_IDS[skirmishAIId]);
 		AI_CHEAT_FLAGS[skirmishAIId].second = true;
@@ -1651,6 +1710,82 @@ EXPORT(float) skirmishAiCallback_Game_getTeamResourceExcess(int skirmishAIId, in
 	return res;
 }
 
+static const TeamAggregates* GetTeamAggregates(int skirmishAIId, int otherTeamId)
+{
+	if (!teamHandler.IsValidTeam(otherTeamId))
+		return nullptr;
+
+	if (!teamHandler.AlliedTeams(AI_TEAM_IDS[skirmishAIId], otherTeamId) && !skirmishAiCallback_Cheats_isEnabled(skirmishAIId))
+		return nullptr;
+
+	return &teamHandler.Team(otherTeamId)->unitAggregates;
+}
+
+EXPORT(float) skirmishAiCallback_Game_getTeamResourceUnitsMake(int skirmishAIId, int otherTeamId, int resourceId)
+{
+	const TeamAggregates* aggregates = GetTeamAggregates(skirmishAIId, otherTeamId);
+
+	if (aggregates == nullptr)
+		return -1.0f;
+
+	if (resourceId == resourceHandler->GetMetalId())
+		return aggregates->unitResMake.metal;
+
+	if (resourceId == resourceHandler->GetEnergyId())
+		return aggregates->unitResMake.energy;
+
+	return -1.0f;
+}
+
+EXPORT(float) skirmishAiCallback_Game_getTeamResourceUnitsUse(int skirmishAIId, int otherTeamId, int resourceId)
+{
+	const TeamAggregates* aggregates = GetTeamAggregates(skirmishAIId, otherTeamId);
+
+	if (aggregates == nullptr)
+		return -1.0f;
+
+	if (resourceId == resourceHandler->GetMetalId())
+		return aggregates->unitResUse.metal;
+
+	if (resourceId == resourceHandler->GetEnergyId())
+		return aggregates->unitResUse.energy;
+
+	return -1.0f;
+}
+
+EXPORT(int) skirmishAiCallback_Game_getTeamUnitCount(int skirmishAIId, int otherTeamId, int unitCountType)
+{
+	const TeamAggregates* aggregates = GetTeamAggregates(skirmishAIId, otherTeamId);
+
+	if (aggregates == nullptr)
+		return -1;
+
+	if (unitCountType < 0 || unitCountType >= TeamAggregates::UNITS_COUNT_TYPES)
+		return -1;
+
+	return (aggregates->GetUnitCount(unitCountType));
+}
+
+EXPORT(float) skirmishAiCallback_Game_getTeamBuildPower(int skirmishAIId, int otherTeamId)
+{
+	const TeamAggregates* aggregates = GetTeamAggregates(skirmishAIId, otherTeamId);
+
+	if (aggregates == nullptr)
+		return -1.0f;
+
+	return (aggregates->buildPower);
+}
+
+EXPORT(float) skirmishAiCallback_Game_getTeamBuildPowerUsed(int skirmishAIId, int otherTeamId)
+{
+	const TeamAggregates* aggregates = GetTeamAggregates(skirmishAIId, otherTeamId);
+
+	if (aggregates == nullptr)
+		return -1.0f;
+
+	return (aggregates->buildPowerUsed);
+}
+
 EXPORT(bool) skirmishAiCallback_Game_isAllied(int skirmishAIId, int firstAllyTeamId, int secondAllyTeamId) {
 	return teamHandler.Ally(firstAllyTeamId, secondAllyTeamId);
 }
@@ -2044,6 +2179,8 @@ EXPORT(int) skirmishAiCallback_Map_getResourceMapSpotsPositions(
 	float* spots,
 	int spotsMaxSize
 ) {
+	AI_CALLBACK_SERIALIZED();
+
 	const std::vector<float3>& intSpots = getResourceMapAnalyzer(resourceId)->GetSpots();
 	const int spotsRealSize = intSpots.size() * 3;
 
@@ -2064,6 +2201,8 @@ EXPORT(int) skirmishAiCallback_Map_getResourceMapSpotsPositions(
 }
 
 EXPORT(float) skirmishAiCallback_Map_getResourceMapSpotsAverageIncome(int skirmishAIId, int resourceId) {
+	AI_CALLBACK_SERIALIZED();
+
 	return getResourceMapAnalyzer(resourceId)->GetAverageIncome();
 }
 
@@ -2073,9 +2212,30 @@ EXPORT(void) skirmishAiCallback_Map_getResourceMapSpotsNearest(
 	float* pos_posF3,
 	float* return_posF3_out
 ) {
+	AI_CALLBACK_SERIALIZED();
+
 	getResourceMapAnalyzer(resourceId)->GetNearestSpot(pos_posF3, AI_TEAM_IDS[skirmishAIId]).copyInto(return_posF3_out);
 }
 
+EXPORT(int) skirmishAiCallback_Map_getResourceMapExtraction(
+	int skirmishAIId,
+	int resourceId,
+	float* extractions,
+	int extractionsMaxSize
+) {
+	if (resourceId != resourceHandler->GetMetalId())
+		return 0;
+
+	const int extractionsRealSize = metalMap.GetSizeX() * metalMap.GetSizeZ();
+	const int extractionsSize = std::min(extractionsRealSize, std::max(0, extractionsMaxSize));
+
+	if (extractions == nullptr)
+		return extractionsRealSize;
+
+	std::copy(metalMap.GetExtractionMap(), metalMap.GetExtractionMap() + extractionsSize, extractions);
+	return extractionsSize;
+}
+
 EXPORT(int) skirmishAiCallback_Map_getHash(int skirmishAIId) {
 	return archiveScanner->GetArchiveCompleteChecksum(mapInfo->map.name);
 }
@@ -2204,6 +2364,8 @@ EXPORT(int) skirmishAiCallback_Map_getSpeedModMap(
 
 
 EXPORT(bool) skirmishAiCallback_Map_isPossibleToBuildAt(int skirmishAIId, int unitDefId, float* pos_posF3, int facing) {
+	AI_CALLBACK_SERIALIZED();
+
 	return GetCallBack(skirmishAIId)->CanBuildAt(getUnitDefById(skirmishAIId, unitDefId), pos_posF3, facing);
 }
 
@@ -2216,6 +2378,8 @@ EXPORT(void) skirmishAiCallback_Map_findClosestBuildSite(
 	int facing,
 	float* return_posF3_out
 ) {
+	AI_CALLBACK_SERIALIZED();
+
 	const UnitDef* unitDef = getUnitDefById(skirmishAIId, unitDefId);
 	const float3 buildPos = GetCallBack(skirmishAIId)->ClosestBuildSite(unitDef, pos_posF3, searchRadius, minDist, facing);
 
@@ -2276,10 +2440,14 @@ EXPORT(void) skirmishAiCallback_Map_getMousePos(int skirmishAIId, float* return_
 
 
 EXPORT(int) skirmishAiCallback_File_getSize(int skirmishAIId, const char* fileName) {
+	AI_CALLBACK_SERIALIZED();
+
 	return GetCallBack(skirmishAIId)->GetFileSize(fileName);
 }
 
 EXPORT(bool) skirmishAiCallback_File_getContent(int skirmishAIId, const char* fileName, void* buffer, int bufferLen) {
+	AI_CALLBACK_SERIALIZED();
+
 	return GetCallBack(skirmishAIId)->ReadFile(fileName, buffer, bufferLen);
 }
 
@@ -3915,6 +4083,8 @@ EXPORT(int) skirmishAiCallback_getEnemyUnits(int skirmishAIId, int* unitIds, int
 }
 
 EXPORT(int) skirmishAiCallback_getEnemyUnitsIn(int skirmishAIId, float* pos_posF3, float radius, bool spherical, int* unitIds, int unitIdsMaxSize) {
+	AI_CALLBACK_SERIALIZED();
+
 	if (skirmishAiCallback_Cheats_isEnabled(skirmishAIId))
 		return GetCheatCallBack(skirmishAIId)->GetEnemyUnits(unitIds, pos_posF3, radius, spherical, unitIdsMaxSize);
 
@@ -3934,6 +4104,8 @@ EXPORT(int) skirmishAiCallback_getFriendlyUnits(int skirmishAIId, int* unitIds,
 }
 
 EXPORT(int) skirmishAiCallback_getFriendlyUnitsIn(int skirmishAIId, float* pos_posF3, float radius, bool spherical, int* unitIds, int unitIdsMaxSize) {
+	AI_CALLBACK_SERIALIZED();
+
 	return GetCallBack(skirmishAIId)->GetFriendlyUnits(unitIds, pos_posF3, radius, spherical, unitIdsMaxSize);
 }
 
@@ -3945,6 +4117,8 @@ EXPORT(int) skirmishAiCallback_getNeutralUnits(int skirmishAIId, int* unitIds, i
 }
 
 EXPORT(int) skirmishAiCallback_getNeutralUnitsIn(int skirmishAIId, float* pos_posF3, float radius, bool spherical, int* unitIds, int unitIdsMaxSize) {
+	AI_CALLBACK_SERIALIZED();
+
 	if (skirmishAiCallback_Cheats_isEnabled(skirmishAIId))
 		return GetCheatCallBack(skirmishAIId)->GetNeutralUnits(unitIds, pos_posF3, radius, spherical, unitIdsMaxSize);
 
@@ -3976,6 +4150,68 @@ EXPORT(int) skirmishAiCallback_getTeamUnits(int skirmishAIId, int* unitIds, int
 	return a;
 }
 
+EXPORT(int) skirmishAiCallback_getUnitsSnapshot(
+	int skirmishAIId,
+	int* unitIds,
+	int* unitDefIds,
+	int* teamIds,
+	float* positions_AposF3,
+	float* velocities_AposF3,
+	float* healths,
+	int* losStates,
+	int units_sizeMax
+) {
+	int numUnits = 0;
+
+	const bool cheating = skirmishAiCallback_Cheats_isEnabled(skirmishAIId);
+	const int allyTeamId = teamHandler.AllyTeam(AI_TEAM_IDS[skirmishAIId]);
+
+	// nothing to write, count all units regardless of units_sizeMax
+	const bool countOnly =
+		unitIds == nullptr && unitDefIds == nullptr && teamIds == nullptr &&
+		positions_AposF3 == nullptr && velocities_AposF3 == nullptr &&
+		healths == nullptr && losStates == nullptr;
+
+	// same visibility rules as the per-unit getters (CAICallback and CAICheats)
+	for (const CUnit* u: unitHandler.GetActiveUnits()) {
+		if (!countOnly && numUnits >= units_sizeMax)
+			break;
+
+		const bool allied = (cheating || teamHandler.Ally(allyTeamId, u->allyteam));
+		const int losStatus = allied? LOS_ALL_BITS: (u->losStatus[allyTeamId] & LOS_ALL_BITS);
+
+		if ((losStatus & (LOS_INLOS | LOS_INRADAR)) == 0)
+			continue;
+
+		const bool inLos = ((losStatus & LOS_INLOS) != 0);
+		const bool typed = (inLos || (losStatus & (LOS_PREVLOS | LOS_CONTRADAR)) == (LOS_PREVLOS | LOS_CONTRADAR));
+
+		const UnitDef* realDef = u->unitDef;
+		const UnitDef* seenDef = (cheating || realDef->decoyDef == nullptr)? realDef: realDef->decoyDef;
+
+		if (unitIds != nullptr)
+			unitIds[numUnits] = u->id;
+		if (unitDefIds != nullptr)
+			unitDefIds[numUnits] = (allied? realDef->id: (typed? seenDef->id: -1));
+		if (teamIds != nullptr)
+			teamIds[numUnits] = (inLos? u->team: -1);
+		if (positions_AposF3 != nullptr) {
+			const float3 pos = cheating? float3(u->midPos): u->GetErrorPos(allyTeamId);
+			pos.copyInto(&positions_AposF3[numUnits * 3]);
+		}
+		if (velocities_AposF3 != nullptr)
+			u->speed.copyInto(&velocities_AposF3[numUnits * 3]);
+		if (healths != nullptr)
+			healths[numUnits] = (allied? u->health: (inLos? (u->health * (seenDef->health / realDef->health)): -1.0f));
+		if (losStates != nullptr)
+			losStates[numUnits] = losStatus;
+
+		numUnits++;
+	}
+
+	return numUnits;
+}
+
 
 //########### BEGINN Team
 EXPORT(bool) skirmishAiCallback_Team_hasAIController(int skirmishAIId, int teamId) {
@@ -4210,6 +4446,8 @@ EXPORT(int) skirmishAiCallback_getFeatures(int skirmishAIId, int* featureIds, in
 }
 
 EXPORT(int) skirmishAiCallback_getFeaturesIn(int skirmishAIId, float* pos_posF3, float radius, bool spherical, int* featureIds, int featureIdsMaxSize) {
+	AI_CALLBACK_SERIALIZED();
+
 	if (skirmishAiCallback_Cheats_isEnabled(skirmishAIId)) {
 		// cheating
 		QuadFieldQuery qfQuery;
@@ -4237,6 +4475,58 @@ EXPORT(int) skirmishAiCallback_getFeaturesIn(int skirmishAIId, float* pos_posF3,
 	return GetCallBack(skirmishAIId)->GetFeatures(featureIds, featureIdsMaxSize, pos_posF3, radius, spherical);
 }
 
+EXPORT(int) skirmishAiCallback_getFeaturesSnapshot(
+	int skirmishAIId,
+	int* featureIds,
+	int* featureDefIds,
+	float* positions_AposF3,
+	float* healths,
+	float* reclaimLefts,
+	float* resources,
+	int features_sizeMax
+) {
+	int numFeatures = 0;
+
+	const bool cheating = skirmishAiCallback_Cheats_isEnabled(skirmishAIId);
+	const int allyTeamId = teamHandler.AllyTeam(AI_TEAM_IDS[skirmishAIId]);
+
+	// nothing to write, count all features regardless of features_sizeMax
+	const bool countOnly =
+		featureIds == nullptr && featureDefIds == nullptr && positions_AposF3 == nullptr &&
+		healths == nullptr && reclaimLefts == nullptr && resources == nullptr;
+
+	for (const int featureId: featureHandler.GetActiveFeatureIDs()) {
+		if (!countOnly && numFeatures >= features_sizeMax)
+			break;
+
+		const CFeature* f = featureHandler.GetFeature(featureId);
+
+		assert(f != nullptr);
+
+		if (!cheating && !f->IsInLosForAllyTeam(allyTeamId))
+			continue;
+
+		if (featureIds != nullptr)
+			featureIds[numFeatures] = f->id;
+		if (featureDefIds != nullptr)
+			featureDefIds[numFeatures] = f->def->id;
+		if (positions_AposF3 != nullptr)
+			f->pos.copyInto(&positions_AposF3[numFeatures * 3]);
+		if (healths != nullptr)
+			healths[numFeatures] = f->health;
+		if (reclaimLefts != nullptr)
+			reclaimLefts[numFeatures] = f->reclaimLeft;
+		if (resources != nullptr) {
+			resources[numFeatures * 2 + 0] = f->resources.metal;
+			resources[numFeatures * 2 + 1] = f->resources.energy;
+		}
+
+		numFeatures++;
+	}
+
+	return numFeatures;
+}
+
 
 EXPORT(int) skirmishAiCallback_Feature_getDef(int skirmishAIId, int featureId) {
 	const FeatureDef* def = nullptr;
@@ -5117,6 +5407,11 @@ static void skirmishAiCallback_init(SSkirmishAICallback* callback) {
 	callback->Game_getTeamResourceSent = &skirmishAiCallback_Game_getTeamResourceSent;
 	callback->Game_getTeamResourceReceived = &skirmishAiCallback_Game_getTeamResourceReceived;
 	callback->Game_getTeamResourceExcess = &skirmishAiCallback_Game_getTeamResourceExcess;
+	callback->Game_getTeamResourceUnitsMake = &skirmishAiCallback_Game_getTeamResourceUnitsMake;
+	callback->Game_getTeamResourceUnitsUse = &skirmishAiCallback_Game_getTeamResourceUnitsUse;
+	callback->Game_getTeamUnitCount = &skirmishAiCallback_Game_getTeamUnitCount;
+	callback->Game_getTeamBuildPower = &skirmishAiCallback_Game_getTeamBuildPower;
+	callback->Game_getTeamBuildPowerUsed = &skirmishAiCallback_Game_getTeamBuildPowerUsed;
 	callback->Game_isAllied = &skirmishAiCallback_Game_isAllied;
 	callback->Game_isDebugModeEnabled = &skirmishAiCallback_Game_isDebugModeEnabled;
 	callback->Game_isPaused = &skirmishAiCallback_Game_isPaused;
@@ -5358,6 +5653,7 @@ static void skirmishAiCallback_init(SSkirmishAICallback* callback) {
 	callback->getNeutralUnitsIn = &skirmishAiCallback_getNeutralUnitsIn;
 	callback->getTeamUnits = &skirmishAiCallback_getTeamUnits;
 	callback->getSelectedUnits = &skirmishAiCallback_getSelectedUnits;
+	callback->getUnitsSnapshot = &skirmishAiCallback_getUnitsSnapshot;
 	callback->Unit_getDef = &skirmishAiCallback_Unit_getDef;
 	callback->Unit_getRulesParamFloat = &skirmishAiCallback_Unit_getRulesParamFloat;
 	callback->Unit_getRulesParamString = &skirmishAiCallback_Unit_getRulesParamString;
@@ -5476,6 +5772,7 @@ static void skirmishAiCallback_init(SSkirmishAICallback* callback) {
 	callback->Map_getResourceMapSpotsPositions = &skirmishAiCallback_Map_getResourceMapSpotsPositions;
 	callback->Map_getResourceMapSpotsAverageIncome = &skirmishAiCallback_Map_getResourceMapSpotsAverageIncome;
 	callback->Map_getResourceMapSpotsNearest = &skirmishAiCallback_Map_getResourceMapSpotsNearest;
+	callback->Map_getResourceMapExtraction = &skirmishAiCallback_Map_getResourceMapExtraction;
 	callback->Map_getHash = &skirmishAiCallback_Map_getHash;
 	callback->Map_getName = &skirmishAiCallback_Map_getName;
 	callback->Map_getHumanName = &skirmishAiCallback_Map_getHumanName;
@@ -5526,6 +5823,7 @@ static void skirmishAiCallback_init(SSkirmishAICallback* callback) {
 	callback->FeatureDef_getCustomParams = &skirmishAiCallback_FeatureDef_getCustomParams;
 	callback->getFeatures = &skirmishAiCallback_getFeatures;
 	callback->getFeaturesIn = &skirmishAiCallback_getFeaturesIn;
+	callback->getFeaturesSnapshot = &skirmishAiCallback_getFeaturesSnapshot;
 	callback->Feature_getDef = &skirmishAiCallback_Feature_getDef;
 	callback->Feature_getHealth = &skirmishAiCallback_Feature_getHealth;
 	callback->Feature_getReclaimLeft = &skirmishAiCallback_Feature_getReclaimLeft;
@@ -5683,3 +5981,13 @@ void skirmishAiCallback_BlockOrders(const CSkirmishAIWrapper* ai)
 	GetCallBack(ai->GetSkirmishAIID())->AllowOrders(false);
 }
 
+void skirmishAiCallback_QueueOrders(const CSkirmishAIWrapper* ai, bool queue)
+{
+	GetCallBack(ai->GetSkirmishAIID())->QueueOrders(queue);
+}
+
+bool skirmishAiCallback_HasUsedCheats(const CSkirmishAIWrapper* ai)
+{
+	return AI_CHEAT_FLAGS[ai->GetSkirmishAIID()].second;
+}
+
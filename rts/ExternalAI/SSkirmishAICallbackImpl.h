@@ -127,6 +127,16 @@ EXPORT(float            ) skirmishAiCallback_Game_getTeamResourceReceived(int sk
 
 EXPORT(float            ) skirmishAiCallback_Game_getTeamResourceExcess(int skirmishAIId, int otherTeamId, int resourceId);
 
+EXPORT(float            ) skirmishAiCallback_Game_getTeamResourceUnitsMake(int skirmishAIId, int otherTeamId, int resourceId);
+
+EXPORT(float            ) skirmishAiCallback_Game_getTeamResourceUnitsUse(int skirmishAIId, int otherTeamId, int resourceId);
+
+EXPORT(int              ) skirmishAiCallback_Game_getTeamUnitCount(int skirmishAIId, int otherTeamId, int unitCountType);
+
+EXPORT(float            ) skirmishAiCallback_Game_getTeamBuildPower(int skirmishAIId, int otherTeamId);
+
+EXPORT(float            ) skirmishAiCallback_Game_getTeamBuildPowerUsed(int skirmishAIId, int otherTeamId);
+
 EXPORT(bool             ) skirmishAiCallback_Game_isAllied(int skirmishAIId, int firstAllyTeamId, int secondAllyTeamId);
 
 EXPORT(bool             ) skirmishAiCallback_Game_isDebugModeEnabled(int skirmishAIId);
@@ -660,6 +670,8 @@ EXPORT(int              ) skirmishAiCallback_getTeamUnits(int skirmishAIId, int*
 
 EXPORT(int              ) skirmishAiCallback_getSelectedUnits(int skirmishAIId, int* unitIds, int unitIds_sizeMax);
 
+EXPORT(int              ) skirmishAiCallback_getUnitsSnapshot(int skirmishAIId, int* unitIds, int* unitDefIds, int* teamIds, float* positions_AposF3, float* velocities_AposF3, float* healths, int* losStates, int units_sizeMax);
+
 EXPORT(int              ) skirmishAiCallback_Unit_getDef(int skirmishAIId, int unitId);
 
 EXPORT(float            ) skirmishAiCallback_Unit_getRulesParamFloat(int skirmishAIId, int unitId, const char* rulesParamName, float defaultValue);
@@ -916,6 +928,8 @@ EXPORT(int              ) skirmishAiCallback_Map_getResourceMapSpotsPositions(in
 
 EXPORT(float            ) skirmishAiCallback_Map_initResourceMapSpotsNearest(int skirmishAIId, int resourceId, float* pos_posF3, float* return_posF3_out);
 
+EXPORT(int              ) skirmishAiCallback_Map_getResourceMapExtraction(int skirmishAIId, int resourceId, float* extractions, int extractions_sizeMax);
+
 EXPORT(int              ) skirmishAiCallback_Map_getHash(int skirmishAIId);
 
 EXPORT(const char*      ) skirmishAiCallback_Map_getName(int skirmishAIId);
@@ -1027,6 +1041,8 @@ EXPORT(int              ) skirmishAiCallback_getFeatures(int skirmishAIId, int*
 
 EXPORT(int              ) skirmishAiCallback_getFeaturesIn(int skirmishAIId, float* pos_posF3, float radius, bool spherical, int* featureIds, int featureIds_sizeMax);
 
+EXPORT(int              ) skirmishAiCallback_getFeaturesSnapshot(int skirmishAIId, int* featureIds, int* featureDefIds, float* positions_AposF3, float* healths, float* reclaimLefts, float* resources, int features_sizeMax);
+
 EXPORT(int              ) skirmishAiCallback_Feature_getDef(int skirmishAIId, int featureId);
 
 EXPORT(float            ) skirmishAiCallback_Feature_getHealth(int skirmishAIId, int featureId);
@@ -1335,6 +1351,18 @@ void skirmishAiCallback_Release(const CSkirmishAIWrapper* ai);
 
 void skirmishAiCallback_BlockOrders(const CSkirmishAIWrapper* ai);
 
+/**
+ * Hold back (true) the network packets for orders and shares given by a
+ * specific AI, or send them (false) including all that were held back.
+ * @see CEngineOutHandler::Update
+ */
+void skirmishAiCallback_QueueOrders(const CSkirmishAIWrapper* ai, bool queue);
+
+/**
+ * Returns whether a specific AI has enabled cheats at any point.
+ */
+bool skirmishAiCallback_HasUsedCheats(const CSkirmishAIWrapper* ai);
+
 #endif // defined __cplusplus && !defined BUILDING_AI
 
 
@@ -418,6 +418,29 @@ void CSkirmishAIWrapper::Update(int frame) {
 	HandleEvent(EVENT_UPDATE, &evtData);
 }
 
+void CSkirmishAIWrapper::UpdateMT(int frame) {
+	const SUpdateEvent evtData = {frame};
+
+	// ScopedTimer keeps non-atomic refcounts, use the thread-safe variant
+	ScopedMtTimer timer(GetTimerNameHash());
+
+	if (blockEvents)
+		return;
+
+	library->HandleEvent(skirmishAIId, EVENT_UPDATE, &evtData);
+}
+
+bool CSkirmishAIWrapper::CanUpdateMT() const {
+	// cheats act on the simulation directly, and the Java and Python
+	// interpreters expect to be called from the thread that created them;
+	// enabling cheats or calling LuaRules is refused while updating in
+	// parallel, so this only has to be checked before the frame starts
+	if (skirmishAiCallback_HasUsedCheats(this))
+		return false;
+
+	return (key.GetInterface().GetShortName() == "C");
+}
+
 void CSkirmishAIWrapper::SendChatMessage(const char* msg, int fromPlayerId) {
 	const SMessageEvent evtData = {fromPlayerId, msg};
 	HandleEvent(EVENT_MESSAGE, &evtData);
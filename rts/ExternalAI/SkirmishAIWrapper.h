@@ -80,6 +80,8 @@ public:
 	void EnemyDestroyed(int enemyUnitId, int attackerUnitId);
 	void EnemyDamaged(int enemyUnitId, int attackerUnitId, float damage, const float3& dir, int weaponDefId, bool paralyzer);
 	void Update(int frame);
+	/// same as Update, but safe to call for different AI's from worker-threads
+	void UpdateMT(int frame);
 	void SendChatMessage(const char* msg, int fromPlayerId);
 	void SendLuaMessage(const char* inData, const char** outData);
 	void WeaponFired(int unitId, int weaponDefId);
@@ -103,6 +105,7 @@ public:
 	void SetCheatEvents(bool enable) { cheatEvents = enable; }
 
 	bool CheatEventsEnabled() const { return cheatEvents; }
+	bool CanUpdateMT() const;
 
 	bool Active() const { return (skirmishAIId != -1); }
 
@@ -0,0 +1,168 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+#include "Benchmark.h"
+#include "GameSetup.h"
+#include "GameVersion.h"
+#include "GlobalUnsynced.h"
+#include "System/TimeProfiler.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/Log/ILog.h"
+#include "System/Platform/Misc.h"
+
+CONFIG(int, BenchmarkFrames).defaultValue(0).minimumValue(0).description("Number of sim-frames to measure before writing BenchmarkOutput and quitting; 0 disables benchmarking.");
+CONFIG(int, BenchmarkStartFrame).defaultValue(0).minimumValue(0).description("First sim-frame to measure when BenchmarkFrames is non-zero; earlier frames serve as warm-up.");
+CONFIG(std::string, BenchmarkOutput).defaultValue("benchmark.json").description("File (relative to the write-dir) the benchmark results are written to as JSON.");
+
+
+CBenchmark benchmark;
+
+
+static float GetPercentile(const std::vector<float>& sortedTimes, float p)
+{
+	if (sortedTimes.empty())
+		return 0.0f;
+
+	// nearest-rank
+	const size_t rank = std::ceil(p * sortedTimes.size());
+	return sortedTimes[std::max(rank, size_t(1)) - 1];
+}
+
+
+void CBenchmark::Init()
+{
+	numFrames = configHandler->GetInt("BenchmarkFrames");
+	startFrame = configHandler->GetInt("BenchmarkStartFrame");
+	outputFile = configHandler->GetString("BenchmarkOutput");
+
+	frameTimes.clear();
+
+	if (!IsEnabled())
+		return;
+
+	frameTimes.reserve(numFrames);
+
+	LOG("[Benchmark::%s] measuring sim-frames [%d, %d) into \"%s\"", __func__, startFrame, startFrame + numFrames, outputFile.c_str());
+}
+
+void CBenchmark::Kill()
+{
+	numFrames = 0;
+	frameTimes.clear();
+}
+
+
+void CBenchmark::SimFrame(int frameNum, spring_time simFrameTime)
+{
+	if (!IsEnabled())
+		return;
+	if (frameNum < startFrame)
+		return;
+
+	if (frameNum == startFrame)
+		Start();
+
+	frameTimes.push_back(simFrameTime.toMilliSecsf());
+
+	// per-thread timings are only consumed (and pruned) by ProfileDrawer
+	// which does not run headless, keep them from piling up meanwhile
+	profiler.ToggleLock(true);
+
+	for (auto& threadProfile: profiler.GetThreadProfiles()) {
+		threadProfile.clear();
+	}
+
+	profiler.ToggleLock(false);
+
+	if (frameTimes.size() < size_t(numFrames))
+		return;
+
+	Finish();
+}
+
+
+void CBenchmark::Start()
+{
+	// discard everything accumulated during loading and warm-up; timers are
+	// no-ops while the profiler is disabled (it normally is when headless)
+	profiler.ResetState();
+	profiler.SetEnabled(true);
+
+	startTime = spring_gettime();
+}
+
+void CBenchmark::Finish()
+{
+	const float wallTime = (spring_gettime() - startTime).toMilliSecsf();
+	const float meanTime = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0f) / frameTimes.size();
+
+	const auto& modOptions = CGameSetup::GetModOptions();
+	const auto scenarioIt = modOptions.find("benchmark_scenario");
+
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	const std::string& filePath = dataDirsAccess.LocateFile(outputFile, FileQueryFlags::WRITE);
+	FILE* file = fopen(filePath.c_str(), "w");
+
+	if (file == nullptr) {
+		LOG_L(L_ERROR, "[Benchmark::%s] could not open \"%s\" for writing", __func__, filePath.c_str());
+	} else {
+		fprintf(file, "{\n");
+		fprintf(file, "\t\"engine\": \"%s\",\n", SpringVersion::GetFull().c_str());
+		fprintf(file, "\t\"map\": \"%s\",\n", gameSetup->mapName.c_str());
+		fprintf(file, "\t\"game\": \"%s\",\n", gameSetup->modName.c_str());
+		fprintf(file, "\t\"scenario\": \"%s\",\n", (scenarioIt != modOptions.end())? scenarioIt->second.c_str(): "");
+		fprintf(file, "\t\"startFrame\": %d,\n", startFrame);
+		fprintf(file, "\t\"numFrames\": %d,\n", numFrames);
+		fprintf(file, "\t\"wallTimeMs\": %.3f,\n", wallTime);
+		fprintf(file, "\t\"simFramesPerSecond\": %.3f,\n", (numFrames * 1000.0f) / std::max(wallTime, 0.001f));
+		fprintf(file, "\t\"peakRSSBytes\": %llu,\n", static_cast<unsigned long long>(Platform::GetPeakResidentMemory()));
+		fprintf(file, "\t\"frameTimeMs\": {\n");
+		fprintf(file, "\t\t\"mean\": %.4f,\n", meanTime);
+		fprintf(file, "\t\t\"min\": %.4f,\n", frameTimes.front());
+		fprintf(file, "\t\t\"p50\": %.4f,\n", GetPercentile(frameTimes, 0.50f));
+		fprintf(file, "\t\t\"p90\": %.4f,\n", GetPercentile(frameTimes, 0.90f));
+		fprintf(file, "\t\t\"p99\": %.4f,\n", GetPercentile(frameTimes, 0.99f));
+		fprintf(file, "\t\t\"max\": %.4f\n", frameTimes.back());
+		fprintf(file, "\t},\n");
+		fprintf(file, "\t\"timers\": [\n");
+
+		{
+			profiler.ToggleLock(true);
+			profiler.ResortProfilesRaw();
+			profiler.RefreshProfilesRaw();
+
+			const auto& profiles = profiler.GetSortedProfiles();
+
+			for (size_t i = 0, n = profiles.size(); i < n; i++) {
+				const std::string& name = profiles[i].first;
+				const CTimeProfiler::TimeRecord& tr = profiles[i].second;
+
+				fprintf(file, "\t\t{\"name\": \"%s\", \"totalMs\": %.3f, \"msPerFrame\": %.4f, \"peakMs\": %.3f}%s\n",
+					name.c_str(),
+					tr.total.toMilliSecsf(),
+					tr.total.toMilliSecsf() / numFrames,
+					tr.stats.x,
+					(i + 1 < n)? ",": ""
+				);
+			}
+
+			profiler.ToggleLock(false);
+		}
+
+		fprintf(file, "\t]\n");
+		fprintf(file, "}\n");
+		fclose(file);
+
+		LOG("[Benchmark::%s] wrote results for %d frames to \"%s\"", __func__, numFrames, filePath.c_str());
+	}
+
+	numFrames = 0;
+	gu->globalQuit = true;
+}
@@ -0,0 +1,45 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+#include "System/Misc/SpringTime.h"
+
+/**
+ * Measures simulation performance over a fixed range of frames and writes
+ * the results as JSON, then quits. Meant to be run with spring-headless and
+ * one of the scenarios in tools/benchmark, see tools/benchmark/README.md.
+ *
+ * Enabled by BenchmarkFrames > 0; frames before BenchmarkStartFrame are not
+ * measured (warm-up, scenario setup).
+ */
+class CBenchmark {
+public:
+	void Init();
+	void Kill();
+	void SimFrame(int frameNum, spring_time simFrameTime);
+
+	bool IsEnabled() const { return (numFrames > 0); }
+
+private:
+	void Start();
+	void Finish();
+
+private:
+	std::string outputFile;
+
+	// wall-clock duration of each measured CGame::SimFrame, in ms
+	std::vector<float> frameTimes;
+
+	spring_time startTime;
+
+	int startFrame = 0;
+	int numFrames = 0;
+};
+
+extern CBenchmark benchmark;
+
+#endif // BENCHMARK_H
@@ -3,6 +3,7 @@
 #include "Rendering/GL/myGL.h"
 
 #include "Game.h"
+#include "Benchmark.h"
 #include "Camera.h"
 #include "CameraHandler.h"
 #include "ChatMessage.h"
@@ -53,7 +54,9 @@
 #include "Lua/LuaHandle.h"
 #include "Lua/LuaInputReceiver.h"
 #include "Lua/LuaMenu.h"
+#include "Lua/LuaMessageBuffers.h"
 #include "Lua/LuaRules.h"
+#include "Lua/LuaRulesParams.h"
 #include "Lua/LuaOpenGL.h"
 #include "Lua/LuaParser.h"
 #include "Lua/LuaSyncedRead.h"
@@ -75,6 +78,7 @@
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/InterceptHandler.h"
 #include "Sim/Misc/QuadField.h"
+#include "Sim/Misc/RenderSnapshot.h"
 #include "Sim/Misc/SideParser.h"
 #include "Sim/Misc/SmoothHeightMesh.h"
 #include "Sim/Misc/TeamHandler.h"
@@ -586,6 +590,7 @@ void CGame::PostLoadSimulation(LuaParser* defsParser)
 	unitHandler.Init();
 	featureHandler.Init();
 	projectileHandler.Init();
+	renderSnapshot.Init();
 	CLosHandler::InitStatic();
 
 	readMap->InitHeightMapDigestVectors(losHandler->los.size);
@@ -811,6 +816,8 @@ void CGame::LoadFinalize()
 	lastSimFrameTime = lastReadNetTime;
 	lastDrawFrameTime = lastReadNetTime;
 	updateDeltaSeconds = 0.0f;
+
+	benchmark.Init();
 }
 
 
@@ -846,6 +853,8 @@ void CGame::KillLua(bool dtor)
 	CLuaRules::FreeHandler();
 
 	CSplitLuaHandle::ClearGameParams();
+	LuaRulesParams::ClearKeys();
+	LuaMessageBuffers::Clear();
 	LEAVE_SYNCED_CODE();
 
 
@@ -861,6 +870,7 @@ void CGame::KillMisc()
 	LOG("[Game::%s][1]", __func__);
 	CEndGameBox::Destroy();
 	IVideoCapturing::FreeInstance();
+	benchmark.Kill();
 
 	LOG("[Game::%s][2]", __func__);
 	// delete this first since AI's might call back into sim-components in their dtors
@@ -919,6 +929,7 @@ void CGame::KillSimulation()
 	featureHandler.Kill(); // depends on unitHandler (via ~CFeature)
 	unitHandler.Kill();
 	projectileHandler.Kill();
+	renderSnapshot.Kill();
 
 	LOG("[Game::%s][3]", __func__);
 	IPathManager::FreeInstance(pathManager);
@@ -1566,11 +1577,16 @@ void CGame::SimFrame() {
 		playerHandler.GameFrame(gs->frameNum);
 	}
 
+	// publish what the drawers interpolate from; nothing reads it when skipping
+	if (!skipping)
+		renderSnapshot.Capture(gs->frameNum);
+
 	lastSimFrameTime = spring_gettime();
 	gu->avgSimFrameTime = mix(gu->avgSimFrameTime, (lastSimFrameTime - lastFrameTime).toMilliSecsf(), 0.05f);
 	gu->avgSimFrameTime = std::max(gu->avgSimFrameTime, 0.001f);
 
 	eventHandler.DbgTimingInfo(TIMING_SIM, lastFrameTime, lastSimFrameTime);
+	benchmark.SimFrame(gs->frameNum, lastSimFrameTime - lastFrameTime);
 
 	#ifdef HEADLESS
 	{
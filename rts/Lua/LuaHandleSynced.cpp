@@ -16,6 +16,7 @@
 #include "LuaConstGame.h"
 #include "LuaConstPlatform.h"
 #include "LuaInterCall.h"
+#include "LuaMessageBuffers.h"
 #include "LuaSyncedCtrl.h"
 #include "LuaSyncedRead.h"
 #include "LuaSyncedTable.h"
@@ -1493,7 +1494,7 @@ int CSyncedLuaHandle::SendToUnsynced(lua_State* L)
 
 	for (int i = 1; i <= args; i++) {
 		const int t = (1 << lua_type(L, i));
-		if (!(t & supportedTypes)) {
+		if (!(t & supportedTypes) && !LuaMessageBuffers::IsMessageBuffer(L, i)) {
 			luaL_error(L, "Incorrect data type for SendToUnsynced(), arg %d", i);
 		}
 	}
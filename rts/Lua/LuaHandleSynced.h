@@ -267,7 +267,7 @@ class CSplitLuaHandle
 		CUnsyncedLuaHandle unsyncedLuaHandle;
 
 	public:
-		static void ClearGameParams() { spring::clear_unordered_map(gameParams); }
+		static void ClearGameParams() { gameParams.clear(); }
 		static const LuaRulesParams::Params& GetGameParams() { return gameParams; }
 
 	private:
@@ -0,0 +1,524 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+
+#include "LuaMessageBuffers.h"
+
+#include "LuaInclude.h"
+
+#include "LuaHandle.h"
+#include "LuaHashString.h"
+#include "LuaUtils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+
+CR_BIND(LuaMessageBuffers::BufferData, )
+CR_REG_METADATA_SUB(LuaMessageBuffers, BufferData, (
+	CR_MEMBER(bytes),
+	CR_MEMBER(elemType),
+	CR_MEMBER(elemSize),
+	CR_MEMBER(generation),
+	CR_MEMBER(numElems),
+	CR_MEMBER(numPushed),
+	CR_MEMBER(inUse),
+	CR_MEMBER(synced)
+))
+
+
+static constexpr const char* METATABLE_NAME = "MessageBuffer";
+
+// indexed by ElemType
+static constexpr const char* ELEM_TYPE_NAMES[] = {"int8", "uint8", "int16", "uint16", "int32", "uint32", "float32"};
+static constexpr size_t ELEM_TYPE_SIZES[] = {1, 1, 2, 2, 4, 4, 4};
+
+// upper bound on the number of elements per buffer (64MB of floats)
+static constexpr size_t MAX_BUFFER_ELEMS = (1 << 24);
+
+// handle layout: [31] read-only flag, [30] menu flag, [29:18] slot generation, [17:0] slot
+static constexpr unsigned int HANDLE_SLOT_BITS = 18;
+static constexpr unsigned int HANDLE_SLOT_MASK = (1u << HANDLE_SLOT_BITS) - 1;
+static constexpr unsigned int HANDLE_GEN_MASK = (1u << 12) - 1;
+static constexpr unsigned int HANDLE_MENU = (1u << 30);
+static constexpr unsigned int HANDLE_READ_ONLY = (1u << 31);
+
+// [0] buffers created by game states, [1] by LuaMenu which outlives games;
+// the latter are kept apart so neither a reload nor loading a save touches
+// them
+static std::vector<LuaMessageBuffers::BufferData> buffers[2];
+static std::vector<unsigned int> freeSlots[2];
+
+static const LuaMessageBuffers::BufferData emptyBuffer;
+
+
+static unsigned int MakeHandle(unsigned int slot, const LuaMessageBuffers::BufferData& data, bool menu, bool readOnly)
+{
+	return (slot | ((data.generation & HANDLE_GEN_MASK) << HANDLE_SLOT_BITS) | (HANDLE_MENU * menu) | (HANDLE_READ_ONLY * readOnly));
+}
+
+static void ReleaseSlot(unsigned int table, unsigned int slot)
+{
+	LuaMessageBuffers::BufferData& data = buffers[table][slot];
+
+	data.bytes = {};
+	data.numElems = 0;
+	data.numPushed = 0;
+	data.generation += 1;
+	data.inUse = false;
+
+	// retire the slot once its handle generation would wrap around, a stale
+	// handle could otherwise become valid again for an unrelated buffer
+	if ((data.generation & HANDLE_GEN_MASK) == 0)
+		return;
+
+	freeSlots[table].push_back(slot);
+}
+
+
+template<typename T> static float ReadElem(const std::uint8_t* ptr)
+{
+	T val;
+	std::memcpy(&val, ptr, sizeof(T));
+	return (static_cast<float>(val));
+}
+
+template<typename T> static void WriteElem(std::uint8_t* ptr, float val)
+{
+	// converting a float that is out of range for T (or NaN) is undefined, so
+	// integer types saturate and store NaN as 0; the clamp is done in double
+	// which represents the limits of all 32-bit types exactly
+	const double minVal = std::numeric_limits<T>::min();
+	const double maxVal = std::numeric_limits<T>::max();
+	const T t = (val == val)? static_cast<T>(std::max(minVal, std::min(double(val), maxVal))): T(0);
+	std::memcpy(ptr, &t, sizeof(T));
+}
+
+template<> void WriteElem<float>(std::uint8_t* ptr, float val)
+{
+	std::memcpy(ptr, &val, sizeof(float));
+}
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+float LuaMessageBuffers::BufferData::GetElem(size_t idx) const
+{
+	const std::uint8_t* ptr = &bytes[idx * elemSize];
+
+	switch (elemType) {
+		case ELEM_TYPE_INT8   : { return (ReadElem<std:: int8_t >(ptr)); } break;
+		case ELEM_TYPE_UINT8  : { return (ReadElem<std::uint8_t >(ptr)); } break;
+		case ELEM_TYPE_INT16  : { return (ReadElem<std:: int16_t>(ptr)); } break;
+		case ELEM_TYPE_UINT16 : { return (ReadElem<std::uint16_t>(ptr)); } break;
+		case ELEM_TYPE_INT32  : { return (ReadElem<std:: int32_t>(ptr)); } break;
+		case ELEM_TYPE_UINT32 : { return (ReadElem<std::uint32_t>(ptr)); } break;
+		case ELEM_TYPE_FLOAT32: { return (ReadElem<float        >(ptr)); } break;
+		default               : {                                        } break;
+	}
+
+	return 0.0f;
+}
+
+void LuaMessageBuffers::BufferData::SetElem(size_t idx, float val)
+{
+	std::uint8_t* ptr = &bytes[idx * elemSize];
+
+	switch (elemType) {
+		case ELEM_TYPE_INT8   : { WriteElem<std:: int8_t >(ptr, val); } break;
+		case ELEM_TYPE_UINT8  : { WriteElem<std::uint8_t >(ptr, val); } break;
+		case ELEM_TYPE_INT16  : { WriteElem<std:: int16_t>(ptr, val); } break;
+		case ELEM_TYPE_UINT16 : { WriteElem<std::uint16_t>(ptr, val); } break;
+		case ELEM_TYPE_INT32  : { WriteElem<std:: int32_t>(ptr, val); } break;
+		case ELEM_TYPE_UINT32 : { WriteElem<std::uint32_t>(ptr, val); } break;
+		case ELEM_TYPE_FLOAT32: { WriteElem<float        >(ptr, val); } break;
+		default               : {                                     } break;
+	}
+}
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+bool LuaMessageBuffers::PushEntries(lua_State* L)
+{
+	CreateMetatable(L);
+
+	REGISTER_LUA_CFUNC(CreateMessageBuffer);
+	return true;
+}
+
+
+bool LuaMessageBuffers::CreateMetatable(lua_State* L)
+{
+	// already exists, e.g. when a view is pushed into a state for the first time
+	if (!luaL_newmetatable(L, METATABLE_NAME)) {
+		lua_pop(L, 1);
+		return true;
+	}
+
+	HSTR_PUSH_CFUNC(L, "__gc",  meta_gc);
+	HSTR_PUSH_CFUNC(L, "__len", meta_len);
+
+	HSTR_PUSH(L, "__index");
+	lua_newtable(L);
+	HSTR_PUSH_CFUNC(L, "GetType",      GetType);
+	HSTR_PUSH_CFUNC(L, "GetSize",      GetSize);
+	HSTR_PUSH_CFUNC(L, "IsReadOnly",   IsReadOnly);
+	HSTR_PUSH_CFUNC(L, "IsValid",      IsValid);
+	HSTR_PUSH_CFUNC(L, "Resize",       Resize);
+	HSTR_PUSH_CFUNC(L, "Get",          Get);
+	HSTR_PUSH_CFUNC(L, "Set",          Set);
+	HSTR_PUSH_CFUNC(L, "GetTable",     GetTable);
+	HSTR_PUSH_CFUNC(L, "SetTable",     SetTable);
+	HSTR_PUSH_CFUNC(L, "Push",         Push);
+	HSTR_PUSH_CFUNC(L, "GetNumPushed", GetNumPushed);
+	lua_rawset(L, -3);
+
+	lua_pop(L, 1);
+	return true;
+}
+
+
+void LuaMessageBuffers::Clear()
+{
+	for (unsigned int slot = 0; slot < buffers[0].size(); slot++) {
+		if (!buffers[0][slot].inUse)
+			continue;
+
+		ReleaseSlot(0, slot);
+	}
+}
+
+
+#ifdef USING_CREG
+void LuaMessageBuffers::SerializeBuffers(creg::ISerializer* s)
+{
+	std::unique_ptr<creg::IType> buffersType = creg::DeduceType<decltype(buffers)>::Get();
+	std::unique_ptr<creg::IType> freeSlotsType = creg::DeduceType<decltype(freeSlots)>::Get();
+
+	buffersType->Serialize(s, &buffers[0]);
+	freeSlotsType->Serialize(s, &freeSlots[0]);
+
+	if (s->IsWriting())
+		return;
+
+	// unsynced states are not saved, neither are the buffers they owned
+	for (unsigned int slot = 0; slot < buffers[0].size(); slot++) {
+		if (!buffers[0][slot].inUse || buffers[0][slot].synced)
+			continue;
+
+		ReleaseSlot(0, slot);
+	}
+}
+#endif
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+void LuaMessageBuffers::PushHandle(lua_State* L, int handle)
+{
+	*static_cast<int*>(lua_newuserdata(L, sizeof(int))) = handle;
+
+	luaL_getmetatable(L, METATABLE_NAME);
+	lua_setmetatable(L, -2);
+}
+
+
+bool LuaMessageBuffers::IsMessageBuffer(lua_State* L, int index)
+{
+	if (lua_type(L, index) != LUA_TUSERDATA)
+		return false;
+	if (!lua_getmetatable(L, index))
+		return false;
+
+	luaL_getmetatable(L, METATABLE_NAME);
+
+	const bool ret = lua_rawequal(L, -1, -2);
+
+	lua_pop(L, 2);
+	return ret;
+}
+
+
+bool LuaMessageBuffers::PushSharedView(lua_State* dst, lua_State* src, int index)
+{
+	if (!IsMessageBuffer(src, index))
+		return false;
+
+	const unsigned int handle = *static_cast<const int*>(lua_touserdata(src, index));
+
+	CreateMetatable(dst);
+	PushHandle(dst, handle | HANDLE_READ_ONLY);
+	return true;
+}
+
+
+LuaMessageBuffers::BufferData* LuaMessageBuffers::GetBufferData(int handle)
+{
+	const unsigned int table = (unsigned(handle) & HANDLE_MENU) != 0;
+	const unsigned int slot = handle & HANDLE_SLOT_MASK;
+	const unsigned int generation = (unsigned(handle) >> HANDLE_SLOT_BITS) & HANDLE_GEN_MASK;
+
+	if (slot >= buffers[table].size())
+		return nullptr;
+
+	BufferData& data = buffers[table][slot];
+
+	if (!data.inUse || unsigned(data.generation & HANDLE_GEN_MASK) != generation)
+		return nullptr;
+
+	return &data;
+}
+
+LuaMessageBuffers::BufferData* LuaMessageBuffers::CheckBufferData(lua_State* L, int index)
+{
+	const int handle = *static_cast<int*>(luaL_checkudata(L, index, METATABLE_NAME));
+
+	BufferData* data = GetBufferData(handle);
+
+	// views can outlive the buffer; treat those as empty
+	if (data == nullptr)
+		return const_cast<BufferData*>(&emptyBuffer);
+
+	return data;
+}
+
+LuaMessageBuffers::BufferData* LuaMessageBuffers::CheckWritableBufferData(lua_State* L, int index)
+{
+	const int handle = *static_cast<int*>(luaL_checkudata(L, index, METATABLE_NAME));
+
+	if ((unsigned(handle) & HANDLE_READ_ONLY) != 0)
+		luaL_error(L, "[MessageBuffer] buffer is read-only in this Lua state");
+
+	BufferData* data = GetBufferData(handle);
+
+	if (data == nullptr)
+		luaL_error(L, "[MessageBuffer] buffer was released");
+
+	return data;
+}
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+int LuaMessageBuffers::meta_gc(lua_State* L)
+{
+	const int handle = *static_cast<int*>(luaL_checkudata(L, 1, METATABLE_NAME));
+
+	// only the owning userdata releases the storage, views are weak
+	if ((unsigned(handle) & HANDLE_READ_ONLY) != 0)
+		return 0;
+	if (GetBufferData(handle) == nullptr)
+		return 0;
+
+	ReleaseSlot((unsigned(handle) & HANDLE_MENU) != 0, handle & HANDLE_SLOT_MASK);
+	return 0;
+}
+
+int LuaMessageBuffers::meta_len(lua_State* L)
+{
+	lua_pushnumber(L, CheckBufferData(L, 1)->numElems);
+	return 1;
+}
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+int LuaMessageBuffers::GetType(lua_State* L)
+{
+	lua_pushstring(L, ELEM_TYPE_NAMES[CheckBufferData(L, 1)->elemType]);
+	return 1;
+}
+
+int LuaMessageBuffers::GetSize(lua_State* L)
+{
+	lua_pushnumber(L, CheckBufferData(L, 1)->numElems);
+	return 1;
+}
+
+int LuaMessageBuffers::IsReadOnly(lua_State* L)
+{
+	lua_pushboolean(L, (unsigned(*static_cast<int*>(luaL_checkudata(L, 1, METATABLE_NAME))) & HANDLE_READ_ONLY) != 0);
+	return 1;
+}
+
+int LuaMessageBuffers::IsValid(lua_State* L)
+{
+	lua_pushboolean(L, GetBufferData(*static_cast<int*>(luaL_checkudata(L, 1, METATABLE_NAME))) != nullptr);
+	return 1;
+}
+
+int LuaMessageBuffers::Resize(lua_State* L)
+{
+	BufferData* data = CheckWritableBufferData(L, 1);
+	const size_t numElems = luaL_checkint(L, 2);
+
+	if (numElems > MAX_BUFFER_ELEMS)
+		luaL_error(L, "[MessageBuffer::%s] size %d exceeds maximum %d", __func__, int(numElems), int(MAX_BUFFER_ELEMS));
+
+	data->Resize(numElems);
+	data->numPushed = 0;
+	return 0;
+}
+
+
+// buf:Get(index[, count]) -> value1, ..., valueN
+int LuaMessageBuffers::Get(lua_State* L)
+{
+	const BufferData* data = CheckBufferData(L, 1);
+
+	const int startIdx = luaL_checkint(L, 2) - 1;
+	const int numElems = luaL_optint(L, 3, 1);
+
+	if (startIdx < 0 || numElems < 0 || (size_t(startIdx) + numElems) > data->numElems)
+		luaL_error(L, "[MessageBuffer::%s] range [%d, %d) out of bounds", __func__, startIdx + 1, startIdx + 1 + numElems);
+
+	luaL_checkstack(L, numElems, __func__);
+
+	for (int i = 0; i < numElems; i++) {
+		lua_pushnumber(L, data->GetElem(startIdx + i));
+	}
+
+	return numElems;
+}
+
+// buf:Set(index, value1, ..., valueN)
+int LuaMessageBuffers::Set(lua_State* L)
+{
+	BufferData* data = CheckWritableBufferData(L, 1);
+
+	const int startIdx = luaL_checkint(L, 2) - 1;
+	const int numElems = lua_gettop(L) - 2;
+
+	if (startIdx < 0 || (size_t(startIdx) + numElems) > data->numElems)
+		luaL_error(L, "[MessageBuffer::%s] range [%d, %d) out of bounds", __func__, startIdx + 1, startIdx + 1 + numElems);
+
+	for (int i = 0; i < numElems; i++) {
+		data->SetElem(startIdx + i, luaL_checkfloat(L, 3 + i));
+	}
+
+	return 0;
+}
+
+
+// buf:GetTable([index[, count]]) -> {value1, ..., valueN}
+int LuaMessageBuffers::GetTable(lua_State* L)
+{
+	const BufferData* data = CheckBufferData(L, 1);
+
+	const int startIdx = luaL_optint(L, 2, 1) - 1;
+	const int numElems = luaL_optint(L, 3, int(data->numElems) - startIdx);
+
+	if (startIdx < 0 || numElems < 0 || (size_t(startIdx) + numElems) > data->numElems)
+		luaL_error(L, "[MessageBuffer::%s] range [%d, %d) out of bounds", __func__, startIdx + 1, startIdx + 1 + numElems);
+
+	lua_createtable(L, numElems, 0);
+
+	for (int i = 0; i < numElems; i++) {
+		lua_pushnumber(L, data->GetElem(startIdx + i));
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
+// buf:SetTable(index, {value1, ..., valueN})
+int LuaMessageBuffers::SetTable(lua_State* L)
+{
+	BufferData* data = CheckWritableBufferData(L, 1);
+
+	const int startIdx = luaL_checkint(L, 2) - 1;
+
+	luaL_checktype(L, 3, LUA_TTABLE);
+
+	const int numElems = lua_objlen(L, 3);
+
+	if (startIdx < 0 || (size_t(startIdx) + numElems) > data->numElems)
+		luaL_error(L, "[MessageBuffer::%s] range [%d, %d) out of bounds", __func__, startIdx + 1, startIdx + 1 + numElems);
+
+	for (int i = 0; i < numElems; i++) {
+		lua_rawgeti(L, 3, i + 1);
+		data->SetElem(startIdx + i, lua_tofloat(L, -1));
+		lua_pop(L, 1);
+	}
+
+	return 0;
+}
+
+
+// buf:Push(value1, ..., valueN) -> numPushed
+// treats the buffer as ring; readers use GetNumPushed to see how far the
+// writer got and (numPushed - 1) % size + 1 as index of the newest value
+int LuaMessageBuffers::Push(lua_State* L)
+{
+	BufferData* data = CheckWritableBufferData(L, 1);
+
+	if (data->numElems == 0)
+		luaL_error(L, "[MessageBuffer::%s] buffer is empty", __func__);
+
+	for (int i = 2, n = lua_gettop(L); i <= n; i++) {
+		data->SetElem((data->numPushed++) % data->numElems, luaL_checkfloat(L, i));
+	}
+
+	lua_pushnumber(L, data->numPushed);
+	return 1;
+}
+
+int LuaMessageBuffers::GetNumPushed(lua_State* L)
+{
+	lua_pushnumber(L, CheckBufferData(L, 1)->numPushed);
+	return 1;
+}
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+// Script.CreateMessageBuffer(type, size) -> buffer
+int LuaMessageBuffers::CreateMessageBuffer(lua_State* L)
+{
+	const char* typeName = luaL_checkstring(L, 1);
+	const size_t numElems = luaL_checkint(L, 2);
+
+	if (numElems > MAX_BUFFER_ELEMS)
+		luaL_error(L, "[%s] size %d exceeds maximum %d", __func__, int(numElems), int(MAX_BUFFER_ELEMS));
+
+	int elemType = ELEM_TYPE_INT8;
+
+	while (elemType < ELEM_TYPE_COUNT && std::strcmp(typeName, ELEM_TYPE_NAMES[elemType]) != 0)
+		elemType++;
+
+	if (elemType == ELEM_TYPE_COUNT)
+		luaL_error(L, "[%s] unknown element type \"%s\"", __func__, typeName);
+
+	const CLuaHandle* owner = CLuaHandle::GetHandle(L);
+	const bool menu = (owner != nullptr && owner->GetOrder() == LUA_HANDLE_ORDER_MENU);
+
+	if (freeSlots[menu].empty()) {
+		if (buffers[menu].size() > HANDLE_SLOT_MASK)
+			luaL_error(L, "[%s] too many buffers", __func__);
+
+		freeSlots[menu].push_back(buffers[menu].size());
+		buffers[menu].emplace_back();
+	}
+
+	const unsigned int slot = freeSlots[menu].back();
+
+	BufferData& data = buffers[menu][slot];
+
+	freeSlots[menu].pop_back();
+
+	data.elemType = elemType;
+	data.elemSize = ELEM_TYPE_SIZES[elemType];
+	data.inUse = true;
+	data.synced = CLuaHandle::GetHandleSynced(L);
+	data.Resize(numElems);
+
+	PushHandle(L, MakeHandle(slot, data, menu, false));
+	return 1;
+}
@@ -0,0 +1,112 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LUA_MESSAGE_BUFFERS_H
+#define LUA_MESSAGE_BUFFERS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "System/creg/creg_cond.h"
+
+struct lua_State;
+
+
+/**
+ * Flat arrays of packed numbers that can be handed between Lua states
+ * (SendToUnsynced, Script.LuaXYZ calls) without being copied: only the
+ * userdata referencing the shared storage is recreated in the receiving
+ * state. Buffers are writable only in the state that created them, every
+ * other state gets a read-only view, so synced code can keep writing into
+ * a buffer it handed to its unsynced half once (e.g. as a ring-buffer via
+ * Push) without unsynced code ever being able to modify synced data.
+ *
+ * The userdata is a plain integer handle (the only kind the Lua-state
+ * serializer supports); the storage itself is owned by the creating
+ * userdata and released when that is collected, views of a released
+ * buffer read as empty.
+ */
+class LuaMessageBuffers {
+	public:
+		static bool PushEntries(lua_State* L);
+
+		/// pushes a read-only view of the buffer at src[index] onto dst,
+		/// returns false (and pushes nothing) if the value is no buffer
+		static bool PushSharedView(lua_State* dst, lua_State* src, int index);
+		static bool IsMessageBuffer(lua_State* L, int index);
+
+		/// releases all buffers except those created by LuaMenu,
+		/// outstanding handles to them become stale
+		static void Clear();
+
+		#ifdef USING_CREG
+		static void SerializeBuffers(creg::ISerializer* s);
+		#endif
+
+	public:
+		enum ElemType {
+			ELEM_TYPE_INT8    = 0,
+			ELEM_TYPE_UINT8   = 1,
+			ELEM_TYPE_INT16   = 2,
+			ELEM_TYPE_UINT16  = 3,
+			ELEM_TYPE_INT32   = 4,
+			ELEM_TYPE_UINT32  = 5,
+			ELEM_TYPE_FLOAT32 = 6,
+			ELEM_TYPE_COUNT   = 7,
+		};
+
+		struct BufferData {
+			CR_DECLARE_STRUCT(BufferData)
+
+			float GetElem(size_t idx) const;
+			void SetElem(size_t idx, float val);
+			void Resize(size_t n) { bytes.resize(n * elemSize, 0); numElems = n; }
+
+			std::vector<std::uint8_t> bytes;
+
+			int elemType = ELEM_TYPE_FLOAT32;
+			int elemSize = sizeof(float);
+			/// bumped whenever the slot is released, invalidates old handles;
+			/// the slot is retired when this wraps within the handle bits
+			int generation = 0;
+
+			unsigned int numElems = 0;
+			/// total number of elements appended via Push
+			unsigned int numPushed = 0;
+
+			bool inUse = false;
+			/// created by a synced state; the others do not survive a reload
+			bool synced = false;
+		};
+
+	private:
+		static bool CreateMetatable(lua_State* L);
+		static void PushHandle(lua_State* L, int handle);
+
+		static BufferData* GetBufferData(int handle);
+		static BufferData* CheckBufferData(lua_State* L, int index);
+		static BufferData* CheckWritableBufferData(lua_State* L, int index);
+
+	private: // metatable methods
+		static int meta_gc(lua_State* L);
+		static int meta_len(lua_State* L);
+
+	private: // buffer methods
+		static int GetType(lua_State* L);
+		static int GetSize(lua_State* L);
+		static int IsReadOnly(lua_State* L);
+		static int IsValid(lua_State* L);
+		static int Resize(lua_State* L);
+
+		static int Get(lua_State* L);
+		static int Set(lua_State* L);
+		static int GetTable(lua_State* L);
+		static int SetTable(lua_State* L);
+
+		static int Push(lua_State* L);
+		static int GetNumPushed(lua_State* L);
+
+	private:
+		static int CreateMessageBuffer(lua_State* L);
+};
+
+#endif /* LUA_MESSAGE_BUFFERS_H */
@@ -1,12 +1,141 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
+
 #include "LuaRulesParams.h"
+#include "System/UnorderedMap.hpp"
 
 using namespace LuaRulesParams;
 
 CR_BIND(Param,)
 CR_REG_METADATA(Param, (
+	CR_MEMBER(key),
 	CR_MEMBER(los),
 	CR_MEMBER(valueInt),
 	CR_MEMBER(valueString)
 ))
+
+CR_BIND(Params,)
+CR_REG_METADATA(Params, (
+	CR_MEMBER(params),
+	CR_MEMBER(versions)
+))
+
+
+static spring::unordered_map<std::string, int> keyIndices;
+static std::vector<std::string> keyNames;
+
+
+int LuaRulesParams::GetKeyIndex(const std::string& name)
+{
+	const auto it = keyIndices.find(name);
+
+	if (it != keyIndices.end())
+		return it->second;
+
+	keyIndices[name] = keyNames.size();
+	keyNames.push_back(name);
+	return (keyNames.size() - 1);
+}
+
+int LuaRulesParams::FindKeyIndex(const std::string& name)
+{
+	const auto it = keyIndices.find(name);
+
+	if (it == keyIndices.end())
+		return -1;
+
+	return it->second;
+}
+
+const std::string& LuaRulesParams::GetKeyName(int key)
+{
+	return keyNames[key];
+}
+
+void LuaRulesParams::ClearKeys()
+{
+	spring::clear_unordered_map(keyIndices);
+	keyNames.clear();
+}
+
+
+#ifdef USING_CREG
+void LuaRulesParams::SerializeKeys(creg::ISerializer* s)
+{
+	std::unique_ptr<creg::IType> namesType = creg::DeduceType<decltype(keyNames)>::Get();
+	namesType->Serialize(s, &keyNames);
+
+	if (s->IsWriting())
+		return;
+
+	spring::clear_unordered_map(keyIndices);
+
+	for (size_t i = 0; i < keyNames.size(); i++) {
+		keyIndices[keyNames[i]] = i;
+	}
+}
+#endif
+
+
+const Param* Params::Find(int key) const
+{
+	if (key < 0)
+		return nullptr;
+
+	const auto pred = [](const Param& p, int k) { return (p.key < k); };
+	const auto iter = std::lower_bound(params.begin(), params.end(), key, pred);
+
+	if (iter == params.end() || iter->key != key)
+		return nullptr;
+
+	return &(*iter);
+}
+
+Param& Params::Insert(int key)
+{
+	const auto pred = [](const Param& p, int k) { return (p.key < k); };
+	const auto iter = std::lower_bound(params.begin(), params.end(), key, pred);
+
+	if (iter != params.end() && iter->key == key)
+		return *iter;
+
+	Param param;
+	param.key = key;
+
+	return *(params.insert(iter, param));
+}
+
+bool Params::Erase(int key)
+{
+	const auto pred = [](const Param& p, int k) { return (p.key < k); };
+	const auto iter = std::lower_bound(params.begin(), params.end(), key, pred);
+
+	if (iter == params.end() || iter->key != key)
+		return false;
+
+	MarkChanged(iter->los);
+	params.erase(iter);
+	return true;
+}
+
+
+void Params::MarkChanged(int losMask)
+{
+	for (int i = 0; i < NUM_RULESPARAMLOS_TYPES; i++) {
+		versions[i] += ((losMask >> i) & 1);
+	}
+}
+
+unsigned int Params::GetVersion(int readMask) const
+{
+	unsigned int version = 0;
+
+	// a change visible to readMask bumps at least one of the bits it shares
+	for (int i = 0; i < NUM_RULESPARAMLOS_TYPES; i++) {
+		version += (versions[i] * ((readMask >> i) & 1));
+	}
+
+	// Lua numbers are floats, wrap before they stop being integer-exact
+	return (version & VERSION_MASK);
+}
@@ -4,8 +4,8 @@
 #define LUA_RULESPARAMS_H
 
 #include <string>
+#include <vector>
 
-#include "System/UnorderedMap.hpp"
 #include "System/creg/creg_cond.h"
 
 namespace LuaRulesParams
@@ -27,15 +27,72 @@ namespace LuaRulesParams
 		RULESPARAMLOS_PUBLIC_MASK  = RULESPARAMLOS_PUBLIC
 	};
 
+	static constexpr int NUM_RULESPARAMLOS_TYPES = 6;
+
 	struct Param {
 		CR_DECLARE_STRUCT(Param)
 
+		int   key = -1; //! index into the interned names, see GetKeyIndex
 		int   los = RULESPARAMLOS_PRIVATE;
 		float valueInt = 0.0f;
 		std::string valueString;
 	};
 
-	typedef spring::unordered_map<std::string, Param> Params;
+
+	/**
+	 * Parameter names are interned once (by synced code setting them) and
+	 * objects store their parameters by the resulting index. Readers look
+	 * a name up once per call instead of hashing into every object's map,
+	 * and names that were never set need no lookup in any object at all.
+	 */
+	int GetKeyIndex(const std::string& name); //! interns name if not known yet
+	int FindKeyIndex(const std::string& name); //! returns -1 if name is not known
+	const std::string& GetKeyName(int key);
+	void ClearKeys();
+
+	#ifdef USING_CREG
+	void SerializeKeys(creg::ISerializer* s);
+	#endif
+
+
+	/**
+	 * Dense per-object parameter storage, ordered by key index. Changes are
+	 * counted per LOS-type so readers can tell whether anything visible to
+	 * them changed without learning about changes they may not see.
+	 */
+	class Params {
+		CR_DECLARE_STRUCT(Params)
+
+	public:
+		const Param* Find(int key) const;
+		const Param* Find(const std::string& name) const { return (Find(FindKeyIndex(name))); }
+
+		/// returns the existing parameter or a new default-initialized one
+		Param& Insert(int key);
+		bool Erase(int key);
+
+		/// must be called after changing a parameter, with its old and new los
+		void MarkChanged(int losMask);
+
+		/// number of changes to parameters readable with readMask so far,
+		/// modulo 2^24 such that it can be passed through Lua exactly
+		unsigned int GetVersion(int readMask) const;
+
+		static constexpr unsigned int VERSION_MASK = (1u << 24) - 1;
+
+		void clear() { *this = {}; }
+
+		size_t size() const { return params.size(); }
+		bool empty() const { return params.empty(); }
+
+		std::vector<Param>::const_iterator begin() const { return params.cbegin(); }
+		std::vector<Param>::const_iterator end() const { return params.cend(); }
+
+	private:
+		std::vector<Param> params;
+
+		unsigned int versions[NUM_RULESPARAMLOS_TYPES] = {0};
+	};
 }
 
 #endif // LUA_RULESPARAMS_H
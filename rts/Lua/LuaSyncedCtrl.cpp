@@ -45,6 +45,7 @@
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/Wind.h"
 #include "Sim/MoveTypes/AAirMoveType.h"
+#include "Sim/MoveTypes/MoveMath/MoveMath.h"
 #include "Sim/Path/IPathManager.h"
 #include "Sim/Projectiles/ExplosionGenerator.h"
 #include "Sim/Projectiles/Projectile.h"
@@ -1025,9 +1026,16 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 	const int valIndex = offset + 2;
 	const int losIndex = offset + 3; // table
 
-	const std::string& key = luaL_checkstring(L, index);
+	const int key = LuaRulesParams::GetKeyIndex(luaL_checkstring(L, index));
 
-	LuaRulesParams::Param& param = params[key];
+	if (lua_isnoneornil(L, valIndex)) {
+		params.Erase(key);
+		return; //no need to set los if param was erased
+	}
+
+	LuaRulesParams::Param& param = params.Insert(key);
+
+	const int oldLos = param.los;
 
 	// set the value of the parameter
 	if (lua_israwnumber(L, valIndex)) {
@@ -1035,9 +1043,6 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 		param.valueString.resize(0);
 	} else if (lua_isstring(L, valIndex)) {
 		param.valueString = lua_tostring(L, valIndex);
-	} else if (lua_isnoneornil(L, valIndex)) {
-		params.erase(key);
-		return; //no need to set los if param was erased
 	} else {
 		luaL_error(L, "Incorrect arguments to %s()", caller);
 	}
@@ -1070,6 +1075,9 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 	} else {
 		param.los = luaL_optint(L, losIndex, param.los);
 	}
+
+	// readers of the old and of the new los both see a change
+	params.MarkChanged(oldLos | param.los);
 }
 
 
@@ -2092,10 +2100,15 @@ int LuaSyncedCtrl::SetUnitBuildSpeed(lua_State* L)
 	const float buildScale = (1.0f / TEAM_SLOWUPDATE_RATE);
 	const float buildSpeed = buildScale * max(0.0f, luaL_checkfloat(L, 2));
 
+	// the team's build-power totals include the old speed
+	TeamAggregates& teamAggregates = teamHandler.Team(unit->team)->unitAggregates;
+
 	CFactory* factory = dynamic_cast<CFactory*>(unit);
 
 	if (factory != nullptr) {
+		teamAggregates.UpdateUnitBuildState(factory, -1);
 		factory->buildSpeed = buildSpeed;
+		teamAggregates.UpdateUnitBuildState(factory, +1);
 		return 0;
 	}
 
@@ -2104,7 +2117,10 @@ int LuaSyncedCtrl::SetUnitBuildSpeed(lua_State* L)
 	if (builder == nullptr)
 		return 0;
 
+	teamAggregates.UpdateUnitBuildState(builder, -1);
 	builder->buildSpeed = buildSpeed;
+	teamAggregates.UpdateUnitBuildState(builder, +1);
+
 	if (lua_isnumber(L, 3)) {
 		builder->repairSpeed    = buildScale * max(0.0f, lua_tofloat(L, 3));
 	}
@@ -3027,8 +3043,21 @@ int LuaSyncedCtrl::SetFeatureResources(lua_State* L)
 	if (feature == nullptr)
 		return 0;
 
-	feature->defResources.metal  = std::max(0.0f, luaL_optfloat(L, 6, feature->defResources.metal));
-	feature->defResources.energy = std::max(0.0f, luaL_optfloat(L, 7, feature->defResources.energy));
+	const float newMetal  = std::max(0.0f, luaL_optfloat(L, 6, feature->defResources.metal ));
+	const float newEnergy = std::max(0.0f, luaL_optfloat(L, 7, feature->defResources.energy));
+	// the quad's reclaim-counts depend on which resources a feature has
+	const bool updateQuads = (newMetal != feature->defResources.metal || newEnergy != feature->defResources.energy);
+
+	if (updateQuads) {
+		quadField.RemoveFeature(feature);
+	}
+
+	feature->defResources.metal  = newMetal;
+	feature->defResources.energy = newEnergy;
+
+	if (updateQuads) {
+		quadField.AddFeature(feature);
+	}
 
 	feature->resources.metal  = Clamp(luaL_checknumber(L, 2), 0.0f, feature->defResources.metal );
 	feature->resources.energy = Clamp(luaL_checknumber(L, 3), 0.0f, feature->defResources.energy);
@@ -3054,8 +3083,19 @@ int LuaSyncedCtrl::SetFeatureResurrect(lua_State* L)
 		else if (lua_israwstring(L, 2))
 			ud = unitDefHandler->GetUnitDefByName(lua_tostring(L, 2));
 
+		// the quad's reclaim-list and -counts depend on the resurrect target
+		const bool updateQuads = (ud != feature->udef);
+
+		if (updateQuads) {
+			quadField.RemoveFeature(feature);
+		}
+
 		// nullptr is also accepted, allows unsetting the target via id=-1
 		feature->udef = ud;
+
+		if (updateQuads) {
+			quadField.AddFeature(feature);
+		}
 	}
 
 	if (!lua_isnoneornil(L, 3))
@@ -4179,6 +4219,7 @@ int LuaSyncedCtrl::SetMapSquareTerrainType(lua_State* L)
 	const int ntt = luaL_checkint(L, 3);
 
 	readMap->GetTypeMapSynced()[tz * mapDims.hmapx + tx] = std::max(0, std::min(ntt, (CMapInfo::NUM_TERRAIN_TYPES - 1)));
+	CMoveMath::UpdateSpeedModGrids(hx, hz,  hx, hz);
 	pathManager->TerrainChange(hx, hz,  hx + 1, hz + 1,  TERRAINCHANGE_SQUARE_TYPEMAP_INDEX);
 
 	lua_pushnumber(L, ott);
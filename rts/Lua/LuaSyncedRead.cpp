@@ -149,6 +149,7 @@ bool LuaSyncedRead::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetTeamInfo);
 	REGISTER_LUA_CFUNC(GetTeamResources);
 	REGISTER_LUA_CFUNC(GetTeamUnitStats);
+	REGISTER_LUA_CFUNC(GetTeamUnitAggregates);
 	REGISTER_LUA_CFUNC(GetTeamResourceStats);
 	REGISTER_LUA_CFUNC(GetTeamRulesParam);
 	REGISTER_LUA_CFUNC(GetTeamRulesParams);
@@ -753,18 +754,28 @@ static inline const CTeam* ParseTeam(lua_State* L, const char* caller, int index
 
 /******************************************************************************/
 
+// returns (table, version) or, if the optional argument at versionIndex
+// equals the version of everything readable with losStatus, (nil, version)
 static int PushRulesParams(lua_State* L, const char* caller,
                           const LuaRulesParams::Params& params,
-                          const int losStatus)
+                          const int losStatus, const int versionIndex)
 {
+	const unsigned int version = params.GetVersion(losStatus);
+
+	if (lua_israwnumber(L, versionIndex) && lua_tonumber(L, versionIndex) == version) {
+		lua_pushnil(L);
+		lua_pushnumber(L, version);
+		return 2;
+	}
+
 	lua_createtable(L, 0, params.size());
 
-	for (auto& it: params) {
-		const std::string& name = it.first;
-		const LuaRulesParams::Param& param = it.second;
+	for (const LuaRulesParams::Param& param: params) {
 		if (!(param.los & losStatus))
 			continue;
 
+		const std::string& name = LuaRulesParams::GetKeyName(param.key);
+
 		if (!param.valueString.empty()) {
 			LuaPushNamedString(L, name, param.valueString);
 		} else {
@@ -772,7 +783,8 @@ static int PushRulesParams(lua_State* L, const char* caller,
 		}
 	}
 
-	return 1;
+	lua_pushnumber(L, version);
+	return 2;
 }
 
 
@@ -780,18 +792,16 @@ static int GetRulesParam(lua_State* L, const char* caller, int index,
                           const LuaRulesParams::Params& params,
                           const int& losStatus)
 {
-	const std::string& key = luaL_checkstring(L, index);
-	const auto it = params.find(key);
-	if (it == params.end())
-		return 0;
+	const LuaRulesParams::Param* param = params.Find(luaL_checkstring(L, index));
 
-	const LuaRulesParams::Param& param = it->second;
+	if (param == nullptr)
+		return 0;
 
-	if (param.los & losStatus) {
-		if (!param.valueString.empty()) {
-			lua_pushsstring(L, param.valueString);
+	if (param->los & losStatus) {
+		if (!param->valueString.empty()) {
+			lua_pushsstring(L, param->valueString);
 		} else {
-			lua_pushnumber(L, param.valueInt);
+			lua_pushnumber(L, param->valueInt);
 		}
 		return 1;
 	}
@@ -928,7 +938,7 @@ int LuaSyncedRead::GetWind(lua_State* L)
 int LuaSyncedRead::GetGameRulesParams(lua_State* L)
 {
 	// always readable for all
-	return PushRulesParams(L, __func__, CSplitLuaHandle::GetGameParams(), LuaRulesParams::RULESPARAMLOS_PRIVATE_MASK);
+	return PushRulesParams(L, __func__, CSplitLuaHandle::GetGameParams(), LuaRulesParams::RULESPARAMLOS_PRIVATE_MASK, 1);
 }
 
 
@@ -1258,7 +1268,9 @@ int LuaSyncedRead::GetTeamResources(lua_State* L)
 			lua_pushnumber(L, team->resPrevSent.metal);
 			lua_pushnumber(L, team->resPrevReceived.metal);
 			lua_pushnumber(L, team->resPrevExcess.metal);
-			return 9;
+			lua_pushnumber(L, team->unitAggregates.unitResMake.metal);
+			lua_pushnumber(L, team->unitAggregates.unitResUse.metal);
+			return 11;
 		} break;
 		case 'e': {
 			lua_pushnumber(L, team->res.energy);
@@ -1270,7 +1282,9 @@ int LuaSyncedRead::GetTeamResources(lua_State* L)
 			lua_pushnumber(L, team->resPrevSent.energy);
 			lua_pushnumber(L, team->resPrevReceived.energy);
 			lua_pushnumber(L, team->resPrevExcess.energy);
-			return 9;
+			lua_pushnumber(L, team->unitAggregates.unitResMake.energy);
+			lua_pushnumber(L, team->unitAggregates.unitResUse.energy);
+			return 11;
 		} break;
 		default: {
 		} break;
@@ -1304,6 +1318,28 @@ int LuaSyncedRead::GetTeamUnitStats(lua_State* L)
 }
 
 
+int LuaSyncedRead::GetTeamUnitAggregates(lua_State* L)
+{
+	const CTeam* team = ParseTeam(L, __func__, 1);
+
+	if (team == nullptr)
+		return 0;
+
+	if (!IsAlliedTeam(L, team->teamNum))
+		return 0;
+
+	const TeamAggregates& aggregates = team->unitAggregates;
+
+	for (int i = TeamAggregates::UNITS_TOTAL; i < TeamAggregates::UNITS_COUNT_TYPES; i++) {
+		lua_pushnumber(L, aggregates.unitCounts[i]);
+	}
+
+	lua_pushnumber(L, aggregates.buildPower);
+	lua_pushnumber(L, aggregates.buildPowerUsed);
+	return (TeamAggregates::UNITS_COUNT_TYPES + 2);
+}
+
+
 int LuaSyncedRead::GetTeamResourceStats(lua_State* L)
 {
 	const CTeam* team = ParseTeam(L, __func__, 1);
@@ -1357,7 +1393,7 @@ int LuaSyncedRead::GetTeamRulesParams(lua_State* L)
 		losMask |= LuaRulesParams::RULESPARAMLOS_ALLIED_MASK;
 	}
 
-	return PushRulesParams(L, __func__, team->modParams, losMask);
+	return PushRulesParams(L, __func__, team->modParams, losMask, 2);
 }
 
 
@@ -4544,7 +4580,7 @@ int LuaSyncedRead::GetUnitRulesParams(lua_State* L)
 	if (unit == nullptr || game == nullptr)
 		return 0;
 
-	return PushRulesParams(L, __func__, unit->modParams, GetUnitRulesParamLosMask(L, unit));
+	return PushRulesParams(L, __func__, unit->modParams, GetUnitRulesParamLosMask(L, unit), 2);
 }
 
 
@@ -4891,7 +4927,7 @@ int LuaSyncedRead::GetFeatureRulesParams(lua_State* L)
 
 	const LuaRulesParams::Params&  params = feature->modParams;
 
-	return PushRulesParams(L, __func__, params, losMask);
+	return PushRulesParams(L, __func__, params, losMask, 2);
 }
 
 
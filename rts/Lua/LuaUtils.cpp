@@ -20,6 +20,7 @@
 #include "System/StringUtil.h"
 
 #if !defined UNITSYNC && !defined DEDICATED && !defined BUILDING_AI
+	#include "LuaMessageBuffers.h"
 	#include "System/TimeProfiler.h"
 #else
 	#define SCOPED_TIMER(x)
@@ -83,6 +84,16 @@ static bool CopyPushData(lua_State* dst, lua_State* src, int index, int depth, s
 			CopyPushTable(dst, src, index, depth, alreadyCopied);
 		} break;
 
+		#if !defined UNITSYNC && !defined DEDICATED && !defined BUILDING_AI
+		case LUA_TUSERDATA: {
+			// message buffers are shared, the receiver gets a read-only view
+			if (!LuaMessageBuffers::PushSharedView(dst, src, index)) {
+				lua_pushnil(dst);
+				return false;
+			}
+		} break;
+		#endif
+
 		default: {
 			lua_pushnil(dst); // unhandled type
 			return false;
@@ -8,6 +8,7 @@
 #include "Sim/Misc/GroundBlockingObjectMap.h"
 #include "Sim/Misc/LosHandler.h"
 #include "Sim/Misc/QuadField.h"
+#include "Sim/MoveTypes/MoveMath/MoveMath.h"
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitHandler.h"
 #include "Sim/Path/IPathManager.h"
@@ -73,6 +74,7 @@ void CBasicMapDamage::TerrainTypeSpeedModChanged(int ttIndex)
 			if (typeMap[tz * mapDims.hmapx + tx] != ttIndex)
 				continue;
 
+			CMoveMath::UpdateSpeedModGrids((tx << 1), (tz << 1),  (tx << 1) + 1, (tz << 1) + 1);
 			pathManager->TerrainChange((tx << 1), (tz << 1),  (tx << 1) + 1, (tz << 1) + 1,  TERRAINCHANGE_TYPEMAP_SPEED_VALUES);
 		}
 	}
@@ -215,6 +217,8 @@ void CBasicMapDamage::Explosion(const float3& pos, float strength, float radius)
 void CBasicMapDamage::RecalcArea(int x1, int x2, int y1, int y2)
 {
 	readMap->UpdateHeightMapSynced(SRectangle(x1, y1, x2, y2));
+	// the slope-map update extends a few squares beyond the rectangle
+	CMoveMath::UpdateSpeedModGrids(x1 - 4, y1 - 4, x2 + 4, y2 + 4);
 	featureHandler.TerrainChanged(x1, y1, x2, y2);
 	{
 		SCOPED_TIMER("Sim::BasicMapDamage::Los");
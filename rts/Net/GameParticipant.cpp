@@ -18,6 +18,12 @@ void GameParticipant::SendData(std::shared_ptr<const netcode::RawPacket> packet)
 		clientLink->SendData(packet);
 }
 
+void GameParticipant::SendBatch(std::shared_ptr<const netcode::RawPacket> batch, const std::vector< std::shared_ptr<const netcode::RawPacket> >& packets)
+{
+	if (clientLink != nullptr)
+		clientLink->SendBatch(batch, packets);
+}
+
 void GameParticipant::Connected(std::shared_ptr<netcode::CConnection> _link, bool local)
 {
 	clientLink = _link;
@@ -4,6 +4,7 @@
 #define _GAME_PARTICIPANT_H
 
 #include <memory>
+#include <vector>
 
 #include "Game/Players/PlayerBase.h"
 #include "Game/Players/PlayerStatistics.h"
@@ -22,6 +23,7 @@ public:
 	GameParticipant();
 
 	void SendData(std::shared_ptr<const netcode::RawPacket> packet);
+	void SendBatch(std::shared_ptr<const netcode::RawPacket> batch, const std::vector< std::shared_ptr<const netcode::RawPacket> >& packets);
 	void Connected(std::shared_ptr<netcode::CConnection> link, bool local);
 	void Kill(const std::string& reason, const bool flush = false);
 
@@ -3,6 +3,7 @@
 #include "System/Net/UDPListener.h"
 #include "System/Net/UDPConnection.h"
 
+#include <algorithm>
 #include <functional>
 
 #if defined DEDICATED || defined DEBUG
@@ -49,6 +50,7 @@
 #include "System/FileSystem/SimpleParser.h"
 #include "System/Net/Connection.h"
 #include "System/Net/LocalConnection.h"
+#include "System/Net/ProtocolDef.h"
 #include "System/Net/UnpackPacket.h"
 #include "System/LoadSave/DemoRecorder.h"
 #include "System/LoadSave/DemoReader.h"
@@ -418,10 +420,12 @@ void CGameServer::SkipTo(int targetFrameNum)
 		if ((serverFrameNum % 20) != 0) { continue; }
 
 		// send data every few frames, as otherwise packets would grow too big
+		FlushBroadcasts();
 		udpListener->Update();
 	}
 
 	Broadcast(std::shared_ptr<const netcode::RawPacket>(endMsg.Pack()));
+	FlushBroadcasts();
 
 	if (udpListener != nullptr)
 		udpListener->Update();
@@ -543,9 +547,9 @@ bool CGameServer::SendDemoData(int targetFrameNum)
 
 void CGameServer::Broadcast(std::shared_ptr<const netcode::RawPacket> packet)
 {
-	for (GameParticipant& p: players) {
-		p.SendData(packet);
-	}
+	// fan-out is deferred until FlushBroadcasts so every message of a frame
+	// is serialized once and handed to all client links as a single batch
+	broadcastQueue.push_back(packet);
 
 	if (canReconnect || allowSpecJoin || !gameHasStarted)
 		packetCache.push_back(packet);
@@ -554,6 +558,53 @@ void CGameServer::Broadcast(std::shared_ptr<const netcode::RawPacket> packet)
 		demoRecorder->SaveToDemo(packet->data, packet->length, GetDemoTime());
 }
 
+void CGameServer::FlushBroadcasts()
+{
+	// links only validate the leading message of a batch, so check every
+	// message here; one bad length would misparse all that follow it
+	const auto IsInvalidPacket = [](const std::shared_ptr<const netcode::RawPacket>& packet) {
+		if (netcode::ProtocolDef::GetInstance()->IsValidPacket(packet->data, packet->length))
+			return false;
+
+		LOG_L(L_ERROR,
+			"[GameServer::FlushBroadcasts] discarding outgoing invalid packet: ID %d, LEN %d",
+			((packet->length > 0) ? (int)packet->data[0] : -1), packet->length
+		);
+		return true;
+	};
+
+	broadcastQueue.erase(std::remove_if(broadcastQueue.begin(), broadcastQueue.end(), IsInvalidPacket), broadcastQueue.end());
+
+	if (broadcastQueue.empty())
+		return;
+
+	std::shared_ptr<const netcode::RawPacket> batch = broadcastQueue.front();
+
+	if (broadcastQueue.size() > 1) {
+		uint32_t batchLength = 0;
+
+		for (const std::shared_ptr<const netcode::RawPacket>& packet: broadcastQueue) {
+			batchLength += packet->length;
+		}
+
+		netcode::RawPacket* batchPacket = new netcode::RawPacket(batchLength);
+
+		for (const std::shared_ptr<const netcode::RawPacket>& packet: broadcastQueue) {
+			memcpy(batchPacket->GetWritingPos(), packet->data, packet->length);
+			batchPacket->pos += packet->length;
+		}
+
+		batch.reset(batchPacket);
+	}
+
+	// chunking links queue the shared batch as-is, others get the individual messages
+	for (GameParticipant& p: players) {
+		p.SendBatch(batch, broadcastQueue);
+	}
+
+	broadcastQueue.clear();
+}
+
 void CGameServer::Message(const std::string& message, bool broadcast, bool internal)
 {
 	if (!internal) {
@@ -562,6 +613,7 @@ void CGameServer::Message(const std::string& message, bool broadcast, bool inter
 		}
 		else if (HasLocalClient()) {
 			// host should see
+			FlushBroadcasts();
 			players[localClientNumber].SendData(CBaseNetProtocol::Get().SendSystemMessage(SERVER_PLAYER, message));
 		}
 		if (hostif != nullptr)
@@ -574,6 +626,7 @@ void CGameServer::Message(const std::string& message, bool broadcast, bool inter
 }
 
 void CGameServer::PrivateMessage(int playerNum, const std::string& message) {
+	FlushBroadcasts();
 	players[playerNum].SendData(CBaseNetProtocol::Get().SendSystemMessage(SERVER_PLAYER, message));
 }
 
@@ -1076,6 +1129,7 @@ void CGameServer::ProcessPacket(const unsigned playerNum, std::shared_ptr<const
 		case NETMSG_QUIT: {
 			Message(spring::format(PlayerLeft, players[a].GetType(), players[a].name.c_str(), " normal quit"));
 			Broadcast(CBaseNetProtocol::Get().SendPlayerLeft(a, 1));
+			FlushBroadcasts();
 			players[a].Kill("[GameServer] user exited", true);
 			if (hostif != nullptr)
 				hostif->SendPlayerLeft(a, 1);
@@ -1859,8 +1913,15 @@ void CGameServer::HandleConnectionAttempts()
 			std::string platform;
 			uint8_t reconnect;
 			uint8_t netloss;
+			uint8_t compress = 0;
 			uint16_t netversion;
 			msg >> netversion;
+
+			// check before unpacking anything else, so clients with a different
+			// layout get a meaningful reject message rather than an unpack error
+			if (netversion != NETWORK_VERSION)
+				throw netcode::UnpackPacketException(spring::format("Wrong network version: received %d, required %d", (int)netversion, (int)NETWORK_VERSION));
+
 			msg >> name;
 			msg >> passwd;
 			msg >> version;
@@ -1868,10 +1929,11 @@ void CGameServer::HandleConnectionAttempts()
 			msg >> reconnect;
 			msg >> netloss;
 
-			if (netversion != NETWORK_VERSION)
-				throw netcode::UnpackPacketException(spring::format("Wrong network version: received %d, required %d", (int)netversion, (int)NETWORK_VERSION));
+			// not sent by clients predating stream compression
+			if (msg.GetRemainingBytes() > 0)
+				msg >> compress;
 
-			BindConnection(udpListener->AcceptConnection(), name, passwd, version, platform, false, reconnect, netloss);
+			BindConnection(udpListener->AcceptConnection(), name, passwd, version, platform, false, reconnect, netloss, compress);
 		} catch (const netcode::UnpackPacketException& ex) {
 			const asio::ip::udp::endpoint endp = prev->GetEndpoint();
 			const asio::ip::address addr = endp.address();
@@ -2635,7 +2697,10 @@ void CGameServer::CreateNewFrame(bool fromServerThread, bool fixedFrameTime)
 			// to let players know their loading %
 			if ((serverFrameNum % gameProgressFrameInterval) == 0) {
 				CBaseNetProtocol::PacketType progressPacket = CBaseNetProtocol::Get().SendCurrentFrameProgress(serverFrameNum);
-				// we cannot use broadcast here, since we want to skip caching
+				// we cannot use broadcast here, since we want to skip caching;
+				// flush first so the progress does not overtake queued frames
+				FlushBroadcasts();
+
 				for (GameParticipant& p: players) {
 					p.SendData(progressPacket);
 				}
@@ -2645,6 +2710,10 @@ void CGameServer::CreateNewFrame(bool fromServerThread, bool fixedFrameTime)
 		#endif
 		}
 	}
+
+	// hand the frame's messages to all links as one batch; also keeps the
+	// local client from waiting on the next server loop when called from it
+	FlushBroadcasts();
 }
 
 
@@ -2685,12 +2754,14 @@ void CGameServer::UpdateLoop()
 			std::lock_guard<spring::recursive_mutex> scoped_lock(gameServerMutex);
 			ServerReadNet();
 			Update();
+			FlushBroadcasts();
 		}
 
 		if (hostif != nullptr)
 			hostif->SendQuit();
 
 		Broadcast(CBaseNetProtocol::Get().SendQuit("Server shutdown"));
+		FlushBroadcasts();
 
 		// this is to make sure the Flush has any effect at all (we don't want a forced flush)
 		// when reloading, we can assume there is only a local client and skip the sleep()'s
@@ -2722,6 +2793,7 @@ void CGameServer::KickPlayer(int playerNum)
 	Message(spring::format(PlayerLeft, players[playerNum].GetType(), players[playerNum].name.c_str(), "kicked"));
 	Broadcast(CBaseNetProtocol::Get().SendPlayerLeft(playerNum, 2));
 
+	FlushBroadcasts();
 	players[playerNum].Kill("Kicked from the battle", true);
 
 	if (hostif != nullptr)
@@ -2836,7 +2908,8 @@ unsigned CGameServer::BindConnection(
 	const std::string& clientPlatform,
 	bool isLocal,
 	bool reconnect,
-	int netloss
+	int netloss,
+	bool compress
 ) {
 	Message(spring::format("%s attempt from %s", (reconnect ? "Reconnection" : "Connection"), clientName.c_str()));
 	Message(spring::format(" -> Version: %s [%s]", clientVersion.c_str(), clientPlatform.c_str()));
@@ -2970,7 +3043,9 @@ unsigned CGameServer::BindConnection(
 			udpListener->UpdateConnections();
 
 		Message(spring::format(" -> Connection reestablished (id %i)", newPlayerNumber));
+		FlushBroadcasts();
 		newPlayer.clientLink->SetLossFactor(netloss);
+		newPlayer.clientLink->SetCompression(compress && globalConfig.networkCompression);
 		newPlayer.clientLink->Flush(!gameHasStarted);
 		return newPlayerNumber;
 	}
@@ -2995,13 +3070,19 @@ unsigned CGameServer::BindConnection(
 		}
 	}
 
+	// pending broadcasts are part of packetCache, deliver them before the
+	// replay so the new player does not receive them a second time later
+	FlushBroadcasts();
+
 	// finally send player all packets he missed until now
 	for (const std::shared_ptr<const netcode::RawPacket>& p: packetCache)
 		newPlayer.SendData(p);
 
 	// new connection established
 	Message(spring::format(" -> Connection established (given id %i)", newPlayerNumber));
+	FlushBroadcasts();
 	clientLink->SetLossFactor(netloss);
+	clientLink->SetCompression(compress && globalConfig.networkCompression);
 	clientLink->Flush(!gameHasStarted);
 	return newPlayerNumber;
 }
@@ -152,7 +152,8 @@ private:
 		const std::string& clientPlatform,
 		bool isLocal,
 		bool reconnect = false,
-		int netloss = 0
+		int netloss = 0,
+		bool compress = false
 	);
 
 	void CheckForGameStart(bool forced = false);
@@ -174,6 +175,8 @@ private:
 	bool SendDemoData(int targetFrameNum);
 
 	void Broadcast(std::shared_ptr<const netcode::RawPacket> packet);
+	/// concatenate all pending broadcasts once and hand them to every client link
+	void FlushBroadcasts();
 
 	/**
 	 * @brief skip frames
@@ -222,6 +225,8 @@ private:
 	std::pair<std::string, std::string> refClientVersion;
 
 	std::deque< std::shared_ptr<const netcode::RawPacket> > packetCache;
+	/// broadcasts queued since the last FlushBroadcasts
+	std::vector< std::shared_ptr<const netcode::RawPacket> > broadcastQueue;
 
 	/////////////////// sync stuff ///////////////////
 #ifdef SYNCCHECK
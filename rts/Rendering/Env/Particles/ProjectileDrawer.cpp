@@ -23,6 +23,7 @@
 #include "Rendering/Textures/TextureAtlas.h"
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/LosHandler.h"
+#include "Sim/Misc/RenderSnapshot.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Projectiles/ExplosionGenerator.h"
 #include "Sim/Projectiles/ProjectileHandler.h"
@@ -558,9 +559,19 @@ void CProjectileDrawer::DrawProjectiles(int modelType, bool drawReflection, bool
 
 void CProjectileDrawer::DrawProjectilesSet(const std::vector<CProjectile*>& projectiles, bool drawReflection, bool drawRefraction)
 {
-	for (CProjectile* p: projectiles) {
-		DrawProjectileNow(p, drawReflection, drawRefraction);
+	if (!renderSnapshot.IsEnabled()) {
+		for (CProjectile* p: projectiles) {
+			DrawProjectileNow(p, nullptr, drawReflection, drawRefraction);
+		}
+
+		return;
 	}
+
+	renderSnapshot.Read([&](const CRenderSnapshot::Buffer& snapshot) {
+		for (CProjectile* p: projectiles) {
+			DrawProjectileNow(p, &snapshot, drawReflection, drawRefraction);
+		}
+	});
 }
 
 bool CProjectileDrawer::CanDrawProjectile(const CProjectile* pro, const CSolidObject* owner)
@@ -570,9 +581,11 @@ bool CProjectileDrawer::CanDrawProjectile(const CProjectile* pro, const CSolidOb
 	return (gu->spectatingFullView || (owner != nullptr && th.Ally(owner->allyteam, gu->myAllyTeam)) || lh->InLos(pro, gu->myAllyTeam));
 }
 
-void CProjectileDrawer::DrawProjectileNow(CProjectile* pro, bool drawReflection, bool drawRefraction)
+void CProjectileDrawer::DrawProjectileNow(CProjectile* pro, const CRenderSnapshot::Buffer* snapshot, bool drawReflection, bool drawRefraction)
 {
-	pro->drawPos = pro->GetDrawPos(globalRendering->timeOffset);
+	// unsynced projectiles are never in the snapshot
+	if (snapshot == nullptr || !CRenderSnapshot::GetProjectileDrawPos(*snapshot, pro, globalRendering->timeOffset, pro->drawPos))
+		pro->drawPos = pro->GetDrawPos(globalRendering->timeOffset);
 
 	if (!CanDrawProjectile(pro, pro->owner()))
 		return;
@@ -12,6 +12,7 @@
 #include "Rendering/Shaders/Shader.h"
 #include "Rendering/Models/3DModel.h"
 #include "Rendering/Models/ModelRenderContainer.h"
+#include "Sim/Misc/RenderSnapshot.h"
 #include "System/EventClient.h"
 #include "System/UnorderedSet.hpp"
 
@@ -137,7 +138,7 @@ private:
 	static void DrawProjectilesSetShadow(const std::vector<CProjectile*>& projectiles);
 
 	static bool CanDrawProjectile(const CProjectile* pro, const CSolidObject* owner);
-	void DrawProjectileNow(CProjectile* projectile, bool drawReflection, bool drawRefraction);
+	void DrawProjectileNow(CProjectile* projectile, const CRenderSnapshot::Buffer* snapshot, bool drawReflection, bool drawRefraction);
 
 	static void DrawProjectileShadow(CProjectile* projectile);
 	static bool DrawProjectileModel(const CProjectile* projectile);
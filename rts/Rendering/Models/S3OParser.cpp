@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include <cctype>
+#include <cstdio>
 #include <stdexcept>
 
 #include "S3OParser.h"
@@ -9,16 +10,70 @@
 #include "Rendering/GlobalRendering.h"
 #include "Rendering/Textures/S3OTextureHandler.h"
 #include "Sim/Misc/CollisionVolume.h"
+#include "System/CRC.h"
 #include "System/Exceptions.h"
 #include "System/SpringMath.h"
 #include "System/StringUtil.h"
+#include "System/MainDefines.h" // SNPRINTF
+#include "System/Config/ConfigHandler.h"
 #include "System/Log/ILog.h"
+#include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileHandler.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
 #include "System/Platform/byteorder.h"
 
+CONFIG(bool, S3OModelCache).defaultValue(true).description("Store preprocessed S3O model geometry in the cache directory, keyed by model-file checksum, so later games can skip parsing and tangent generation.");
+
+
+// bump when the layout below or the piece post-processing changes
+static constexpr uint32_t S3O_CACHE_VERSION = 1;
+static constexpr char S3O_CACHE_MAGIC[4] = {'S', '3', 'O', 'C'};
+
+struct S3OCacheHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t vertexSize;
+	uint32_t sourceSize;
+	uint32_t sourceCRC;
+	uint32_t numPieces;
+	uint32_t dataSize; // number of bytes following the header
+};
+
+struct S3OCacheModel {
+	float3 mins;
+	float3 maxs;
+	float3 relMidPos;
+	float radius;
+	float height;
+	uint32_t texNameSizes[2];
+};
+
+struct S3OCachePiece {
+	float3 offset;
+	float3 goffset;
+	float3 mins;
+	float3 maxs;
+	int32_t parentIndex;
+	int32_t primType;
+	uint32_t nameSize;
+	uint32_t numVertices;
+	uint32_t numIndices;
+};
+
+
+void CS3OParser::Init()
+{
+	numPoolPieces = 0;
+
+	if (!configHandler->GetBool("S3OModelCache")) {
+		cacheDir.clear();
+		return;
+	}
 
+	cacheDir = FileSystem::EnsurePathSepAtEnd(dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/models/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS));
+}
 
-void CS3OParser::Init() { numPoolPieces = 0; }
 void CS3OParser::Kill() {
 	LOG_L(L_INFO, "[S3OParser::%s] allocated %u pieces", __func__, numPoolPieces);
 
@@ -49,6 +104,9 @@ S3DModel CS3OParser::Load(const std::string& name)
 	if (fileBuf.size() < sizeof(S3OHeader))
 		throw content_error("[S3OParser] corrupted header for model-file " + name);
 
+	const uint32_t sourceSize = fileBuf.size();
+	const uint32_t sourceCRC = cacheDir.empty()? 0: CRC::CalcDigest(fileBuf.data(), fileBuf.size());
+
 	S3OHeader header;
 	memcpy(&header, fileBuf.data(), sizeof(header));
 	header.swap();
@@ -57,11 +115,17 @@ S3DModel CS3OParser::Load(const std::string& name)
 		model.name = name;
 		model.type = MODELTYPE_S3O;
 		model.numPieces = 0;
-		model.texs[0] = (header.texture1 == 0)? "" : (char*) &fileBuf[header.texture1];
-		model.texs[1] = (header.texture2 == 0)? "" : (char*) &fileBuf[header.texture2];
 		model.mins = DEF_MIN_SIZE;
 		model.maxs = DEF_MAX_SIZE;
 
+	if (LoadCachedModel(model, sourceSize, sourceCRC)) {
+		textureHandlerS3O.PreloadTexture(&model);
+		return model;
+	}
+
+	model.texs[0] = (header.texture1 == 0)? "" : (char*) &fileBuf[header.texture1];
+	model.texs[1] = (header.texture2 == 0)? "" : (char*) &fileBuf[header.texture2];
+
 	textureHandlerS3O.PreloadTexture(&model);
 
 	model.FlattenPieceTree(LoadPiece(&model, nullptr, fileBuf, header.rootPiece));
@@ -71,10 +135,264 @@ S3DModel CS3OParser::Load(const std::string& name)
 	model.height = (header.height <= 0.01f)? model.CalcDrawHeight(): header.height;
 	model.relMidPos = float3(header.midx, header.midy, header.midz);
 
+	SaveCachedModel(model, sourceSize, sourceCRC);
 	return model;
 }
 
 
+std::string CS3OParser::GetCacheFileName(uint32_t sourceSize, uint32_t sourceCRC) const
+{
+	char buf[64];
+	SNPRINTF(buf, sizeof(buf), "%08x-%u.s3oc", sourceCRC, sourceSize);
+	return (cacheDir + buf);
+}
+
+bool CS3OParser::LoadCachedModel(S3DModel& model, uint32_t sourceSize, uint32_t sourceCRC)
+{
+	if (cacheDir.empty())
+		return false;
+
+	std::vector<uint8_t> cacheBuf;
+
+	int numPieces = 0;
+
+	{
+		FILE* file = fopen(GetCacheFileName(sourceSize, sourceCRC).c_str(), "rb");
+
+		if (file == nullptr)
+			return false;
+
+		S3OCacheHeader header;
+
+		const bool haveHeader =
+			(fread(&header, sizeof(header), 1, file) == 1) &&
+			(memcmp(header.magic, S3O_CACHE_MAGIC, sizeof(header.magic)) == 0) &&
+			(header.version == S3O_CACHE_VERSION) &&
+			(header.vertexSize == sizeof(SVertexData)) &&
+			(header.sourceSize == sourceSize) &&
+			(header.sourceCRC == sourceCRC) &&
+			(header.numPieces != 0);
+
+		long fileSize = 0;
+
+		if (haveHeader && fseek(file, 0, SEEK_END) == 0 && (fileSize = ftell(file)) >= 0 && fseek(file, sizeof(header), SEEK_SET) == 0) {
+			// never trust the header with the allocation size
+			if (header.dataSize == (fileSize - sizeof(header))) {
+				cacheBuf.resize(header.dataSize);
+				cacheBuf.resize(fread(cacheBuf.data(), 1, cacheBuf.size(), file));
+			}
+		}
+
+		fclose(file);
+
+		// truncated or stale files are simply rebuilt
+		if (!haveHeader || cacheBuf.empty() || cacheBuf.size() != header.dataSize)
+			return false;
+
+		numPieces = header.numPieces;
+	}
+
+	size_t cacheOfs = 0;
+
+	// all sizes come from the file, compare them against the remaining bytes
+	// (instead of adding to cacheOfs) so corrupt values can not wrap around
+	const auto SkipData = [&](size_t size) {
+		if (size > (cacheBuf.size() - cacheOfs))
+			return false;
+
+		cacheOfs += size;
+		return true;
+	};
+	const auto ReadData = [&](void* dst, size_t size) {
+		if (size > (cacheBuf.size() - cacheOfs))
+			return false;
+
+		memcpy(dst, &cacheBuf[cacheOfs], size);
+		cacheOfs += size;
+		return true;
+	};
+	const auto ReadString = [&](std::string& str, size_t size) {
+		if (size > (cacheBuf.size() - cacheOfs))
+			return false;
+
+		str.assign(reinterpret_cast<const char*>(&cacheBuf[cacheOfs]), size);
+		cacheOfs += size;
+		return true;
+	};
+
+	S3OCacheModel cm;
+
+	if (!ReadData(&cm, sizeof(cm)))
+		return false;
+	if (!ReadString(model.texs[0], cm.texNameSizes[0]) || !ReadString(model.texs[1], cm.texNameSizes[1]))
+		return false;
+	if (size_t(numPieces) > ((cacheBuf.size() - cacheOfs) / sizeof(S3OCachePiece)))
+		return false;
+
+	struct CachedPiece {
+		S3OCachePiece cp;
+		size_t dataOfs;
+	};
+
+	std::vector<CachedPiece> cachedPieces;
+	std::vector<SS3OPiece*> pieces;
+	std::vector<SVertexData> vertices;
+	std::vector<uint32_t> indices;
+
+	cachedPieces.reserve(numPieces);
+	pieces.reserve(numPieces);
+
+	// validate every piece record before allocating pool pieces, which can
+	// not be handed back once taken; pieces are stored in the depth-first
+	// order LoadPiece visits them so every parent precedes its children
+	for (int i = 0; i < numPieces; i++) {
+		S3OCachePiece cp;
+
+		if (!ReadData(&cp, sizeof(cp)))
+			return false;
+		if (cp.parentIndex >= i || (cp.parentIndex < 0) != (i == 0))
+			return false;
+
+		cachedPieces.push_back({cp, cacheOfs});
+
+		if (!SkipData(cp.nameSize))
+			return false;
+		if (!SkipData(cp.numVertices * sizeof(SVertexData)))
+			return false;
+		if (!SkipData(cp.numIndices * sizeof(uint32_t)))
+			return false;
+	}
+
+	for (const CachedPiece& cachedPiece: cachedPieces) {
+		const S3OCachePiece& cp = cachedPiece.cp;
+
+		SS3OPiece* piece = AllocPiece();
+		SS3OPiece* parent = (cp.parentIndex >= 0)? pieces[cp.parentIndex]: nullptr;
+
+		cacheOfs = cachedPiece.dataOfs;
+
+		vertices.resize(cp.numVertices);
+		indices.resize(cp.numIndices);
+
+		ReadString(piece->name, cp.nameSize);
+		ReadData(vertices.data(), vertices.size() * sizeof(SVertexData));
+		ReadData(indices.data(), indices.size() * sizeof(uint32_t));
+
+		piece->offset = cp.offset;
+		piece->goffset = cp.goffset;
+		piece->mins = cp.mins;
+		piece->maxs = cp.maxs;
+		piece->primType = cp.primType;
+		piece->parent = parent;
+		piece->SetParentModel(&model);
+		piece->SetVertices(vertices.data(), vertices.size());
+		piece->SetIndices(indices.data(), indices.size());
+		piece->SetCollisionVolume(CollisionVolume('b', 'z', piece->maxs - piece->mins, (piece->maxs + piece->mins) * 0.5f));
+
+		if (parent != nullptr)
+			parent->children.push_back(piece);
+
+		pieces.push_back(piece);
+	}
+
+	model.numPieces = numPieces;
+	model.FlattenPieceTree(pieces[0]);
+
+	model.mins = cm.mins;
+	model.maxs = cm.maxs;
+	model.radius = cm.radius;
+	model.height = cm.height;
+	model.relMidPos = cm.relMidPos;
+	return true;
+}
+
+void CS3OParser::SaveCachedModel(const S3DModel& model, uint32_t sourceSize, uint32_t sourceCRC)
+{
+	if (cacheDir.empty())
+		return;
+
+	std::vector<uint8_t> cacheBuf(sizeof(S3OCacheHeader), 0);
+
+	const auto WriteData = [&](const void* src, size_t size) {
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(src);
+		cacheBuf.insert(cacheBuf.end(), bytes, bytes + size);
+	};
+
+	{
+		const S3OCacheModel cm = {
+			model.mins, model.maxs, model.relMidPos,
+			model.radius, model.height,
+			{uint32_t(model.texs[0].size()), uint32_t(model.texs[1].size())}
+		};
+
+		WriteData(&cm, sizeof(cm));
+		WriteData(model.texs[0].data(), model.texs[0].size());
+		WriteData(model.texs[1].data(), model.texs[1].size());
+	}
+
+	for (const S3DModelPiece* p: model.pieceObjects) {
+		const SS3OPiece* piece = static_cast<const SS3OPiece*>(p);
+
+		const auto& vertices = piece->GetVertices();
+		const auto& indices = piece->GetIndices();
+
+		int32_t parentIndex = -1;
+
+		if (piece->parent != nullptr)
+			parentIndex = std::find(model.pieceObjects.begin(), model.pieceObjects.end(), piece->parent) - model.pieceObjects.begin();
+
+		const S3OCachePiece cp = {
+			piece->offset, piece->goffset, piece->mins, piece->maxs,
+			parentIndex, piece->primType,
+			uint32_t(piece->name.size()), uint32_t(vertices.size()), uint32_t(indices.size())
+		};
+
+		WriteData(&cp, sizeof(cp));
+		WriteData(piece->name.data(), piece->name.size());
+		WriteData(vertices.data(), vertices.size() * sizeof(SVertexData));
+		WriteData(indices.data(), indices.size() * sizeof(uint32_t));
+	}
+
+	{
+		S3OCacheHeader header;
+
+		memcpy(header.magic, S3O_CACHE_MAGIC, sizeof(header.magic));
+		header.version = S3O_CACHE_VERSION;
+		header.vertexSize = sizeof(SVertexData);
+		header.sourceSize = sourceSize;
+		header.sourceCRC = sourceCRC;
+		header.numPieces = model.pieceObjects.size();
+		header.dataSize = cacheBuf.size() - sizeof(header);
+
+		memcpy(cacheBuf.data(), &header, sizeof(header));
+	}
+
+	// preload threads can parse different models concurrently; write to a
+	// temporary and rename so readers never observe a partial cache file
+	std::lock_guard<spring::mutex> lock(cacheMutex);
+
+	const std::string cacheFileName = GetCacheFileName(sourceSize, sourceCRC);
+	const std::string tempFileName = cacheFileName + ".tmp";
+
+	FILE* file = fopen(tempFileName.c_str(), "wb");
+
+	if (file == nullptr) {
+		LOG_L(L_WARNING, "[S3OParser::%s] could not create cache-file for model \"%s\"", __func__, model.name.c_str());
+		return;
+	}
+
+	const bool written = (fwrite(cacheBuf.data(), cacheBuf.size(), 1, file) == 1);
+
+	fclose(file);
+
+	// rename does not replace existing files on Windows
+	std::remove(cacheFileName.c_str());
+
+	if (!written || std::rename(tempFileName.c_str(), cacheFileName.c_str()) != 0)
+		std::remove(tempFileName.c_str());
+}
+
+
 SS3OPiece* CS3OParser::AllocPiece()
 {
 	std::lock_guard<spring::mutex> lock(poolMutex);
@@ -52,6 +52,11 @@ public:
 	void SetIndexCount(unsigned int n) { indices.resize(n); }
 	void SetVertex(int idx, const SVertexData& v) { vertices[idx] = v; }
 	void SetIndex(int idx, const unsigned int drawIdx) { indices[idx] = drawIdx; }
+	void SetVertices(const SVertexData* v, unsigned int n) { vertices.assign(v, v + n); }
+	void SetIndices(const uint32_t* i, unsigned int n) { indices.assign(i, i + n); }
+
+	const std::vector<SVertexData>& GetVertices() const { return vertices; }
+	const std::vector<uint32_t>& GetIndices() const { return indices; }
 
 	void Trianglize();
 	void SetMinMaxExtends();
@@ -75,9 +80,20 @@ private:
 	SS3OPiece* AllocPiece();
 	SS3OPiece* LoadPiece(S3DModel*, SS3OPiece*, std::vector<uint8_t>& buf, int offset);
 
+	// preprocessed (triangulated, tangent-space) geometry is cached per
+	// model-file checksum so unchanged content skips LoadPiece entirely
+	std::string GetCacheFileName(uint32_t sourceSize, uint32_t sourceCRC) const;
+
+	bool LoadCachedModel(S3DModel& model, uint32_t sourceSize, uint32_t sourceCRC);
+	void SaveCachedModel(const S3DModel& model, uint32_t sourceSize, uint32_t sourceCRC);
+
 private:
 	std::vector<SS3OPiece> piecePool;
 	spring::mutex poolMutex;
+	spring::mutex cacheMutex;
+
+	// empty if the cache is disabled
+	std::string cacheDir;
 
 	unsigned int numPoolPieces = 0;
 };
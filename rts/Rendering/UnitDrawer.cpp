@@ -416,7 +416,18 @@ void CUnitDrawer::Update()
 			UpdateUnitIconStateScreen(unit);
 		else
 			UpdateUnitIconState(unit);
-		UpdateUnitDrawPos(unit);
+	}
+
+	if (renderSnapshot.IsEnabled()) {
+		renderSnapshot.Read([&](const CRenderSnapshot::Buffer& snapshot) {
+			for (CUnit* unit: unsortedUnits) {
+				UpdateUnitDrawPos(unit, &snapshot);
+			}
+		});
+	} else {
+		for (CUnit* unit: unsortedUnits) {
+			UpdateUnitDrawPos(unit, nullptr);
+		}
 	}
 
 	if ((useDistToGroundForIcons = (camHandler->GetCurrentController()).GetUseDistToGroundForIcons())) {
@@ -1819,13 +1830,16 @@ inline void CUnitDrawer::UpdateUnitIconStateScreen(CUnit* unit)
 	unit->isIcon = iconZoomDist/iconSizeMult > iconFadeStart && std::abs(pos.x-radiusPos.x) < limit * 0.9;
 }
 
-inline void CUnitDrawer::UpdateUnitDrawPos(CUnit* u) {
+inline void CUnitDrawer::UpdateUnitDrawPos(CUnit* u, const CRenderSnapshot::Buffer* snapshot) {
 	const CUnit* t = u->GetTransporter();
 
-	if (t != nullptr) {
-		u->drawPos = u->preFramePos + t->GetDrawDeltaPos(globalRendering->timeOffset);
-	} else {
-		u->drawPos = u->preFramePos + u->GetDrawDeltaPos(globalRendering->timeOffset);
+	// units not (yet) in the snapshot are interpolated from their live state
+	if (snapshot == nullptr || !CRenderSnapshot::GetUnitDrawPos(*snapshot, u, globalRendering->timeOffset, u->drawPos)) {
+		if (t != nullptr) {
+			u->drawPos = u->preFramePos + t->GetDrawDeltaPos(globalRendering->timeOffset);
+		} else {
+			u->drawPos = u->preFramePos + u->GetDrawDeltaPos(globalRendering->timeOffset);
+		}
 	}
 
 	u->drawMidPos = u->GetMdlDrawMidPos();
@@ -11,6 +11,7 @@
 #include "Rendering/Models/ModelRenderContainer.h"
 #include "Rendering/UnitDrawerState.hpp"
 #include "Rendering/UnitDefImage.h"
+#include "Sim/Misc/RenderSnapshot.h"
 #include "System/EventClient.h"
 #include "System/type2.h"
 #include "System/UnorderedMap.hpp"
@@ -237,7 +238,7 @@ private:
 
 	static void DrawIcon(CUnit* unit, bool asRadarBlip);
 	static void DrawIconScreenArray(const CUnit* unit, const icon::CIconData* icon, bool asRadarBlip, const float dist, CVertexArray* va);
-	static void UpdateUnitDrawPos(CUnit* unit);
+	static void UpdateUnitDrawPos(CUnit* unit, const CRenderSnapshot::Buffer* snapshot);
 
 public:
 	static void BindModelTypeTexture(int mdlType, int texType);
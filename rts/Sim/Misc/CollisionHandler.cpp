@@ -12,12 +12,20 @@
 
 unsigned int CCollisionHandler::numDiscTests = 0;
 unsigned int CCollisionHandler::numContTests = 0;
+unsigned int CCollisionHandler::numBatchTests = 0;
+unsigned int CCollisionHandler::numBatchRejects = 0;
+
+// scratch space for IntersectPiecesHelper
+static std::vector<const LocalModelPiece*> batchPieces;
+static std::vector<const CollisionVolume*> batchVolumes;
+static std::vector<CMatrix44f> batchMatrices;
+static std::vector<CollisionQuery> batchQueries;
 
 
 
 void CCollisionHandler::PrintStats()
 {
-	LOG("[CCollisionHandler] dis-/continuous tests: %i/%i", numDiscTests, numContTests);
+	LOG("[CCollisionHandler] dis-/continuous tests: %i/%i (batched: %i, rejected by batch: %i)", numDiscTests, numContTests, numBatchTests, numBatchRejects);
 }
 
 
@@ -263,6 +271,10 @@ bool CCollisionHandler::IntersectPiecesHelper(
 	float minDistSq = std::numeric_limits<float>::max();
 	float curDistSq = minDistSq;
 
+	batchPieces.clear();
+	batchVolumes.clear();
+	batchMatrices.clear();
+
 	for (unsigned int n = 0; n < o->localModel.pieces.size(); n++) {
 		const LocalModelPiece* lmp = o->localModel.GetPiece(n);
 		const CollisionVolume* lmpVol = lmp->GetCollisionVolume();
@@ -270,12 +282,44 @@ bool CCollisionHandler::IntersectPiecesHelper(
 		if (!lmp->scriptSetVisible || lmpVol->IgnoreHits())
 			continue;
 
-		volMat = m * lmp->GetModelSpaceMatrix();
-		volMat.Translate(lmpVol->GetOffsets());
+		// caller only wants to know whether a collision exists, which the
+		// first hit piece already answers without testing all the others
+		if (cq == nullptr) {
+			CollisionQuery cqn;
+
+			volMat = m * lmp->GetModelSpaceMatrix();
+			volMat.Translate(lmpVol->GetOffsets());
+
+			if (CCollisionHandler::Intersect(lmpVol, volMat, p0, p1, &cqn) && cqn.AnyHit())
+				return true;
 
-		CollisionQuery cqn;
-		if (!CCollisionHandler::Intersect(lmpVol, volMat, p0, p1, &cqn))
 			continue;
+		}
+
+		batchPieces.push_back(lmp);
+		batchVolumes.push_back(lmpVol);
+		batchMatrices.push_back(lmp->GetModelSpaceMatrix());
+	}
+
+	if (cq == nullptr)
+		return false;
+
+	// m * pieceMat for all pieces at once, same result as operator*
+	CMatrix44f::Concat(m, batchMatrices.data(), batchMatrices.data(), batchMatrices.size());
+
+	for (size_t n = 0; n < batchPieces.size(); n++) {
+		batchMatrices[n].Translate(batchVolumes[n]->GetOffsets());
+	}
+
+	batchQueries.resize(batchPieces.size());
+
+	if (CCollisionHandler::IntersectBatch(batchVolumes.data(), batchMatrices.data(), batchPieces.size(), p0, p1, batchQueries.data()) == 0)
+		return false;
+
+	// pieces are visited in the same order as the batch tested them
+	for (size_t n = 0; n < batchPieces.size(); n++) {
+		const LocalModelPiece* lmp = batchPieces[n];
+		const CollisionQuery& cqn = batchQueries[n];
 
 		// skip if neither an ingress nor an egress hit
 		if (!cqn.AnyHit())
@@ -287,17 +331,13 @@ bool CCollisionHandler::IntersectPiecesHelper(
 
 		minDistSq = curDistSq;
 
-		// return early if caller only wants to know a collision exists
-		if (cq == nullptr)
-			return true;
-
 		*cq = cqn;
 		cq->SetHitPiece(lmp);
 	}
 
 	// true iff at least one piece was intersected
 	// (query must have been reset by calling code)
-	return (cq != nullptr && cq->GetHitPiece() != nullptr);
+	return (cq->GetHitPiece() != nullptr);
 }
 
 
@@ -350,7 +390,6 @@ bool CCollisionHandler::Intersect(const CollisionVolume* v, const CMatrix44f& m,
 	const CMatrix44f mInv = m.InvertAffine();
 	const float3 pi0 = mInv.Mul(p0);
 	const float3 pi1 = mInv.Mul(p1);
-	bool intersect = false;
 
 	// minimum and maximum (x, y, z) coordinates of transformed ray
 	const float3 rmin = float3::min(pi0, pi1);
@@ -368,6 +407,13 @@ bool CCollisionHandler::Intersect(const CollisionVolume* v, const CMatrix44f& m,
 	if (rmax.z < vmin.z || rmin.z > vmax.z)
 		return false;
 
+	return (CCollisionHandler::IntersectVolume(v, m, pi0, pi1, q));
+}
+
+bool CCollisionHandler::IntersectVolume(const CollisionVolume* v, const CMatrix44f& m, const float3& pi0, const float3& pi1, CollisionQuery* q)
+{
+	bool intersect = false;
+
 	switch (v->GetVolumeType()) {
 		case CollisionVolume::COLVOL_TYPE_ELLIPSOID:
 		case CollisionVolume::COLVOL_TYPE_SPHERE: {
@@ -394,6 +440,84 @@ bool CCollisionHandler::Intersect(const CollisionVolume* v, const CMatrix44f& m,
 	return intersect;
 }
 
+
+// the bounding-box test from Intersect for four (volume-space) segments at
+// once; rmin and rmax are computed as float3::{min,max} do (std::min(a, b)
+// is _mm_min_ps(b, a)) so the same pairs survive, NaN's included
+__FORCE_ALIGN_STACK__
+static int BoundingBoxMask4(const float3* pi0, const float3* pi1, const float3* hs)
+{
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+
+	int mask = 0xF;
+
+	for (int a = 0; a < 3; a++) {
+		const __m128 v0 = _mm_setr_ps(pi0[0][a], pi0[1][a], pi0[2][a], pi0[3][a]);
+		const __m128 v1 = _mm_setr_ps(pi1[0][a], pi1[1][a], pi1[2][a], pi1[3][a]);
+		const __m128 vmax = _mm_setr_ps(hs[0][a], hs[1][a], hs[2][a], hs[3][a]);
+		const __m128 vmin = _mm_xor_ps(vmax, signMask);
+
+		const __m128 rmin = _mm_min_ps(v1, v0);
+		const __m128 rmax = _mm_max_ps(v1, v0);
+
+		mask &= ~_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(rmax, vmin), _mm_cmpgt_ps(rmin, vmax)));
+	}
+
+	return mask;
+}
+
+unsigned int CCollisionHandler::IntersectBatch(
+	const CollisionVolume* const* vols,
+	const CMatrix44f* mats,
+	size_t count,
+	const float3& p0,
+	const float3& p1,
+	CollisionQuery* cqs
+) {
+	float3 pi0[4];
+	float3 pi1[4];
+	float3 hs[4];
+
+	unsigned int numHits = 0;
+
+	numContTests += count;
+	numBatchTests += count;
+
+	for (size_t i = 0; i < count; i += 4) {
+		const size_t n = std::min(count - i, size_t(4));
+
+		for (size_t j = 0; j < n; j++) {
+			const CMatrix44f mInv = mats[i + j].InvertAffine();
+
+			pi0[j] = mInv.Mul(p0);
+			pi1[j] = mInv.Mul(p1);
+			hs[j] = vols[i + j]->GetHScales();
+		}
+		for (size_t j = n; j < 4; j++) {
+			pi0[j] = pi0[0];
+			pi1[j] = pi1[0];
+			hs[j] = hs[0];
+		}
+
+		const int mask = BoundingBoxMask4(pi0, pi1, hs);
+
+		for (size_t j = 0; j < n; j++) {
+			cqs[i + j].Reset();
+
+			if ((mask & (1 << j)) == 0) {
+				numBatchRejects += 1;
+				continue;
+			}
+
+			numHits += CCollisionHandler::IntersectVolume(vols[i + j], mats[i + j], pi0[j], pi1[j], &cqs[i + j]);
+		}
+	}
+
+	return numHits;
+}
+
+
+
 bool CCollisionHandler::IntersectEllipsoid(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* q)
 {
 	// transform the volume-space points into (unit) sphere-space; requires fewer
@@ -162,7 +162,26 @@ class CCollisionHandler {
 		static bool IntersectPieceTree(const CSolidObject* o, const CMatrix44f& m, const float3& p0, const float3& p1, CollisionQuery* cq);
 		static bool IntersectPiecesHelper(const CSolidObject* o, const CMatrix44f& m, const float3& p0, const float3& p1, CollisionQuery* cqp);
 
+		static bool IntersectVolume(const CollisionVolume* v, const CMatrix44f& m, const float3& pi0, const float3& pi1, CollisionQuery* cq);
+
 	public:
+		/**
+		 * Batched version of Intersect(v, m, p0, p1, cq) for one segment vs.
+		 * many volumes; equivalent to the single tests executed in index
+		 * order. Matrices include the volumes' offsets, all cqs[i] are reset
+		 * and cqs[i].AnyHit() tells whether pair i intersected. Bounding-box
+		 * rejection runs on four pairs at a time.
+		 * @return number of intersecting pairs
+		 */
+		static unsigned int IntersectBatch(
+			const CollisionVolume* const* vols,
+			const CMatrix44f* mats,
+			size_t count,
+			const float3& p0,
+			const float3& p1,
+			CollisionQuery* cqs
+		);
+
 		static bool IntersectEllipsoid(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* cq);
 		static bool IntersectCylinder(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* cq);
 		static bool IntersectBox(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* cq);
@@ -170,6 +189,8 @@ class CCollisionHandler {
 	private:
 		static unsigned int numDiscTests; // number of discrete hit-tests executed
 		static unsigned int numContTests; // number of continuous hit-tests executed (inc. unsynced)
+		static unsigned int numBatchTests; // number of continuous hit-tests executed through IntersectBatch
+		static unsigned int numBatchRejects; // number of those rejected by the batched bounding-box test
 };
 
 #endif // COLLISION_HANDLER_H
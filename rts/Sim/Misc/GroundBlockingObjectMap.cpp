@@ -22,7 +22,8 @@ CR_BIND(CGroundBlockingObjectMap, )
 CR_REG_METADATA(CGroundBlockingObjectMap, (
 	CR_MEMBER(arrCells),
 	CR_MEMBER(vecCells),
-	CR_MEMBER(vecIndcs)
+	CR_MEMBER(vecIndcs),
+	CR_MEMBER(occupiedCells)
 ))
 
 
@@ -231,6 +232,9 @@ bool CGroundBlockingObjectMap::CellInsertUnique(unsigned int sqr, CSolidObject*
 
 	if (ac.Contains(o))
 		return false;
+
+	occupiedCells[sqr] = 1;
+
 	if (ac.Insert(o))
 		return true;
 
@@ -254,6 +258,8 @@ bool CGroundBlockingObjectMap::CellErase(unsigned int sqr, CSolidObject* o) {
 	VecCell* vc = nullptr;
 
 	if (ac.Erase(o)) {
+		occupiedCells[sqr] = !ac.Empty() || ac.GetVecIndx() != 0;
+
 		if (ac.GetVecIndx() == 0)
 			return true;
 
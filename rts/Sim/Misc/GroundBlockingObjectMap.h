@@ -3,6 +3,7 @@
 #ifndef GROUNDBLOCKINGOBJECTMAP_H
 #define GROUNDBLOCKINGOBJECTMAP_H
 
+#include <algorithm>
 #include <array>
 #include <vector>
 
@@ -99,6 +100,7 @@ public:
 
 	void Init(unsigned int numSquares) {
 		arrCells.resize(numSquares);
+		occupiedCells.resize(numSquares, 0);
 		vecCells.reserve(32);
 		vecIndcs.reserve(32);
 
@@ -116,6 +118,8 @@ public:
 			v.clear();
 		}
 
+		std::fill(occupiedCells.begin(), occupiedCells.end(), 0);
+
 		vecIndcs.clear();
 	}
 
@@ -164,6 +168,10 @@ public:
 	}
 
 
+	// dense mirror of !cell.empty(); lets footprint scans skip over
+	// unoccupied squares without touching the (much larger) cells
+	bool CellOccupiedUnsafe(unsigned int mapSquare) const { return (occupiedCells[mapSquare] != 0); }
+
 	BlockingMapCell GetCellUnsafeConst(const float3& pos) const;
 	BlockingMapCell GetCellUnsafeConst(unsigned int mapSquare) const {
 		assert(mapSquare < arrCells.size());
@@ -186,6 +194,7 @@ private:
 	std::vector<ArrCell> arrCells;
 	std::vector<VecCell> vecCells;
 	std::vector<uint32_t> vecIndcs;
+	std::vector<uint8_t> occupiedCells;
 };
 
 extern CGroundBlockingObjectMap groundBlockingObjectMap;
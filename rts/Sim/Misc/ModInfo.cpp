@@ -31,6 +31,7 @@ void CModInfo::ResetState()
 		allowUnitCollisionDamage   = false;
 		allowUnitCollisionOverlap  = true;
 		allowSepAxisCollisionTest  = false;
+		allowUnitCollisionPass     = false;
 		allowGroundUnitGravity     = true;
 		allowHoverUnitStrafing     = true;
 	}
@@ -150,6 +151,7 @@ void CModInfo::Init(const std::string& modFileName)
 		allowUnitCollisionDamage = movementTbl.GetBool("allowUnitCollisionDamage", allowUnitCollisionDamage);
 		allowUnitCollisionOverlap = movementTbl.GetBool("allowUnitCollisionOverlap", allowUnitCollisionOverlap);
 		allowSepAxisCollisionTest = movementTbl.GetBool("allowSepAxisCollisionTest", allowSepAxisCollisionTest);
+		allowUnitCollisionPass = movementTbl.GetBool("allowUnitCollisionPass", allowUnitCollisionPass);
 		allowGroundUnitGravity = movementTbl.GetBool("allowGroundUnitGravity", allowGroundUnitGravity);
 		allowHoverUnitStrafing = movementTbl.GetBool("allowHoverUnitStrafing", (pathFinderSystem == QTPFS_TYPE));
 	}
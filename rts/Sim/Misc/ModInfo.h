@@ -49,6 +49,7 @@ public:
 	bool allowUnitCollisionDamage;   //< determines if units take damage from (skidding) collisions
 	bool allowUnitCollisionOverlap;  //< determines if unit footprints are allowed to semi-overlap during collisions
 	bool allowSepAxisCollisionTest;  //< determines if (ground-)units perform collision-testing via the SAT
+	bool allowUnitCollisionPass;     //< determines if (ground-)unit collisions are resolved in one batched pass per frame
 	bool allowGroundUnitGravity;     //< determines if (ground-)units experience gravity during regular movement
 	bool allowHoverUnitStrafing;     //< determines if (hover-)units carry their momentum sideways when turning
 
@@ -12,6 +12,7 @@
 
 #ifndef UNIT_TEST
 	#include "Sim/Features/Feature.h"
+	#include "Sim/Features/FeatureDef.h"
 	#include "Sim/Projectiles/Projectile.h"
 	#include "Sim/Units/Unit.h"
 	#include "Sim/Weapons/PlasmaRepulser.h"
@@ -25,6 +26,7 @@ CR_REG_METADATA(CQuadField, (
 	CR_MEMBER(quadSizeX),
 	CR_MEMBER(quadSizeZ),
 	CR_MEMBER(invQuadSize),
+	CR_MEMBER(maxReclaimFeatureRadius),
 
 	CR_IGNORED(tempUnits),
 	CR_IGNORED(tempFeatures),
@@ -40,6 +42,8 @@ CR_REG_METADATA_SUB(CQuadField, Quad, (
 	CR_MEMBER(features),
 	CR_MEMBER(projectiles),
 	CR_MEMBER(repulsers),
+	CR_MEMBER(reclaimFeatures),
+	CR_MEMBER(reclaimCounts),
 
 	CR_POSTLOAD(PostLoad)
 ))
@@ -139,6 +143,8 @@ void CQuadField::Kill()
 		quad.Clear();
 	}
 
+	maxReclaimFeatureRadius = 0.0f;
+
 	tempUnits.ReleaseAll();
 	tempFeatures.ReleaseAll();
 	tempProjectiles.ReleaseAll();
@@ -456,6 +462,21 @@ void CQuadField::AddFeature(CFeature* feature)
 	for (const int qi: *qfQuery.quads) {
 		spring::VectorInsertUnique(baseQuads[qi].features, feature, false);
 	}
+
+	if (!feature->def->reclaimable && feature->udef == nullptr)
+		return;
+
+	Quad& quad = baseQuads[WorldPosToQuadFieldIdx(feature->pos)];
+
+	if (!spring::VectorInsertUnique(quad.reclaimFeatures, feature, true))
+		return;
+
+	quad.reclaimCounts[RECLAIM_COUNT_METAL      ] += (feature->defResources.metal  > 0.0f);
+	quad.reclaimCounts[RECLAIM_COUNT_ENERGY     ] += (feature->defResources.energy > 0.0f);
+	quad.reclaimCounts[RECLAIM_COUNT_AUTORECLAIM] += (feature->def->reclaimable && feature->def->autoreclaim);
+	quad.reclaimCounts[RECLAIM_COUNT_RESURRECT  ] += (feature->udef != nullptr);
+
+	maxReclaimFeatureRadius = std::max(maxReclaimFeatureRadius, feature->radius);
 }
 
 void CQuadField::RemoveFeature(CFeature* feature)
@@ -467,6 +488,15 @@ void CQuadField::RemoveFeature(CFeature* feature)
 		spring::VectorErase(baseQuads[qi].features, feature);
 	}
 
+	Quad& quad = baseQuads[WorldPosToQuadFieldIdx(feature->pos)];
+
+	if (spring::VectorErase(quad.reclaimFeatures, feature)) {
+		quad.reclaimCounts[RECLAIM_COUNT_METAL      ] -= (feature->defResources.metal  > 0.0f);
+		quad.reclaimCounts[RECLAIM_COUNT_ENERGY     ] -= (feature->defResources.energy > 0.0f);
+		quad.reclaimCounts[RECLAIM_COUNT_AUTORECLAIM] -= (feature->def->reclaimable && feature->def->autoreclaim);
+		quad.reclaimCounts[RECLAIM_COUNT_RESURRECT  ] -= (feature->udef != nullptr);
+	}
+
 	#ifdef DEBUG_QUADFIELD
 	for (const Quad& q: baseQuads) {
 		for (CFeature* f: q.features) {
@@ -478,6 +508,47 @@ void CQuadField::RemoveFeature(CFeature* feature)
 
 
 
+void CQuadField::GetReclaimQuads(std::vector< std::pair<float, int> >& quads, const float3& pos, float radius, const float3& refPos) const
+{
+	quads.clear();
+
+	// features are listed by center, so widen the search by their radius
+	const float searchRadius = radius + maxReclaimFeatureRadius;
+
+	const int2 min = WorldPosToQuadField(pos - searchRadius);
+	const int2 max = WorldPosToQuadField(pos + searchRadius);
+
+	for (int z = min.y; z <= max.y; ++z) {
+		for (int x = min.x; x <= max.x; ++x) {
+			const int qi = z * numQuadsX + x;
+
+			if (baseQuads[qi].reclaimFeatures.empty())
+				continue;
+
+			const float2 quadMins = {x * quadSizeX * 1.0f, z * quadSizeZ * 1.0f};
+			const float2 quadMaxs = {quadMins.x + quadSizeX, quadMins.y + quadSizeZ};
+
+			// distance from pos resp. refPos to the closest point inside the quad
+			const float2 posDist = {
+				std::max(0.0f, std::max(quadMins.x - pos.x, pos.x - quadMaxs.x)),
+				std::max(0.0f, std::max(quadMins.y - pos.z, pos.z - quadMaxs.y)),
+			};
+			const float2 refDist = {
+				std::max(0.0f, std::max(quadMins.x - refPos.x, refPos.x - quadMaxs.x)),
+				std::max(0.0f, std::max(quadMins.y - refPos.z, refPos.z - quadMaxs.y)),
+			};
+
+			if ((posDist.x * posDist.x + posDist.y * posDist.y) >= (searchRadius * searchRadius))
+				continue;
+
+			quads.emplace_back(refDist.x * refDist.x + refDist.y * refDist.y, qi);
+		}
+	}
+
+	std::sort(quads.begin(), quads.end());
+}
+
+
 void CQuadField::MovedProjectile(CProjectile* p)
 {
 	if (!p->synced)
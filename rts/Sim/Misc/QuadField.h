@@ -160,6 +160,15 @@ public:
 	void AddFeature(CFeature* feature);
 	void RemoveFeature(CFeature* feature);
 
+	/**
+	 * Returns the quads whose reclaim-lists might hold features within
+	 * @c radius of @c pos (2D, model radius included), as pairs of the
+	 * squared 2D distance from @c refPos to the quad and its index and
+	 * sorted by the former. Used for nearest-first target searches that
+	 * can stop at the first quad further away than their best candidate.
+	 */
+	void GetReclaimQuads(std::vector< std::pair<float, int> >& quads, const float3& pos, float radius, const float3& refPos) const;
+
 	void MovedProjectile(CProjectile* projectile);
 	void AddProjectile(CProjectile* projectile);
 	void RemoveProjectile(CProjectile* projectile);
@@ -173,6 +182,14 @@ public:
 	void ReleaseVector(std::vector<CSolidObject*>* v) { tempSolids.ReleaseVector(v); }
 	void ReleaseVector(std::vector<int>* v          ) { tempQuads.ReleaseVector(v); }
 
+	enum ReclaimCountType {
+		RECLAIM_COUNT_METAL       = 0, // features with metal
+		RECLAIM_COUNT_ENERGY      = 1, // features with energy
+		RECLAIM_COUNT_AUTORECLAIM = 2, // features picked by area-reclaim without CTRL
+		RECLAIM_COUNT_RESURRECT   = 3, // features that can be resurrected
+		RECLAIM_COUNT_TYPES       = 4,
+	};
+
 	struct Quad {
 	public:
 		CR_DECLARE_STRUCT(Quad)
@@ -188,6 +205,8 @@ public:
 			features = std::move(q.features);
 			projectiles = std::move(q.projectiles);
 			repulsers = std::move(q.repulsers);
+			reclaimFeatures = std::move(q.reclaimFeatures);
+			std::copy(std::begin(q.reclaimCounts), std::end(q.reclaimCounts), std::begin(reclaimCounts));
 			return *this;
 		}
 
@@ -203,6 +222,8 @@ public:
 			features.clear();
 			projectiles.clear();
 			repulsers.clear();
+			reclaimFeatures.clear();
+			std::fill(std::begin(reclaimCounts), std::end(reclaimCounts), 0);
 		}
 
 	public:
@@ -211,6 +232,12 @@ public:
 		std::vector<CFeature*> features;
 		std::vector<CProjectile*> projectiles;
 		std::vector<CPlasmaRepulser*> repulsers;
+
+		// reclaimable or resurrectable features whose center lies in this
+		// quad; unlike <features> each is listed in exactly one quad
+		std::vector<CFeature*> reclaimFeatures;
+
+		int reclaimCounts[RECLAIM_COUNT_TYPES] = {0};
 	};
 
 	const Quad& GetQuad(unsigned i) const {
@@ -252,6 +279,9 @@ private:
 
 	int quadSizeX;
 	int quadSizeZ;
+
+	// largest radius of any feature ever added to a reclaim-list
+	float maxReclaimFeatureRadius = 0.0f;
 };
 
 extern CQuadField quadField;
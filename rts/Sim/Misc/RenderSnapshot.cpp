@@ -0,0 +1,118 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "RenderSnapshot.h"
+
+#include "Sim/Projectiles/Projectile.h"
+#include "Sim/Projectiles/ProjectileHandler.h"
+#include "Sim/Units/Unit.h"
+#include "Sim/Units/UnitHandler.h"
+#include "System/Threading/ThreadPool.h"
+
+
+CRenderSnapshot renderSnapshot;
+
+
+void CRenderSnapshot::Init()
+{
+	#ifdef HEADLESS
+	enabled = false;
+	#endif
+
+	frontIndex = 0;
+
+	if (!enabled)
+		return;
+
+	for (Buffer& buffer: buffers) {
+		buffer.units.clear();
+		buffer.units.resize(unitHandler.MaxUnits());
+		buffer.projectiles.clear();
+		buffer.frameNum = -1;
+	}
+}
+
+void CRenderSnapshot::Kill()
+{
+	for (Buffer& buffer: buffers) {
+		buffer = {};
+	}
+}
+
+
+void CRenderSnapshot::Capture(int frameNum)
+{
+	if (!enabled)
+		return;
+
+	// only the sim writes to the back-buffer, no lock needed until the swap
+	Buffer& back = buffers[frontIndex ^ 1];
+
+	const auto& units = unitHandler.GetActiveUnits();
+	const auto& projectiles = projectileHandler.GetActiveProjectiles(true);
+
+	for (const CProjectile* p: projectiles) {
+		if (p->id >= int(back.projectiles.size()))
+			back.projectiles.resize(p->id + 1);
+	}
+
+	for_mt(0, units.size(), [&](const int i) {
+		const CUnit* u = units[i];
+		const CUnit* t = u->GetTransporter();
+
+		ObjectState& s = back.units[u->id];
+
+		s.pos = u->preFramePos;
+		// transported units move with their transporter
+		s.deltaPos = (t != nullptr)? (t->pos - t->preFramePos): (u->pos - u->preFramePos);
+		s.object = u;
+		s.frameNum = frameNum;
+	});
+
+	for_mt(0, projectiles.size(), [&](const int i) {
+		const CProjectile* p = projectiles[i];
+
+		ObjectState& s = back.projectiles[p->id];
+
+		s.pos = p->pos;
+		s.deltaPos = p->speed;
+		s.object = p;
+		s.frameNum = frameNum;
+	});
+
+	back.frameNum = frameNum;
+
+	{
+		std::lock_guard<spring::mutex> lock(swapMutex);
+		frontIndex ^= 1;
+	}
+}
+
+
+bool CRenderSnapshot::GetUnitDrawPos(const Buffer& snapshot, const CUnit* unit, float timeOffset, float3& drawPos)
+{
+	if (unit->id >= int(snapshot.units.size()))
+		return false;
+
+	const ObjectState& s = snapshot.units[unit->id];
+
+	// created after the snapshot was taken, or slot belongs to a dead unit
+	if (s.frameNum != snapshot.frameNum || s.object != unit)
+		return false;
+
+	drawPos = s.pos + s.deltaPos * timeOffset;
+	return true;
+}
+
+bool CRenderSnapshot::GetProjectileDrawPos(const Buffer& snapshot, const CProjectile* pro, float timeOffset, float3& drawPos)
+{
+	if (!pro->synced || pro->id >= int(snapshot.projectiles.size()))
+		return false;
+
+	const ObjectState& s = snapshot.projectiles[pro->id];
+
+	if (s.frameNum != snapshot.frameNum || s.object != pro)
+		return false;
+
+	drawPos = s.pos + s.deltaPos * timeOffset;
+	return true;
+}
@@ -0,0 +1,80 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include <vector>
+
+#include "System/float3.h"
+#include "System/Threading/SpringThreading.h"
+
+class CUnit;
+class CProjectile;
+
+/**
+ * Render-relevant state of units and synced projectiles, captured at the
+ * end of each sim-frame into a back-buffer which is then swapped with the
+ * front-buffer that drawers interpolate from. Drawers that read positions
+ * through the snapshot never touch state the sim is updating, which is the
+ * prerequisite for running the sim concurrently with the draw thread.
+ *
+ * Internal prerequisite only: the sim still runs on the draw thread, so
+ * nothing enables this yet; whatever moves the sim to its own thread has
+ * to call SetEnabled before Init. Never captured while skipping or in
+ * headless builds, where nothing would read it.
+ */
+class CRenderSnapshot
+{
+public:
+	struct ObjectState {
+		float3 pos;
+		/// per-frame delta the drawer scales by globalRendering->timeOffset
+		float3 deltaPos;
+		/// identity check against id reuse, never dereferenced
+		const void* object = nullptr;
+		/// sim-frame this entry was captured in, stale entries are ignored
+		int frameNum = -1;
+	};
+
+	struct Buffer {
+		std::vector<ObjectState> units;
+		std::vector<ObjectState> projectiles;
+
+		int frameNum = -1;
+	};
+
+public:
+	void Init();
+	void Kill();
+
+	bool IsEnabled() const { return enabled; }
+	/// takes effect at the next Init
+	void SetEnabled(bool b) { enabled = b; }
+
+	/// sim-side; fills the back-buffer and publishes it
+	void Capture(int frameNum);
+
+	/// draw-side; f is called with the current front-buffer, which will not
+	/// be swapped out (and then overwritten) until f returns
+	template<typename F> void Read(F&& f) {
+		std::lock_guard<spring::mutex> lock(swapMutex);
+		f(buffers[frontIndex]);
+	}
+
+	static bool GetUnitDrawPos(const Buffer& snapshot, const CUnit* unit, float timeOffset, float3& drawPos);
+	static bool GetProjectileDrawPos(const Buffer& snapshot, const CProjectile* pro, float timeOffset, float3& drawPos);
+
+private:
+	Buffer buffers[2];
+
+	spring::mutex swapMutex;
+	/// only changed by Capture under swapMutex; Capture itself can read it
+	/// without the lock since it runs on the (only) writing thread
+	unsigned int frontIndex = 0;
+
+	bool enabled = false;
+};
+
+extern CRenderSnapshot renderSnapshot;
+
+#endif
@@ -49,6 +49,7 @@ CR_REG_METADATA(CTeam, (
 	CR_MEMBER(resPrevExcess),
 	CR_MEMBER(nextHistoryEntry),
 	CR_MEMBER(statHistory),
+	CR_MEMBER(unitAggregates),
 	CR_MEMBER(modParams),
 	CR_IGNORED(highlight)
 ))
@@ -398,6 +399,7 @@ void CTeam::SlowUpdate()
 void CTeam::AddUnit(CUnit* unit, AddType type)
 {
 	numUnits++;
+	unitAggregates.AddUnit(unit);
 
 	switch (type) {
 		case AddBuilt: {
@@ -416,6 +418,11 @@ void CTeam::AddUnit(CUnit* unit, AddType type)
 void CTeam::RemoveUnit(CUnit* unit, RemoveType type)
 {
 	numUnits--;
+	unitAggregates.RemoveUnit(unit);
+
+	// drop the rounding error accumulated by the float sums
+	if (numUnits == 0)
+		unitAggregates.Reset();
 
 	switch (type) {
 		case RemoveDied: {
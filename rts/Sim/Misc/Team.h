@@ -7,6 +7,7 @@
 #include <vector>
 #include <list>
 
+#include "TeamAggregates.h"
 #include "TeamBase.h"
 #include "TeamStatistics.h"
 #include "Sim/Misc/Resource.h"
@@ -96,6 +97,9 @@ public:
 	int nextHistoryEntry;
 	std::vector<TeamStatistics> statHistory;
 
+	/// live totals over this team's units, see TeamAggregates
+	TeamAggregates unitAggregates;
+
 	/// mod controlled parameters
 	LuaRulesParams::Params  modParams;
 
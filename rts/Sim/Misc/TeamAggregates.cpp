@@ -0,0 +1,75 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "TeamAggregates.h"
+
+#include "Sim/Units/Unit.h"
+#include "Sim/Units/UnitDef.h"
+
+#include <algorithm>
+
+
+CR_BIND(TeamAggregates, )
+CR_REG_METADATA(TeamAggregates, (
+	CR_MEMBER(unitCounts),
+	CR_MEMBER(unitResMake),
+	CR_MEMBER(unitResUse),
+	CR_MEMBER(buildPower),
+	CR_MEMBER(buildPowerUsed)
+))
+
+
+void TeamAggregates::Reset()
+{
+	std::fill(std::begin(unitCounts), std::end(unitCounts), 0);
+
+	unitResMake = {};
+	unitResUse = {};
+
+	buildPower = 0.0f;
+	buildPowerUsed = 0.0f;
+}
+
+
+void TeamAggregates::UpdateUnit(const CUnit* unit, int sign)
+{
+	const UnitDef* ud = unit->unitDef;
+
+	unitCounts[UNITS_TOTAL  ] += sign;
+	unitCounts[UNITS_MOBILE ] += (sign * (!ud->IsImmobileUnit() && !ud->IsAirUnit()));
+	unitCounts[UNITS_STATIC ] += (sign * ud->IsImmobileUnit());
+	unitCounts[UNITS_AIR    ] += (sign * ud->IsAirUnit());
+	unitCounts[UNITS_BUILDER] += (sign * ud->IsBuilderUnit());
+	unitCounts[UNITS_FACTORY] += (sign * ud->IsFactoryUnit());
+	unitCounts[UNITS_ARMED  ] += (sign * ud->HasWeapons());
+
+	if (sign > 0) {
+		unitResMake += unit->resourcesMake;
+		unitResUse  += unit->resourcesUse;
+	} else {
+		unitResMake -= unit->resourcesMake;
+		unitResUse  -= unit->resourcesUse;
+	}
+
+	UpdateUnitBuildState(unit, sign);
+}
+
+void TeamAggregates::UpdateUnitBuildState(const CUnit* unit, int sign)
+{
+	unitCounts[UNITS_FINISHED   ] += (sign * !unit->beingBuilt);
+	unitCounts[UNITS_BEING_BUILT] += (sign *  unit->beingBuilt);
+
+	// nanoframes do not build anything
+	if (unit->beingBuilt)
+		return;
+
+	buildPower     += (sign * unit->GetBuildPower());
+	buildPowerUsed += (sign * unit->GetBuildPower() * unit->IsUsingBuildPower());
+}
+
+void TeamAggregates::UpdateUnitBuildPowerUse(const CUnit* unit, bool inUse)
+{
+	if (unit->beingBuilt)
+		return;
+
+	buildPowerUsed += ((inUse * 2 - 1) * unit->GetBuildPower());
+}
@@ -0,0 +1,73 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef TEAM_AGGREGATES_H
+#define TEAM_AGGREGATES_H
+
+#include "Resource.h"
+#include "System/creg/creg_cond.h"
+
+class CUnit;
+
+/**
+ * Per-team totals over all units owned by the team, kept up to date as units
+ * join or leave the team or change state (finish construction, start or stop
+ * using their build-power, produce different amounts of resources) instead of
+ * being recomputed by whoever wants to know. Readable through Lua and the AI
+ * interface at the cost of a lookup.
+ */
+struct TeamAggregates
+{
+	CR_DECLARE_STRUCT(TeamAggregates)
+
+	// NB: exposed by value to Lua and AI's, only append
+	enum UnitCountType {
+		UNITS_TOTAL       = 0,
+		UNITS_FINISHED    = 1,
+		UNITS_BEING_BUILT = 2,
+		UNITS_MOBILE      = 3, // excluding aircraft
+		UNITS_STATIC      = 4,
+		UNITS_AIR         = 5,
+		UNITS_BUILDER     = 6, // including factories
+		UNITS_FACTORY     = 7,
+		UNITS_ARMED       = 8,
+		UNITS_COUNT_TYPES = 9,
+	};
+
+	TeamAggregates() { Reset(); }
+
+	void Reset();
+
+	void AddUnit(const CUnit* unit) { UpdateUnit(unit, 1); }
+	void RemoveUnit(const CUnit* unit) { UpdateUnit(unit, -1); }
+
+	/// remove (-1) and re-add (+1) the parts that depend on unit->beingBuilt
+	/// or the unit's build-power, around changes to either
+	void UpdateUnitBuildState(const CUnit* unit, int sign);
+	/// unit started or stopped spending its build-power on something
+	void UpdateUnitBuildPowerUse(const CUnit* unit, bool inUse);
+	/// unit's resourcesMake and resourcesUse changed by the given amounts
+	void UpdateUnitResources(const SResourcePack& deltaMake, const SResourcePack& deltaUse) {
+		unitResMake += deltaMake;
+		unitResUse  += deltaUse;
+	}
+
+	int GetUnitCount(unsigned int type) const { return ((type < UNITS_COUNT_TYPES)? unitCounts[type]: 0); }
+
+private:
+	void UpdateUnit(const CUnit* unit, int sign);
+
+public:
+	int unitCounts[UNITS_COUNT_TYPES];
+
+	/// sum of CUnit::resources{Make,Use}, i.e. what the team's units made and
+	/// used over the last TEAM_SLOWUPDATE_RATE frames
+	SResourcePack unitResMake;
+	SResourcePack unitResUse;
+
+	/// sum of the build-speeds (in UnitDef units) of all finished builders
+	/// and factories, and of those currently building, repairing, etc
+	float buildPower;
+	float buildPowerUsed;
+};
+
+#endif
@@ -31,10 +31,15 @@
 #include "System/FastMath.h"
 #include "System/SpringMath.h"
 #include "System/TimeProfiler.h"
+#include "System/Threading/ThreadPool.h"
 #include "System/type2.h"
 #include "System/Sound/ISoundChannels.h"
 #include "System/Sync/HsiehHash.h"
 
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
 #if 1
 #include "Rendering/IPathDrawer.h"
 #define DEBUG_DRAWING_ENABLED ((gs->cheatEnabled || gu->spectatingFullView) && pathDrawer->IsEnabled())
@@ -359,6 +364,112 @@ static constexpr decltype(&CalcSpeedVectorInclGravity) calcSpeedVectorFuncs[] =
 
 
 
+static bool IgnoreUnitCollidee(const CUnit* collider, const CUnit* collidee)
+{
+	if (collidee == collider) return true;
+	if (collidee->IsSkidding()) return true;
+	if (collidee->IsFlying()) return true;
+
+	return false;
+}
+
+static void CalcUnitCollisionParams(
+	const CUnit* collider,
+	const CUnit* collidee,
+	const float3& colliderParams,
+	float2& collideeParams,
+	float4& separationVect
+) {
+	const MoveDef* collideeMD = collidee->moveDef;
+
+	// use the collidee's MoveDef footprint as radius if it is mobile
+	// use the collidee's Unit (not UnitDef) footprint as radius otherwise
+	collideeParams = {collidee->speed.w, (collideeMD != nullptr)? collideeMD->CalcFootPrintMaxInteriorRadius(): collidee->CalcFootPrintMaxInteriorRadius()};
+	separationVect = {collider->pos - collidee->pos, Square(colliderParams.y + collideeParams.y)};
+}
+
+// NOTE:
+//   does not modify either party, so the collision pass can evaluate it
+//   concurrently; not symmetric (eg. the transporter exclusions), so each
+//   orientation of a pair has to be tested on its own
+static bool TestUnitCollision(
+	const CUnit* collider,
+	const CUnit* collidee,
+	const float3& colliderParams,
+	float2& collideeParams,
+	float4& separationVect
+) {
+	const MoveDef* colliderMD = collider->moveDef;
+	const MoveDef* collideeMD = collidee->moveDef;
+
+	const bool colliderMobile = (colliderMD != nullptr); // always true
+	const bool collideeMobile = (collideeMD != nullptr); // maybe true
+
+	const bool allowSAT = modInfo.allowSepAxisCollisionTest;
+	const bool forceSAT = (colliderParams.z > 0.1f);
+
+	// don't push/crush either party if the collidee does not block the collider (or vv.)
+	if (colliderMobile && CMoveMath::IsNonBlocking(*colliderMD, collidee, collider))
+		return false;
+	if (collideeMobile && CMoveMath::IsNonBlocking(*collideeMD, collider, collidee))
+		return false;
+
+	// disable collisions between collider and collidee
+	// if collidee is currently inside any transporter,
+	// or if collider is being transported by collidee
+	if (collider->GetTransporter() == collidee) return false;
+	if (collidee->GetTransporter() != nullptr) return false;
+	// also disable collisions if either party currently
+	// has an order to load units (TODO: do we want this
+	// for unloading as well?)
+	if (collider->loadingTransportId == collidee->id) return false;
+	if (collidee->loadingTransportId == collider->id) return false;
+
+	CalcUnitCollisionParams(collider, collidee, colliderParams, collideeParams, separationVect);
+
+	return (checkCollisionFuncs[allowSAT && (forceSAT || (collideeMobile && collideeMD->CalcFootPrintAxisStretchFactor() > 0.1f))](separationVect, collider, collidee, colliderMD, collideeMD));
+}
+
+
+
+// frame-level unit-unit collision pass, see HandleUnitCollisionPass
+static constexpr int UNIT_COLLISION_CELL_SIZE = SQUARE_SIZE * 8;
+
+struct QueuedUnitCollider {
+	CGroundMoveType* moveType;
+	CUnit* unit;
+	float3 params;
+};
+
+struct UnitCollisionCandidate {
+	CUnit* collider;
+	CUnit* collidee;
+};
+
+struct UnitCollisionPair {
+	// second side is only set if the pair was found by both units
+	UnitCollisionCandidate sides[2];
+	bool colliding[2];
+};
+
+static struct {
+	std::vector<QueuedUnitCollider> colliders;
+	// unit-id to index into colliders (or -1)
+	std::vector<int> colliderIndices;
+
+	// uniform grid in CSR form: units overlapping cell i are
+	// cellUnits[cellOffsets[i] ... cellOffsets[i + 1] - 1]
+	std::vector<unsigned int> cellOffsets;
+	std::vector<unsigned int> cellCursors;
+	std::vector<CUnit*> cellUnits;
+
+	std::vector< std::vector<UnitCollisionCandidate> > candidates;
+	std::vector<UnitCollisionCandidate> mergedCandidates;
+	std::vector<UnitCollisionPair> pairs;
+} unitCollisionPass;
+
+
+
 
 CGroundMoveType::CGroundMoveType(CUnit* owner):
 	AMoveType(owner),
@@ -1764,7 +1875,11 @@ void CGroundMoveType::HandleObjectCollisions()
 		const float colliderFootPrintRadius = colliderMD->CalcFootPrintMaxInteriorRadius(); // ~= CalcFootPrintMinExteriorRadius(0.75f)
 		const float colliderAxisStretchFact = colliderMD->CalcFootPrintAxisStretchFactor();
 
-		HandleUnitCollisions(collider, {collider->speed.w, colliderFootPrintRadius, colliderAxisStretchFact}, colliderUD, colliderMD);
+		if (modInfo.allowUnitCollisionPass) {
+			QueueUnitCollisions(collider, {collider->speed.w, colliderFootPrintRadius, colliderAxisStretchFact});
+		} else {
+			HandleUnitCollisions(collider, {collider->speed.w, colliderFootPrintRadius, colliderAxisStretchFact}, colliderUD, colliderMD);
+		}
 		HandleFeatureCollisions(collider, {collider->speed.w, colliderFootPrintRadius, colliderAxisStretchFact}, colliderUD, colliderMD);
 
 		// blocked square collision (very performance hungry, process only every 2nd game frame)
@@ -1983,29 +2098,13 @@ void CGroundMoveType::HandleUnitCollisions(
 	const UnitDef* colliderUD,
 	const MoveDef* colliderMD
 ) {
-	// NOTE: probably too large for most units (eg. causes tree falling animations to be skipped)
-	const float3 crushImpulse = collider->speed * collider->mass * Sign(int(!reversing));
-
-	const bool allowUCO = modInfo.allowUnitCollisionOverlap;
-	const bool allowCAU = modInfo.allowCrushingAlliedUnits;
-	const bool allowPEU = modInfo.allowPushingEnemyUnits;
-	const bool allowSAT = modInfo.allowSepAxisCollisionTest;
-	const bool forceSAT = (colliderParams.z > 0.1f);
-
 	// copy on purpose, since the below can call Lua
 	QuadFieldQuery qfQuery;
 	quadField.GetUnitsExact(qfQuery, collider->pos, colliderParams.x + (colliderParams.y * 2.0f));
 
 	for (CUnit* collidee: *qfQuery.units) {
-		if (collidee == collider) continue;
-		if (collidee->IsSkidding()) continue;
-		if (collidee->IsFlying()) continue;
-
-		const UnitDef* collideeUD = collidee->unitDef;
-		const MoveDef* collideeMD = collidee->moveDef;
-
-		const bool colliderMobile = (colliderMD != nullptr); // always true
-		const bool collideeMobile = (collideeMD != nullptr); // maybe true
+		if (IgnoreUnitCollidee(collider, collidee))
+			continue;
 
 		const bool unloadingCollidee = (collidee->unloadingTransportId == collider->id);
 		const bool unloadingCollider = (collider->unloadingTransportId == collidee->id);
@@ -2015,30 +2114,10 @@ void CGroundMoveType::HandleUnitCollisions(
 		if (unloadingCollider)
 			collider->unloadingTransportId = -1;
 
+		float2 collideeParams;
+		float4 separationVect;
 
-		// don't push/crush either party if the collidee does not block the collider (or vv.)
-		if (colliderMobile && CMoveMath::IsNonBlocking(*colliderMD, collidee, collider))
-			continue;
-		if (collideeMobile && CMoveMath::IsNonBlocking(*collideeMD, collider, collidee))
-			continue;
-
-		// disable collisions between collider and collidee
-		// if collidee is currently inside any transporter,
-		// or if collider is being transported by collidee
-		if (collider->GetTransporter() == collidee) continue;
-		if (collidee->GetTransporter() != nullptr) continue;
-		// also disable collisions if either party currently
-		// has an order to load units (TODO: do we want this
-		// for unloading as well?)
-		if (collider->loadingTransportId == collidee->id) continue;
-		if (collidee->loadingTransportId == collider->id) continue;
-
-		// use the collidee's MoveDef footprint as radius if it is mobile
-		// use the collidee's Unit (not UnitDef) footprint as radius otherwise
-		const float2 collideeParams = {collidee->speed.w, collideeMobile? collideeMD->CalcFootPrintMaxInteriorRadius(): collidee->CalcFootPrintMaxInteriorRadius()};
-		const float4 separationVect = {collider->pos - collidee->pos, Square(colliderParams.y + collideeParams.y)};
-
-		if (!checkCollisionFuncs[allowSAT && (forceSAT || (collideeMobile && collideeMD->CalcFootPrintAxisStretchFactor() > 0.1f))](separationVect, collider, collidee, colliderMD, collideeMD))
+		if (!TestUnitCollision(collider, collidee, colliderParams, collideeParams, separationVect))
 			continue;
 
 
@@ -2052,119 +2131,353 @@ void CGroundMoveType::HandleUnitCollisions(
 			continue;
 		}
 
+		HandleUnitCollisionResponse(collider, collidee, colliderParams, collideeParams, separationVect, colliderUD, colliderMD);
+	}
+}
 
-		// NOTE:
-		//   we exclude aircraft (which have NULL moveDef's) landed
-		//   on the ground, since they would just stack when pushed
-		bool pushCollider = colliderMobile;
-		bool pushCollidee = collideeMobile;
-		bool crushCollidee = false;
-
-		const bool alliedCollision =
-			teamHandler.Ally(collider->allyteam, collidee->allyteam) &&
-			teamHandler.Ally(collidee->allyteam, collider->allyteam);
-		const bool collideeYields = (collider->IsMoving() && !collidee->IsMoving());
-		const bool ignoreCollidee = (collideeYields && alliedCollision);
-
-		crushCollidee |= (!alliedCollision || allowCAU);
-		crushCollidee &= ((colliderParams.x * collider->mass) > (collideeParams.x * collidee->mass));
-
-		if (crushCollidee && !CMoveMath::CrushResistant(*colliderMD, collidee))
-			collidee->Kill(collider, crushImpulse, true);
+void CGroundMoveType::HandleUnitCollisionResponse(
+	CUnit* collider,
+	CUnit* collidee,
+	const float3& colliderParams,
+	const float2& collideeParams,
+	const float4& separationVect,
+	const UnitDef* colliderUD,
+	const MoveDef* colliderMD
+) {
+	// NOTE: probably too large for most units (eg. causes tree falling animations to be skipped)
+	const float3 crushImpulse = collider->speed * collider->mass * Sign(int(!reversing));
 
-		if (eventHandler.UnitUnitCollision(collider, collidee))
-			continue;
+	const bool allowUCO = modInfo.allowUnitCollisionOverlap;
+	const bool allowCAU = modInfo.allowCrushingAlliedUnits;
+	const bool allowPEU = modInfo.allowPushingEnemyUnits;
 
-		if (collideeMobile)
-			HandleUnitCollisionsAux(collider, collidee, this, static_cast<CGroundMoveType*>(collidee->moveType));
+	const UnitDef* collideeUD = collidee->unitDef;
+	const MoveDef* collideeMD = collidee->moveDef;
 
-		// NOTE:
-		//   allowPushingEnemyUnits is (now) useless because alliances are bi-directional
-		//   ie. if !alliedCollision, pushCollider and pushCollidee BOTH become false and
-		//   the collision is treated normally --> not what we want here, but the desired
-		//   behavior (making each party stop and block the other) has many corner-cases
-		//   so instead have collider respond as though collidee is semi-static obstacle
-		//   this also happens when both parties are pushResistant
-		pushCollider = pushCollider && (alliedCollision || allowPEU || !collider->blockEnemyPushing);
-		pushCollidee = pushCollidee && (alliedCollision || allowPEU || !collidee->blockEnemyPushing);
-		pushCollider = pushCollider && (!collider->beingBuilt && !collider->UsingScriptMoveType() && !collider->moveType->IsPushResistant());
-		pushCollidee = pushCollidee && (!collidee->beingBuilt && !collidee->UsingScriptMoveType() && !collidee->moveType->IsPushResistant());
-
-		if ((!collideeMobile && !collideeUD->IsAirUnit()) || (!pushCollider && !pushCollidee)) {
-			// building (always axis-aligned, possibly has a yardmap)
-			// or semi-static collidee that should be handled as such
-			//
-			// since all push-resistant units use the BLOCK_STRUCTURE
-			// mask when stopped, avoid the yardmap || terrain branch
-			// of HSOC which is not well suited to both parties moving
-			// and can leave them inside stuck each other's footprints
-			const bool allowNewPath = (!atEndOfPath && !atGoal);
-			const bool checkYardMap = ((pushCollider || pushCollidee) || collideeUD->IsFactoryUnit());
-
-			if (HandleStaticObjectCollision(collider, collidee, colliderMD,  colliderParams.y, collideeParams.y,  separationVect, allowNewPath, checkYardMap, false))
-				ReRequestPath(false);
+	const bool colliderMobile = (colliderMD != nullptr); // always true
+	const bool collideeMobile = (collideeMD != nullptr); // maybe true
 
-			continue;
+	// NOTE:
+	//   we exclude aircraft (which have NULL moveDef's) landed
+	//   on the ground, since they would just stack when pushed
+	bool pushCollider = colliderMobile;
+	bool pushCollidee = collideeMobile;
+	bool crushCollidee = false;
+
+	const bool alliedCollision =
+		teamHandler.Ally(collider->allyteam, collidee->allyteam) &&
+		teamHandler.Ally(collidee->allyteam, collider->allyteam);
+	const bool collideeYields = (collider->IsMoving() && !collidee->IsMoving());
+	const bool ignoreCollidee = (collideeYields && alliedCollision);
+
+	crushCollidee |= (!alliedCollision || allowCAU);
+	crushCollidee &= ((colliderParams.x * collider->mass) > (collideeParams.x * collidee->mass));
+
+	if (crushCollidee && !CMoveMath::CrushResistant(*colliderMD, collidee))
+		collidee->Kill(collider, crushImpulse, true);
+
+	if (eventHandler.UnitUnitCollision(collider, collidee))
+		return;
+
+	if (collideeMobile)
+		HandleUnitCollisionsAux(collider, collidee, this, static_cast<CGroundMoveType*>(collidee->moveType));
+
+	// NOTE:
+	//   allowPushingEnemyUnits is (now) useless because alliances are bi-directional
+	//   ie. if !alliedCollision, pushCollider and pushCollidee BOTH become false and
+	//   the collision is treated normally --> not what we want here, but the desired
+	//   behavior (making each party stop and block the other) has many corner-cases
+	//   so instead have collider respond as though collidee is semi-static obstacle
+	//   this also happens when both parties are pushResistant
+	pushCollider = pushCollider && (alliedCollision || allowPEU || !collider->blockEnemyPushing);
+	pushCollidee = pushCollidee && (alliedCollision || allowPEU || !collidee->blockEnemyPushing);
+	pushCollider = pushCollider && (!collider->beingBuilt && !collider->UsingScriptMoveType() && !collider->moveType->IsPushResistant());
+	pushCollidee = pushCollidee && (!collidee->beingBuilt && !collidee->UsingScriptMoveType() && !collidee->moveType->IsPushResistant());
+
+	if ((!collideeMobile && !collideeUD->IsAirUnit()) || (!pushCollider && !pushCollidee)) {
+		// building (always axis-aligned, possibly has a yardmap)
+		// or semi-static collidee that should be handled as such
+		//
+		// since all push-resistant units use the BLOCK_STRUCTURE
+		// mask when stopped, avoid the yardmap || terrain branch
+		// of HSOC which is not well suited to both parties moving
+		// and can leave them inside stuck each other's footprints
+		const bool allowNewPath = (!atEndOfPath && !atGoal);
+		const bool checkYardMap = ((pushCollider || pushCollidee) || collideeUD->IsFactoryUnit());
+
+		if (HandleStaticObjectCollision(collider, collidee, colliderMD,  colliderParams.y, collideeParams.y,  separationVect, allowNewPath, checkYardMap, false))
+			ReRequestPath(false);
+
+		return;
+	}
+
+
+	const float colliderRelRadius = colliderParams.y / (colliderParams.y + collideeParams.y);
+	const float collideeRelRadius = collideeParams.y / (colliderParams.y + collideeParams.y);
+	const float collisionRadiusSum = allowUCO?
+		(colliderParams.y * colliderRelRadius + collideeParams.y * collideeRelRadius):
+		(colliderParams.y                     + collideeParams.y                    );
+
+	const float  sepDistance = separationVect.Length() + 0.1f;
+	const float  penDistance = std::max(collisionRadiusSum - sepDistance, 1.0f);
+	const float  sepResponse = std::min(SQUARE_SIZE * 2.0f, penDistance * 0.5f);
+
+	const float3 sepDirection   = separationVect / sepDistance;
+	const float3 colResponseVec = sepDirection * XZVector * sepResponse;
+
+	const float
+		m1 = collider->mass,
+		m2 = collidee->mass,
+		v1 = std::max(1.0f, colliderParams.x),
+		v2 = std::max(1.0f, collideeParams.x),
+		c1 = 1.0f + (1.0f - math::fabs(collider->frontdir.dot(-sepDirection))) * 5.0f,
+		c2 = 1.0f + (1.0f - math::fabs(collidee->frontdir.dot( sepDirection))) * 5.0f,
+		// weighted momenta
+		s1 = m1 * v1 * c1,
+		s2 = m2 * v2 * c2,
+		// relative momenta
+ 		r1 = s1 / (s1 + s2 + 1.0f),
+ 		r2 = s2 / (s1 + s2 + 1.0f);
+
+	// far from a realistic treatment, but works
+	const float colliderMassScale = Clamp(1.0f - r1, 0.01f, 0.99f) * (allowUCO? (1.0f / colliderRelRadius): 1.0f);
+	const float collideeMassScale = Clamp(1.0f - r2, 0.01f, 0.99f) * (allowUCO? (1.0f / collideeRelRadius): 1.0f);
+
+	// try to prevent both parties from being pushed onto non-traversable
+	// squares (without resetting their position which stops them dead in
+	// their tracks and undoes previous legitimate pushes made this frame)
+	//
+	// if pushCollider and pushCollidee are both false (eg. if each party
+	// is pushResistant), treat the collision as regular and push both to
+	// avoid deadlocks
+	const float colliderSlideSign = Sign( separationVect.dot(collider->rightdir));
+	const float collideeSlideSign = Sign(-separationVect.dot(collidee->rightdir));
+
+	const float3 colliderPushVec  =  colResponseVec * colliderMassScale * int(!ignoreCollidee);
+	const float3 collideePushVec  = -colResponseVec * collideeMassScale;
+	const float3 colliderSlideVec = collider->rightdir * colliderSlideSign * (1.0f / penDistance) * r2;
+	const float3 collideeSlideVec = collidee->rightdir * collideeSlideSign * (1.0f / penDistance) * r1;
+	const float3 colliderMoveVec  = colliderPushVec + colliderSlideVec;
+	const float3 collideeMoveVec  = collideePushVec + collideeSlideVec;
+
+	const bool moveCollider = ((pushCollider || !pushCollidee) && colliderMobile);
+	const bool moveCollidee = ((pushCollidee || !pushCollider) && collideeMobile);
+
+	if (moveCollider && colliderMD->TestMoveSquare(collider, collider->pos + colliderMoveVec, colliderMoveVec))
+		collider->Move(colliderMoveVec, true);
+
+	if (moveCollidee && collideeMD->TestMoveSquare(collidee, collidee->pos + collideeMoveVec, collideeMoveVec))
+		collidee->Move(collideeMoveVec, true);
+}
+
+void CGroundMoveType::QueueUnitCollisions(CUnit* collider, const float3& colliderParams)
+{
+	auto& ucp = unitCollisionPass;
+
+	if (ucp.colliderIndices.size() <= static_cast<size_t>(collider->id))
+		ucp.colliderIndices.resize(unitHandler.MaxUnits(), -1);
+	if (ucp.colliderIndices[collider->id] != -1)
+		return;
+
+	ucp.colliderIndices[collider->id] = ucp.colliders.size();
+	ucp.colliders.push_back({this, collider, colliderParams});
+}
+
+void CGroundMoveType::HandleUnitCollisionPass(const std::vector<CUnit*>& units)
+{
+	auto& ucp = unitCollisionPass;
+
+	if (ucp.colliders.empty())
+		return;
+
+	SCOPED_TIMER("Sim::Unit::MoveType::Collisions::Pass");
+
+	const int2 numCells = {
+		std::max(1, (mapDims.mapx * SQUARE_SIZE) / UNIT_COLLISION_CELL_SIZE),
+		std::max(1, (mapDims.mapy * SQUARE_SIZE) / UNIT_COLLISION_CELL_SIZE),
+	};
+	const auto GetCellRange = [&](const float3& pos, float radius, int2& mins, int2& maxs) {
+		mins.x = Clamp(int((pos.x - radius) / UNIT_COLLISION_CELL_SIZE), 0, numCells.x - 1);
+		mins.y = Clamp(int((pos.z - radius) / UNIT_COLLISION_CELL_SIZE), 0, numCells.y - 1);
+		maxs.x = Clamp(int((pos.x + radius) / UNIT_COLLISION_CELL_SIZE), 0, numCells.x - 1);
+		maxs.y = Clamp(int((pos.z + radius) / UNIT_COLLISION_CELL_SIZE), 0, numCells.y - 1);
+	};
+
+	{
+		// bin every potential collidee once; flying units are never
+		// collided with so they only need to be present as colliders
+		ucp.cellOffsets.clear();
+		ucp.cellOffsets.resize(numCells.x * numCells.y + 1, 0);
+
+		int2 mins;
+		int2 maxs;
+
+		for (const CUnit* unit: units) {
+			if (unit->IsFlying())
+				continue;
+
+			GetCellRange(unit->pos, unit->radius, mins, maxs);
+
+			for (int z = mins.y; z <= maxs.y; z++) {
+				for (int x = mins.x; x <= maxs.x; x++) {
+					ucp.cellOffsets[z * numCells.x + x + 1] += 1;
+				}
+			}
 		}
 
+		std::partial_sum(ucp.cellOffsets.begin(), ucp.cellOffsets.end(), ucp.cellOffsets.begin());
 
-		const float colliderRelRadius = colliderParams.y / (colliderParams.y + collideeParams.y);
-		const float collideeRelRadius = collideeParams.y / (colliderParams.y + collideeParams.y);
-		const float collisionRadiusSum = allowUCO?
-			(colliderParams.y * colliderRelRadius + collideeParams.y * collideeRelRadius):
-			(colliderParams.y                     + collideeParams.y                    );
+		ucp.cellCursors.assign(ucp.cellOffsets.begin(), ucp.cellOffsets.end() - 1);
+		ucp.cellUnits.resize(ucp.cellOffsets.back());
 
-		const float  sepDistance = separationVect.Length() + 0.1f;
-		const float  penDistance = std::max(collisionRadiusSum - sepDistance, 1.0f);
-		const float  sepResponse = std::min(SQUARE_SIZE * 2.0f, penDistance * 0.5f);
+		for (CUnit* unit: units) {
+			if (unit->IsFlying())
+				continue;
 
-		const float3 sepDirection   = separationVect / sepDistance;
-		const float3 colResponseVec = sepDirection * XZVector * sepResponse;
+			GetCellRange(unit->pos, unit->radius, mins, maxs);
 
-		const float
-			m1 = collider->mass,
-			m2 = collidee->mass,
-			v1 = std::max(1.0f, colliderParams.x),
-			v2 = std::max(1.0f, collideeParams.x),
-			c1 = 1.0f + (1.0f - math::fabs(collider->frontdir.dot(-sepDirection))) * 5.0f,
-			c2 = 1.0f + (1.0f - math::fabs(collidee->frontdir.dot( sepDirection))) * 5.0f,
-			// weighted momenta
-			s1 = m1 * v1 * c1,
-			s2 = m2 * v2 * c2,
-			// relative momenta
- 			r1 = s1 / (s1 + s2 + 1.0f),
- 			r2 = s2 / (s1 + s2 + 1.0f);
+			for (int z = mins.y; z <= maxs.y; z++) {
+				for (int x = mins.x; x <= maxs.x; x++) {
+					ucp.cellUnits[ucp.cellCursors[z * numCells.x + x]++] = unit;
+				}
+			}
+		}
+	}
 
-		// far from a realistic treatment, but works
-		const float colliderMassScale = Clamp(1.0f - r1, 0.01f, 0.99f) * (allowUCO? (1.0f / colliderRelRadius): 1.0f);
-		const float collideeMassScale = Clamp(1.0f - r2, 0.01f, 0.99f) * (allowUCO? (1.0f / collideeRelRadius): 1.0f);
+	{
+		// gather the collidees each queued unit would have found via
+		// quadField.GetUnitsExact, reading only positions and states
+		if (ucp.candidates.size() < ucp.colliders.size())
+			ucp.candidates.resize(ucp.colliders.size());
 
-		// try to prevent both parties from being pushed onto non-traversable
-		// squares (without resetting their position which stops them dead in
-		// their tracks and undoes previous legitimate pushes made this frame)
-		//
-		// if pushCollider and pushCollidee are both false (eg. if each party
-		// is pushResistant), treat the collision as regular and push both to
-		// avoid deadlocks
-		const float colliderSlideSign = Sign( separationVect.dot(collider->rightdir));
-		const float collideeSlideSign = Sign(-separationVect.dot(collidee->rightdir));
-
-		const float3 colliderPushVec  =  colResponseVec * colliderMassScale * int(!ignoreCollidee);
-		const float3 collideePushVec  = -colResponseVec * collideeMassScale;
-		const float3 colliderSlideVec = collider->rightdir * colliderSlideSign * (1.0f / penDistance) * r2;
-		const float3 collideeSlideVec = collidee->rightdir * collideeSlideSign * (1.0f / penDistance) * r1;
-		const float3 colliderMoveVec  = colliderPushVec + colliderSlideVec;
-		const float3 collideeMoveVec  = collideePushVec + collideeSlideVec;
-
-		const bool moveCollider = ((pushCollider || !pushCollidee) && colliderMobile);
-		const bool moveCollidee = ((pushCollidee || !pushCollider) && collideeMobile);
-
-		if (moveCollider && colliderMD->TestMoveSquare(collider, collider->pos + colliderMoveVec, colliderMoveVec))
-			collider->Move(colliderMoveVec, true);
-
-		if (moveCollidee && collideeMD->TestMoveSquare(collidee, collidee->pos + collideeMoveVec, collideeMoveVec))
-			collidee->Move(collideeMoveVec, true);
+		for_mt(0, ucp.colliders.size(), [&](const int idx) {
+			const QueuedUnitCollider& qc = ucp.colliders[idx];
+			const float queryRadius = qc.params.x + (qc.params.y * 2.0f);
+
+			auto& candidates = ucp.candidates[idx];
+
+			int2 mins;
+			int2 maxs;
+
+			candidates.clear();
+			GetCellRange(qc.unit->pos, queryRadius, mins, maxs);
+
+			for (int z = mins.y; z <= maxs.y; z++) {
+				for (int x = mins.x; x <= maxs.x; x++) {
+					const unsigned int cellIdx = z * numCells.x + x;
+
+					for (unsigned int i = ucp.cellOffsets[cellIdx]; i < ucp.cellOffsets[cellIdx + 1]; i++) {
+						CUnit* collidee = ucp.cellUnits[i];
+
+						if (IgnoreUnitCollidee(qc.unit, collidee))
+							continue;
+						if (qc.unit->pos.SqDistance(collidee->pos) >= Square(queryRadius + collidee->radius))
+							continue;
+
+						candidates.push_back({qc.unit, collidee});
+					}
+				}
+			}
+
+			// units overlapping multiple cells are seen once per cell
+			std::sort(candidates.begin(), candidates.end(), [](const UnitCollisionCandidate& a, const UnitCollisionCandidate& b) {
+				return (a.collidee->id < b.collidee->id);
+			});
+			candidates.erase(std::unique(candidates.begin(), candidates.end(), [](const UnitCollisionCandidate& a, const UnitCollisionCandidate& b) {
+				return (a.collidee == b.collidee);
+			}), candidates.end());
+		});
+	}
+
+	{
+		// merge both sides of each pair; sorting by unit-id makes the
+		// response order independent of thread scheduling
+		const auto GetPairKey = [](const UnitCollisionCandidate& c) {
+			return std::make_tuple(std::min(c.collider->id, c.collidee->id), std::max(c.collider->id, c.collidee->id), c.collider->id);
+		};
+
+		ucp.mergedCandidates.clear();
+		ucp.pairs.clear();
+
+		for (size_t i = 0, n = ucp.colliders.size(); i < n; i++) {
+			ucp.mergedCandidates.insert(ucp.mergedCandidates.end(), ucp.candidates[i].begin(), ucp.candidates[i].end());
+		}
+
+		std::sort(ucp.mergedCandidates.begin(), ucp.mergedCandidates.end(), [&](const UnitCollisionCandidate& a, const UnitCollisionCandidate& b) {
+			return (GetPairKey(a) < GetPairKey(b));
+		});
+
+		for (const UnitCollisionCandidate& c: ucp.mergedCandidates) {
+			if (!ucp.pairs.empty() && ucp.pairs.back().sides[0].collider == c.collidee && ucp.pairs.back().sides[0].collidee == c.collider) {
+				ucp.pairs.back().sides[1] = c;
+				continue;
+			}
+
+			ucp.pairs.push_back({{c, {nullptr, nullptr}}, {false, false}});
+		}
+
+		for_mt(0, ucp.pairs.size(), [&](const int idx) {
+			UnitCollisionPair& pair = ucp.pairs[idx];
+
+			for (int i = 0; i < 2; i++) {
+				const UnitCollisionCandidate& side = pair.sides[i];
+
+				if (side.collider == nullptr)
+					break;
+
+				float2 collideeParams;
+				float4 separationVect;
+
+				pair.colliding[i] = TestUnitCollision(side.collider, side.collidee, ucp.colliders[ucp.colliderIndices[side.collider->id]].params, collideeParams, separationVect);
+			}
+		});
 	}
+
+	for (const UnitCollisionPair& pair: ucp.pairs) {
+		for (int i = 0; i < 2; i++) {
+			const UnitCollisionCandidate& side = pair.sides[i];
+
+			if (side.collider == nullptr)
+				break;
+
+			CUnit* collider = side.collider;
+			CUnit* collidee = side.collidee;
+
+			const QueuedUnitCollider& qc = ucp.colliders[ucp.colliderIndices[collider->id]];
+
+			const bool unloadingCollidee = (collidee->unloadingTransportId == collider->id);
+			const bool unloadingCollider = (collider->unloadingTransportId == collidee->id);
+
+			if (!pair.colliding[i]) {
+				if (unloadingCollidee)
+					collidee->unloadingTransportId = -1;
+				if (unloadingCollider)
+					collider->unloadingTransportId = -1;
+
+				continue;
+			}
+
+			if (unloadingCollidee || unloadingCollider)
+				continue;
+			// Lua may have swapped in a script move-type during an earlier response
+			if (collider->UsingScriptMoveType())
+				continue;
+
+			// positions may have changed through earlier responses
+			float2 collideeParams;
+			float4 separationVect;
+
+			CalcUnitCollisionParams(collider, collidee, qc.params, collideeParams, separationVect);
+
+			qc.moveType->HandleUnitCollisionResponse(collider, collidee, qc.params, collideeParams, separationVect, collider->unitDef, collider->moveDef);
+		}
+	}
+
+	for (const QueuedUnitCollider& qc: ucp.colliders) {
+		ucp.colliderIndices[qc.unit->id] = -1;
+	}
+
+	ucp.colliders.clear();
 }
 
 void CGroundMoveType::HandleFeatureCollisions(
@@ -4,6 +4,7 @@
 #define GROUNDMOVETYPE_H
 
 #include <array>
+#include <vector>
 
 #include "MoveType.h"
 #include "Sim/Path/IPathController.hpp"
@@ -11,6 +12,7 @@
 
 struct UnitDef;
 struct MoveDef;
+struct float4;
 class CSolidObject;
 
 class CGroundMoveType : public AMoveType
@@ -92,6 +94,10 @@ public:
 	const float3& GetGroundNormal(const float3&) const;
 	float GetGroundHeight(const float3&) const;
 
+	/// resolves the unit-unit collisions queued by all ground units this frame
+	/// (only used when modInfo.allowUnitCollisionPass is set)
+	static void HandleUnitCollisionPass(const std::vector<CUnit*>& units);
+
 private:
 	float3 GetObstacleAvoidanceDir(const float3& desiredDir);
 	float3 Here() const;
@@ -136,6 +142,16 @@ private:
 		const UnitDef* colliderUD,
 		const MoveDef* colliderMD
 	);
+	void HandleUnitCollisionResponse(
+		CUnit* collider,
+		CUnit* collidee,
+		const float3& colliderParams,
+		const float2& collideeParams,
+		const float4& separationVect,
+		const UnitDef* colliderUD,
+		const MoveDef* colliderMD
+	);
+	void QueueUnitCollisions(CUnit* collider, const float3& colliderParams);
 	void HandleFeatureCollisions(
 		CUnit* collider,
 		const float3& colliderParams,
@@ -138,6 +138,18 @@ void MoveDefHandler::Init(LuaParser* defsParser)
 	crc << CMoveMath::noHoverWaterMove;
 
 	mdChecksum = crc.GetDigest();
+
+	CMoveMath::InitSpeedModGrids();
+}
+
+void MoveDefHandler::Kill()
+{
+	nameMap.clear(); // never iterated
+
+	mdCounter = 0;
+	mdChecksum = 0;
+
+	CMoveMath::KillSpeedModGrids();
 }
 
 
@@ -159,12 +159,7 @@ class MoveDefHandler
 	CR_DECLARE_STRUCT(MoveDefHandler)
 public:
 	void Init(LuaParser* defsParser);
-	void Kill() {
-		nameMap.clear(); // never iterated
-
-		mdCounter = 0;
-		mdChecksum = 0;
-	}
+	void Kill();
 
 	MoveDef* GetMoveDefByPathType(unsigned int pathType) { return &moveDefs[pathType]; }
 	MoveDef* GetMoveDefByName(const std::string& name);
@@ -6,18 +6,28 @@
 #include "Map/MapInfo.h"
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/GroundBlockingObjectMap.h"
+#include "Sim/Misc/ModInfo.h"
 #include "Sim/MoveTypes/MoveDefHandler.h"
 #include "Sim/MoveTypes/MoveType.h"
 #include "Sim/Objects/SolidObject.h"
 #include "Sim/Units/Unit.h"
 #include "System/Platform/Threading.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 bool CMoveMath::noHoverWaterMove = false;
 float CMoveMath::waterDamageCost = 0.0f;
 
 static constexpr int FOOTPRINT_XSTEP = 2;
 static constexpr int FOOTPRINT_ZSTEP = 2;
 
+// indexed by MoveDef::pathType; MoveDefs that only differ in footprint,
+// crush-strength, etc share a grid (typemap resolution, like the inputs)
+static std::vector<int> speedModGridIndices;
+static std::vector< std::vector<float> > speedModGrids;
+
 
 float CMoveMath::yLevel(const MoveDef& moveDef, int xSqr, int zSqr)
 {
@@ -45,6 +55,77 @@ float CMoveMath::yLevel(const MoveDef& moveDef, const float3& pos)
 
 
 
+static bool EqualSpeedModParams(const MoveDef& a, const MoveDef& b)
+{
+	if (a.speedModClass != b.speedModClass)
+		return false;
+	if (a.depth != b.depth || a.maxSlope != b.maxSlope || a.slopeMod != b.slopeMod)
+		return false;
+
+	return (std::memcmp(&a.depthModParams[0], &b.depthModParams[0], sizeof(a.depthModParams)) == 0);
+}
+
+
+void CMoveMath::InitSpeedModGrids()
+{
+	KillSpeedModGrids();
+
+	speedModGridIndices.resize(moveDefHandler.GetNumMoveDefs(), -1);
+	speedModGrids.reserve(moveDefHandler.GetNumMoveDefs());
+
+	for (unsigned int i = 0; i < moveDefHandler.GetNumMoveDefs(); i++) {
+		const MoveDef* md = moveDefHandler.GetMoveDefByPathType(i);
+
+		for (unsigned int j = 0; j < i; j++) {
+			if (!EqualSpeedModParams(*md, *moveDefHandler.GetMoveDefByPathType(j)))
+				continue;
+
+			speedModGridIndices[i] = speedModGridIndices[j];
+			break;
+		}
+
+		if (speedModGridIndices[i] != -1)
+			continue;
+
+		speedModGridIndices[i] = speedModGrids.size();
+		speedModGrids.emplace_back(mapDims.hmapx * mapDims.hmapy, 0.0f);
+	}
+
+	UpdateSpeedModGrids(0, 0, mapDims.mapxm1, mapDims.mapym1);
+}
+
+void CMoveMath::KillSpeedModGrids()
+{
+	speedModGridIndices.clear();
+	speedModGrids.clear();
+}
+
+void CMoveMath::UpdateSpeedModGrids(int x1, int z1, int x2, int z2)
+{
+	if (speedModGrids.empty())
+		return;
+
+	const int hx1 = std::max(x1 >> 1, 0), hx2 = std::min(x2 >> 1, mapDims.hmapx - 1);
+	const int hz1 = std::max(z1 >> 1, 0), hz2 = std::min(z2 >> 1, mapDims.hmapy - 1);
+
+	for (unsigned int i = 0; i < speedModGridIndices.size(); i++) {
+		const MoveDef& md = *moveDefHandler.GetMoveDefByPathType(i);
+
+		// only the first MoveDef of each group fills its grid
+		if (std::find(speedModGridIndices.begin(), speedModGridIndices.begin() + i, speedModGridIndices[i]) != (speedModGridIndices.begin() + i))
+			continue;
+
+		std::vector<float>& grid = speedModGrids[ speedModGridIndices[i] ];
+
+		for (int hz = hz1; hz <= hz2; hz++) {
+			for (int hx = hx1; hx <= hx2; hx++) {
+				grid[hx + hz * mapDims.hmapx] = CalcPosSpeedMod(md, hx + hz * mapDims.hmapx);
+			}
+		}
+	}
+}
+
+
 /* calculate the local speed-modifier for this MoveDef */
 float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsigned zSquare)
 {
@@ -52,6 +133,16 @@ float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsign
 		return 0.0f;
 
 	const int square = (xSquare >> 1) + ((zSquare >> 1) * mapDims.hmapx);
+
+	// stand-alone MoveDef copies (if any) are not covered by the grids
+	if (moveDef.pathType < speedModGridIndices.size() && &moveDef == moveDefHandler.GetMoveDefByPathType(moveDef.pathType))
+		return speedModGrids[ speedModGridIndices[moveDef.pathType] ][square];
+
+	return (CalcPosSpeedMod(moveDef, square));
+}
+
+float CMoveMath::CalcPosSpeedMod(const MoveDef& moveDef, int square)
+{
 	const int squareTerrType = readMap->GetTypeMapSynced()[square];
 
 	const float height  = readMap->GetMIPHeightMapSynced(1)[square];
@@ -75,6 +166,10 @@ float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsign
 	if (xSquare >= mapDims.mapx || zSquare >= mapDims.mapy)
 		return 0.0f;
 
+	// without directional pathing only ships still care about moveDir
+	if (!modInfo.allowDirectionalPathing && moveDef.speedModClass != MoveDef::Ship)
+		return (GetPosSpeedMod(moveDef, xSquare, zSquare));
+
 	const int square = (xSquare >> 1) + ((zSquare >> 1) * mapDims.hmapx);
 	const int squareTerrType = readMap->GetTypeMapSynced()[square];
 
@@ -121,6 +216,9 @@ CMoveMath::BlockType CMoveMath::IsBlockedNoSpeedModCheck(const MoveDef& moveDef,
 		const int zOffset = z * mapDims.mapx;
 
 		for (int x = xmin; x <= xmax; x += FOOTPRINT_XSTEP) {
+			if (!groundBlockingObjectMap.CellOccupiedUnsafe(zOffset + x))
+				continue;
+
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 
 			for (size_t i = 0, n = cell.size(); i < n; i++) {
@@ -256,6 +354,9 @@ CMoveMath::BlockType CMoveMath::SquareIsBlocked(const MoveDef& moveDef, int xSqu
 
 	BlockType r = BLOCK_NONE;
 
+	if (!groundBlockingObjectMap.CellOccupiedUnsafe(zSquare * mapDims.mapx + xSquare))
+		return r;
+
 	const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zSquare * mapDims.mapx + xSquare);
 
 	for (size_t i = 0, n = cell.size(); i < n; i++) {
@@ -281,6 +382,9 @@ CMoveMath::BlockType CMoveMath::RangeIsBlocked(const MoveDef& moveDef, int xmin,
 		const int zOffset = z * mapDims.mapx;
 
 		for (int x = xmin; x <= xmax; x += FOOTPRINT_XSTEP) {
+			if (!groundBlockingObjectMap.CellOccupiedUnsafe(zOffset + x))
+				continue;
+
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 
 			for (size_t i = 0, n = cell.size(); i < n; i++) {
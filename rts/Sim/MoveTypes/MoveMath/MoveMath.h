@@ -20,6 +20,9 @@ protected:
 	static float ShipSpeedMod(const MoveDef& moveDef, float height, float slope);
 	static float ShipSpeedMod(const MoveDef& moveDef, float height, float slope, float dirSlopeMod);
 
+	// uncached variant of GetPosSpeedMod, <square> is a typemap index
+	static float CalcPosSpeedMod(const MoveDef& moveDef, int square);
+
 public:
 	// gives the y-coordinate the unit will "stand on"
 	static float yLevel(const MoveDef& moveDef, const float3& pos);
@@ -49,6 +52,13 @@ public:
 		return (GetPosSpeedMod(moveDef, pos.x / SQUARE_SIZE, pos.z / SQUARE_SIZE, moveDir));
 	}
 
+	// (re)calculate the cached per-square speed-modifiers (one grid per group of
+	// MoveDefs with equal speed-mod parameters) read by the non-directional
+	// GetPosSpeedMod; the update rectangle is inclusive and in heightmap squares
+	static void InitSpeedModGrids();
+	static void KillSpeedModGrids();
+	static void UpdateSpeedModGrids(int x1, int z1, int x2, int z2);
+
 	// tells whether a position is blocked (inaccessable for a given object's MoveDef)
 	static inline BlockType IsBlocked(const MoveDef& moveDef, const float3& pos, const CSolidObject* collider);
 	static inline BlockType IsBlocked(const MoveDef& moveDef, int xSquare, int zSquare, const CSolidObject* collider);
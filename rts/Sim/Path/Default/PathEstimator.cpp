@@ -2,8 +2,8 @@
 
 #include "System/Platform/Win/win32.h"
 
-#include "zlib.h"
-#include "minizip/zip.h"
+#include <cstdio>
+#include <fstream>
 
 #include "PathEstimator.h"
 #include "PathFinder.h"
@@ -21,11 +21,10 @@
 #include "System/Threading/ThreadPool.h" // for_mt
 #include "System/TimeProfiler.h"
 #include "System/Config/ConfigHandler.h"
-#include "System/FileSystem/Archives/IArchive.h"
-#include "System/FileSystem/ArchiveLoader.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/MemoryMappedFile.h"
 #include "System/Platform/Threading.h"
 #include "System/SafeUtil.h"
 #include "System/StringUtil.h"
@@ -45,7 +44,32 @@ static const std::string GetPathCacheDir() {
 }
 
 static const std::string GetCacheFileName(const std::string& fileHashCode, const std::string& peFileName, const std::string& mapFileName) {
-	return (GetPathCacheDir() + mapFileName + "." + peFileName + "-" + fileHashCode + ".zip");
+	return (GetPathCacheDir() + mapFileName + "." + peFileName + "-" + fileHashCode + ".pecache");
+}
+
+
+// cache-files are stored uncompressed and memory-mapped when read; each
+// section starts on a page boundary so it can be faulted in by itself
+static constexpr std::uint64_t PE_CACHE_PAGE_SIZE = 4096;
+static constexpr char PE_CACHE_MAGIC[8] = {'S', 'P', 'R', 'I', 'N', 'G', 'P', 'E'};
+
+struct PECacheFileHeader {
+	char magic[8];
+
+	std::uint32_t version;
+	std::uint32_t hashCode;
+	std::uint32_t blockSize;
+	std::uint32_t numPathTypes;
+	std::uint32_t numBlocks;
+	std::uint32_t numVertexCosts;
+
+	std::uint64_t offsetsBegin;
+	std::uint64_t costsBegin;
+	std::uint64_t fileSize;
+};
+
+static std::uint64_t AlignToPage(std::uint64_t n) {
+	return ((n + PE_CACHE_PAGE_SIZE - 1) & ~(PE_CACHE_PAGE_SIZE - 1));
 }
 
 
@@ -949,57 +973,57 @@ bool CPathEstimator::ReadFile(const std::string& peFileName, const std::string&
 	if (!FileSystem::FileExists(cacheFileName))
 		return false;
 
-	std::unique_ptr<IArchive> upfile(archiveLoader.OpenArchive(dataDirsAccess.LocateFile(cacheFileName), "sdz"));
+	// the mapping must be closed before a bad file can be removed (Windows
+	// refuses to delete mapped files), so it only lives inside ReadMapping
+	if (ReadMapping(cacheFileName))
+		return true;
+
+	FileSystem::Remove(cacheFileName);
+	return false;
+}
+
+/**
+ * Map the cache-file and copy its data, return false if it is invalid
+ */
+bool CPathEstimator::ReadMapping(const std::string& cacheFileName)
+{
+	CMemoryMappedFile file(dataDirsAccess.LocateFile(cacheFileName));
 
-	if (upfile == nullptr || !upfile->IsOpen()) {
-		FileSystem::Remove(cacheFileName);
+	if (!file.IsOpen() || file.GetSize() < sizeof(PECacheFileHeader))
 		return false;
-	}
 
 	char calcMsg[512];
 	sprintf(calcMsg, "Reading Estimate PathCosts [%d]", BLOCK_SIZE);
 	loadscreen->SetLoadMessage(calcMsg);
 
-	const unsigned fid = upfile->FindFile("pathinfo");
-	if (fid >= upfile->NumFiles()) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	std::vector<std::uint8_t> buffer;
+	PECacheFileHeader header;
+	std::memcpy(&header, file.GetData(), sizeof(header));
 
-	if (!upfile->GetFile(fid, buffer) || buffer.size() < 4) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
+	const std::uint64_t offsetsSize = blockStates.GetSize() * sizeof(short2);
+	const std::uint64_t costsSize = vertexCosts.size() * sizeof(float);
 
-	const unsigned int filehash = *(reinterpret_cast<unsigned int*>(&buffer[0]));
-	const unsigned int blockSize = blockStates.GetSize() * sizeof(short2);
-	unsigned int pos = sizeof(unsigned);
+	bool valid = true;
 
-	if (filehash != fileHashCode) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
+	valid &= (std::memcmp(header.magic, PE_CACHE_MAGIC, sizeof(PE_CACHE_MAGIC)) == 0);
+	valid &= (header.version == PATHESTIMATOR_VERSION);
+	valid &= (header.hashCode == fileHashCode);
+	valid &= (header.blockSize == BLOCK_SIZE);
+	valid &= (header.numPathTypes == moveDefHandler.GetNumMoveDefs());
+	valid &= (header.numBlocks == blockStates.GetSize());
+	valid &= (header.numVertexCosts == vertexCosts.size());
+	valid &= (header.fileSize == file.GetSize());
+	valid &= (header.offsetsBegin >= sizeof(header) && (header.offsetsBegin + offsetsSize * header.numPathTypes) <= header.costsBegin);
+	valid &= ((header.costsBegin + costsSize) <= header.fileSize);
 
-	if (buffer.size() < (pos + blockSize * moveDefHandler.GetNumMoveDefs())) {
-		FileSystem::Remove(cacheFileName);
+	if (!valid)
 		return false;
-	}
 
-	// read center-offset data
-	for (int pathType = 0; pathType < moveDefHandler.GetNumMoveDefs(); ++pathType) {
-		std::memcpy(&blockStates.peNodeOffsets[pathType][0], &buffer[pos], blockSize);
-		pos += blockSize;
-	}
-
-	// read vertex-cost data
-	if (buffer.size() < (pos + vertexCosts.size() * sizeof(float))) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
+	// pages are faulted in by the copies, which run concurrently per path-type
+	for_mt(0, moveDefHandler.GetNumMoveDefs(), [&](const int pathType) {
+		std::memcpy(blockStates.peNodeOffsets[pathType].data(), file.GetData() + header.offsetsBegin + offsetsSize * pathType, offsetsSize);
+		std::memcpy(&vertexCosts[pathType * blockStates.GetSize() * PATH_DIRECTION_VERTICES], file.GetData() + header.costsBegin + (costsSize / header.numPathTypes) * pathType, costsSize / header.numPathTypes);
+	});
 
-	std::memcpy(&vertexCosts[0], &buffer[pos], vertexCosts.size() * sizeof(float));
 	return true;
 }
 
@@ -1015,81 +1039,118 @@ bool CPathEstimator::WriteFile(const std::string& peFileName, const std::string&
 
 	const std::string hashHexString = IntToString(fileHashCode, "%x");
 	const std::string cacheFileName = GetCacheFileName(hashHexString, peFileName, mapFileName);
+	const std::string cacheFilePath = dataDirsAccess.LocateFile(cacheFileName, FileQueryFlags::WRITE);
+	// written under a temporary name and renamed when complete, such that
+	// other processes never see a partial file under the final name
+	const std::string tempFilePath = cacheFilePath + ".tmp";
 
 	LOG("[PathEstimator::%s] hash=%s file=\"%s\" (exists=%d)", __func__, hashHexString.c_str(), cacheFileName.c_str(), FileSystem::FileExists(cacheFileName));
 
-	// open file for writing in a suitable location
-	zipFile file = zipOpen(dataDirsAccess.LocateFile(cacheFileName, FileQueryFlags::WRITE).c_str(), APPEND_STATUS_CREATE);
+	const std::uint64_t offsetsSize = blockStates.GetSize() * sizeof(short2) * moveDefHandler.GetNumMoveDefs();
+	const std::uint64_t costsSize = vertexCosts.size() * sizeof(float);
 
-	if (file == nullptr)
-		return false;
+	PECacheFileHeader header;
 
-	zipOpenNewFileInZip(file, "pathinfo", nullptr, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_BEST_COMPRESSION);
+	std::memcpy(header.magic, PE_CACHE_MAGIC, sizeof(PE_CACHE_MAGIC));
 
-	// write hash-code (NOTE: this also affects the CRC!)
-	zipWriteInFileInZip(file, (const void*) &fileHashCode, 4);
+	header.version = PATHESTIMATOR_VERSION;
+	header.hashCode = fileHashCode;
+	header.blockSize = BLOCK_SIZE;
+	header.numPathTypes = moveDefHandler.GetNumMoveDefs();
+	header.numBlocks = blockStates.GetSize();
+	header.numVertexCosts = vertexCosts.size();
+	header.offsetsBegin = AlignToPage(sizeof(header));
+	header.costsBegin = AlignToPage(header.offsetsBegin + offsetsSize);
+	header.fileSize = header.costsBegin + costsSize;
 
-	// write center-offsets
-	for (int pathType = 0; pathType < moveDefHandler.GetNumMoveDefs(); ++pathType) {
-		zipWriteInFileInZip(file, (const void*) &blockStates.peNodeOffsets[pathType][0], blockStates.peNodeOffsets[pathType].size() * sizeof(short2));
-	}
+	{
+		std::ofstream file(tempFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
 
-	// write vertex-costs
-	zipWriteInFileInZip(file, vertexCosts.data(), vertexCosts.size() * sizeof(float));
+		if (!file.is_open())
+			return false;
+
+		const std::vector<char> padding(PE_CACHE_PAGE_SIZE, 0);
 
-	zipCloseFileInZip(file);
-	zipClose(file, nullptr);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(padding.data(), header.offsetsBegin - sizeof(header));
 
+		// write center-offsets
+		for (int pathType = 0; pathType < moveDefHandler.GetNumMoveDefs(); ++pathType) {
+			file.write(reinterpret_cast<const char*>(blockStates.peNodeOffsets[pathType].data()), blockStates.peNodeOffsets[pathType].size() * sizeof(short2));
+		}
+
+		file.write(padding.data(), header.costsBegin - (header.offsetsBegin + offsetsSize));
+
+		// write vertex-costs
+		file.write(reinterpret_cast<const char*>(vertexCosts.data()), costsSize);
+
+		if (!file.good()) {
+			file.close();
+			std::remove(tempFilePath.c_str());
+			return false;
+		}
+	}
 
-	// get the CRC over the written path data
-	std::unique_ptr<IArchive> upfile(archiveLoader.OpenArchive(dataDirsAccess.LocateFile(cacheFileName), "sdz"));
+	FileSystem::Remove(cacheFileName);
 
-	if (upfile == nullptr || !upfile->IsOpen()) {
-		FileSystem::Remove(cacheFileName);
+	if (std::rename(tempFilePath.c_str(), cacheFilePath.c_str()) != 0) {
+		std::remove(tempFilePath.c_str());
 		return false;
 	}
 
-	assert(upfile->FindFile("pathinfo") < upfile->NumFiles());
-  return true;
+	// zip-compressed caches written by older versions are never read again
+	for (const std::string& zipFileName: dataDirsAccess.FindFiles(GetPathCacheDir(), mapFileName + "." + peFileName + "-*.zip")) {
+		FileSystem::Remove(zipFileName);
+	}
+
+	return true;
 }
 
 
 std::uint32_t CPathEstimator::CalcChecksum() const
 {
 	std::uint32_t chksum = 0;
-	std::uint64_t nbytes = vertexCosts.size() * sizeof(float);
-	std::uint64_t offset = 0;
 
 	#if (ENABLE_NETLOG_CHECKSUM == 1)
 	std::array<char, 128 + sha512::SHA_LEN * 2 + 1> msgBuffer;
 
 	sha512::hex_digest hexChars;
 	sha512::raw_digest shaBytes;
-	sha512::msg_vector rawBytes;
+	sha512::msg_vector digestBytes;
 	#endif
 
 	#if (ENABLE_NETLOG_CHECKSUM == 1)
-	for (const auto& pathTypeOffsets: blockStates.peNodeOffsets) {
-		nbytes += (pathTypeOffsets.size() * sizeof(short2));
-	}
+	{
+		// hash(hash(offsets[0]|costs[0])|...|hash(offsets[N-1]|costs[N-1]))
+		// each path-type's data is hashed in place and concurrently
+		const size_t numPathTypes = blockStates.peNodeOffsets.size();
+		const size_t numTypeCosts = blockStates.GetSize() * PATH_DIRECTION_VERTICES;
 
-	rawBytes.clear();
-	rawBytes.resize(nbytes);
+		std::vector<sha512::raw_digest> typeDigests(numPathTypes);
 
-	for (const auto& pathTypeOffsets: blockStates.peNodeOffsets) {
-		nbytes = pathTypeOffsets.size() * sizeof(short2);
-		offset += nbytes;
+		for_mt(0, numPathTypes, [&](const int pathType) {
+			const auto& typeOffsets = blockStates.peNodeOffsets[pathType];
 
-		std::memcpy(&rawBytes[offset - nbytes], pathTypeOffsets.data(), nbytes);
-	}
+			sha512::raw_digest offsetsDigest;
+			sha512::raw_digest costsDigest;
 
-	{
-		nbytes = vertexCosts.size() * sizeof(float);
-		offset += nbytes;
+			sha512::calc_digest(reinterpret_cast<const uint8_t*>(typeOffsets.data()), typeOffsets.size() * sizeof(short2), offsetsDigest.data());
+			sha512::calc_digest(reinterpret_cast<const uint8_t*>(&vertexCosts[pathType * numTypeCosts]), numTypeCosts * sizeof(float), costsDigest.data());
+
+			std::array<uint8_t, sha512::SHA_LEN * 2> pairBytes;
+			std::memcpy(&pairBytes[              0], offsetsDigest.data(), sha512::SHA_LEN);
+			std::memcpy(&pairBytes[sha512::SHA_LEN], costsDigest.data(), sha512::SHA_LEN);
+
+			sha512::calc_digest(pairBytes.data(), pairBytes.size(), typeDigests[pathType].data());
+		});
+
+		digestBytes.resize(numPathTypes * sha512::SHA_LEN);
 
-		std::memcpy(&rawBytes[offset - nbytes], vertexCosts.data(), nbytes);
+		for (size_t pathType = 0; pathType < numPathTypes; pathType++) {
+			std::memcpy(&digestBytes[pathType * sha512::SHA_LEN], typeDigests[pathType].data(), sha512::SHA_LEN);
+		}
 
-		sha512::calc_digest(rawBytes, shaBytes); // hash(offsets|costs)
+		sha512::calc_digest(digestBytes, shaBytes); // hash(hashes)
 		sha512::dump_digest(shaBytes, hexChars); // hexify(hash)
 
 		SNPRINTF(msgBuffer.data(), msgBuffer.size(), "[PE::%s][BLK_SIZE=%d][SHA_DATA=%s]", __func__, BLOCK_SIZE, hexChars.data());
@@ -119,6 +119,7 @@ private:
 	void CalcVertexPathCost(const MoveDef&, int2, unsigned int pathDir, unsigned int threadNum = 0);
 
 	bool ReadFile(const std::string& peFileName, const std::string& mapFileName);
+	bool ReadMapping(const std::string& cacheFileName);
 	bool WriteFile(const std::string& peFileName, const std::string& mapFileName);
 
 	std::uint32_t CalcChecksum() const;
@@ -225,8 +225,11 @@ void QTPFS::QTNode::Init(
 
 	prevNode = nullptr;
 
-	neighbors.clear();
-	netpoints.clear();
+	poolIndex = -1u;
+	ngbsBegin = 0;
+	ngbsCount = 0;
+
+	netPoint = {0.0f, 0.0f};
 }
 
 
@@ -234,10 +237,8 @@ void QTPFS::QTNode::Init(
 std::uint64_t QTPFS::QTNode::GetMemFootPrint(const NodeLayer& nl) const {
 	std::uint64_t memFootPrint = sizeof(QTNode);
 
-	if (IsLeaf()) {
-		memFootPrint += (neighbors.size() * sizeof(decltype(neighbors)::value_type));
-		memFootPrint += (netpoints.size() * sizeof(decltype(netpoints)::value_type));
-	} else {
+	// neighbor caches are accounted for by NodeLayer
+	if (!IsLeaf()) {
 		for (unsigned int i = 0; i < QTNODE_CHILD_COUNT; i++) {
 			memFootPrint += (nl.GetPoolNode(childBaseIndex + i)->GetMemFootPrint(nl));
 		}
@@ -330,8 +331,8 @@ bool QTPFS::QTNode::Split(NodeLayer& nl, unsigned int depth, bool forced) {
 
 	childBaseIndex = childIndices[0];
 
-	neighbors.clear();
-	netpoints.clear();
+	// range becomes garbage, reclaimed by NodeLayer::CompactNodeNeighbors
+	ngbsCount = 0;
 
 	nl.SetNumLeafNodes(nl.GetNumLeafNodes() + (4 - 1));
 	assert(!IsLeaf());
@@ -342,8 +343,7 @@ bool QTPFS::QTNode::Merge(NodeLayer& nl) {
 	if (IsLeaf())
 		return false;
 
-	neighbors.clear();
-	// netpoints.clear();
+	ngbsCount = 0;
 
 	// get rid of our children completely
 	for (unsigned int i = 0; i < QTNODE_CHILD_COUNT; i++) {
@@ -679,34 +679,28 @@ void QTPFS::QTNode::Serialize(std::fstream& fStream, NodeLayer& nodeLayer, unsig
 	}
 }
 
-unsigned int QTPFS::QTNode::GetNeighbors(const std::vector<INode*>& nodes, std::vector<INode*>& ngbs) {
-	#ifdef QTPFS_CONSERVATIVE_NEIGHBOR_CACHE_UPDATES
-	UpdateNeighborCache(nodes);
-	#endif
+// this is *either* called from PathSearch::IterateNodes when the conservative
+// update-scheme is enabled, *or* from PM::ExecQueuedNodeLayerUpdates
+// (never both)
+bool QTPFS::QTNode::UpdateNeighborCache(NodeLayer& nl) {
+	const std::vector<INode*>& nodes = nl.GetNodes();
 
-	if (!neighbors.empty()) {
-		ngbs.clear();
-		ngbs.resize(neighbors.size());
+	std::vector<unsigned int>& ngbIndcs = nl.GetNodeNeighbors();
+	std::vector<float2>& ngbPoints = nl.GetNodeNetPoints();
 
-		std::copy(neighbors.begin(), neighbors.end(), ngbs.begin());
-	}
+	assert(IsLeaf());
+	assert(!nodes.empty());
 
-	return (neighbors.size());
-}
+	// a regenerated list is appended, the old range becomes garbage
+	const auto AddNeighbor = [&](const INode* ngb) {
+		assert(ngb->GetPoolIndex() != -1u);
 
-const std::vector<QTPFS::INode*>& QTPFS::QTNode::GetNeighbors(const std::vector<INode*>& nodes) {
-	#ifdef QTPFS_CONSERVATIVE_NEIGHBOR_CACHE_UPDATES
-	UpdateNeighborCache(nodes);
-	#endif
-	return neighbors;
-}
+		ngbIndcs.push_back(ngb->GetPoolIndex());
 
-// this is *either* called from ::GetNeighbors when the conservative
-// update-scheme is enabled, *or* from PM::ExecQueuedNodeLayerUpdates
-// (never both)
-bool QTPFS::QTNode::UpdateNeighborCache(const std::vector<INode*>& nodes) {
-	assert(IsLeaf());
-	assert(!nodes.empty());
+		for (unsigned int i = 0; i < QTPFS_MAX_NETPOINTS_PER_NODE_EDGE; i++) {
+			ngbPoints.push_back(INode::GetNeighborEdgeTransitionPoint(ngb, {}, QTPFS_NETPOINT_EDGE_SPACING_SCALE * (i + 1)));
+		}
+	};
 
 	if (prevMagicNum != currMagicNum) {
 		prevMagicNum = currMagicNum;
@@ -714,18 +708,13 @@ bool QTPFS::QTNode::UpdateNeighborCache(const std::vector<INode*>& nodes) {
 		unsigned int ngbRels = 0;
 		unsigned int maxNgbs = GetMaxNumNeighbors();
 
+		ngbsBegin = ngbIndcs.size();
+		ngbsCount = 0;
+
 		// regenerate our neighbor cache
+		// NOTE: caching ETP's breaks QTPFS_ORTHOPROJECTED_EDGE_TRANSITIONS
 		if (maxNgbs > 0) {
-			neighbors.clear();
-			neighbors.reserve(maxNgbs + 4);
-
-			netpoints.clear();
-			netpoints.reserve(1 + maxNgbs * QTPFS_MAX_NETPOINTS_PER_NODE_EDGE + 4);
-			// NOTE: caching ETP's breaks QTPFS_ORTHOPROJECTED_EDGE_TRANSITIONS
-			// NOTE: [0] is a reserved index and must always be valid
-			netpoints.emplace_back();
-
-			INode* ngb = nullptr;
+			const INode* ngb = nullptr;
 
 			if (xmin() > 0) {
 				const unsigned int hmx = xmin() - 1;
@@ -735,11 +724,7 @@ bool QTPFS::QTNode::UpdateNeighborCache(const std::vector<INode*>& nodes) {
 					ngb = nodes[hmz * mapDims.mapx + hmx];
 					hmz = ngb->zmax();
 
-					neighbors.push_back(ngb);
-
-					for (unsigned int i = 0; i < QTPFS_MAX_NETPOINTS_PER_NODE_EDGE; i++) {
-						netpoints.push_back(INode::GetNeighborEdgeTransitionPoint(ngb, {}, QTPFS_NETPOINT_EDGE_SPACING_SCALE * (i + 1)));
-					}
+					AddNeighbor(ngb);
 				}
 
 				ngbRels |= REL_NGB_EDGE_L;
@@ -752,11 +737,7 @@ bool QTPFS::QTNode::UpdateNeighborCache(const std::vector<INode*>& nodes) {
 					ngb = nodes[hmz * mapDims.mapx + hmx];
 					hmz = ngb->zmax();
 
-					neighbors.push_back(ngb);
-
-					for (unsigned int i = 0; i < QTPFS_MAX_NETPOINTS_PER_NODE_EDGE; i++) {
-						netpoints.push_back(INode::GetNeighborEdgeTransitionPoint(ngb, {}, QTPFS_NETPOINT_EDGE_SPACING_SCALE * (i + 1)));
-					}
+					AddNeighbor(ngb);
 				}
 
 				ngbRels |= REL_NGB_EDGE_R;
@@ -770,11 +751,7 @@ bool QTPFS::QTNode::UpdateNeighborCache(const std::vector<INode*>& nodes) {
 					ngb = nodes[hmz * mapDims.mapx + hmx];
 					hmx = ngb->xmax();
 
-					neighbors.push_back(ngb);
-
-					for (unsigned int i = 0; i < QTPFS_MAX_NETPOINTS_PER_NODE_EDGE; i++) {
-						netpoints.push_back(INode::GetNeighborEdgeTransitionPoint(ngb, {}, QTPFS_NETPOINT_EDGE_SPACING_SCALE * (i + 1)));
-					}
+					AddNeighbor(ngb);
 				}
 
 				ngbRels |= REL_NGB_EDGE_T;
@@ -787,11 +764,7 @@ bool QTPFS::QTNode::UpdateNeighborCache(const std::vector<INode*>& nodes) {
 					ngb = nodes[hmz * mapDims.mapx + hmx];
 					hmx = ngb->xmax();
 
-					neighbors.push_back(ngb);
-
-					for (unsigned int i = 0; i < QTPFS_MAX_NETPOINTS_PER_NODE_EDGE; i++) {
-						netpoints.push_back(INode::GetNeighborEdgeTransitionPoint(ngb, {}, QTPFS_NETPOINT_EDGE_SPACING_SCALE * (i + 1)));
-					}
+					AddNeighbor(ngb);
 				}
 
 				ngbRels |= REL_NGB_EDGE_B;
@@ -803,32 +776,24 @@ bool QTPFS::QTNode::UpdateNeighborCache(const std::vector<INode*>& nodes) {
 				if ((ngbRels & REL_NGB_EDGE_T) != 0) {
 					const INode* ngbL = nodes[(zmin() + 0) * mapDims.mapx + (xmin() - 1)];
 					const INode* ngbT = nodes[(zmin() - 1) * mapDims.mapx + (xmin() + 0)];
-						  INode* ngbC = nodes[(zmin() - 1) * mapDims.mapx + (xmin() - 1)];
+					const INode* ngbC = nodes[(zmin() - 1) * mapDims.mapx + (xmin() - 1)];
 
 					// VERT_TL ngb must be distinct from EDGE_L and EDGE_T ngbs
 					if (ngbC != ngbL && ngbC != ngbT) {
 						if (ngbL->AllSquaresAccessible() && ngbT->AllSquaresAccessible()) {
-							neighbors.push_back(ngbC);
-
-							for (unsigned int i = 0; i < QTPFS_MAX_NETPOINTS_PER_NODE_EDGE; i++) {
-								netpoints.push_back(INode::GetNeighborEdgeTransitionPoint(ngbC, {}, QTPFS_NETPOINT_EDGE_SPACING_SCALE * (i + 1)));
-							}
+							AddNeighbor(ngbC);
 						}
 					}
 				}
 				if ((ngbRels & REL_NGB_EDGE_B) != 0) {
 					const INode* ngbL = nodes[(zmax() - 1) * mapDims.mapx + (xmin() - 1)];
 					const INode* ngbB = nodes[(zmax() + 0) * mapDims.mapx + (xmin() + 0)];
-						  INode* ngbC = nodes[(zmax() + 0) * mapDims.mapx + (xmin() - 1)];
+					const INode* ngbC = nodes[(zmax() + 0) * mapDims.mapx + (xmin() - 1)];
 
 					// VERT_BL ngb must be distinct from EDGE_L and EDGE_B ngbs
 					if (ngbC != ngbL && ngbC != ngbB) {
 						if (ngbL->AllSquaresAccessible() && ngbB->AllSquaresAccessible()) {
-							neighbors.push_back(ngbC);
-
-							for (unsigned int i = 0; i < QTPFS_MAX_NETPOINTS_PER_NODE_EDGE; i++) {
-								netpoints.push_back(INode::GetNeighborEdgeTransitionPoint(ngbC, {}, QTPFS_NETPOINT_EDGE_SPACING_SCALE * (i + 1)));
-							}
+							AddNeighbor(ngbC);
 						}
 					}
 				}
@@ -839,32 +804,24 @@ bool QTPFS::QTNode::UpdateNeighborCache(const std::vector<INode*>& nodes) {
 				if ((ngbRels & REL_NGB_EDGE_T) != 0) {
 					const INode* ngbR = nodes[(zmin() + 0) * mapDims.mapx + (xmax() + 0)];
 					const INode* ngbT = nodes[(zmin() - 1) * mapDims.mapx + (xmax() - 1)];
-						  INode* ngbC = nodes[(zmin() - 1) * mapDims.mapx + (xmax() + 0)];
+					const INode* ngbC = nodes[(zmin() - 1) * mapDims.mapx + (xmax() + 0)];
 
 					// VERT_TR ngb must be distinct from EDGE_R and EDGE_T ngbs
 					if (ngbC != ngbR && ngbC != ngbT) {
 						if (ngbR->AllSquaresAccessible() && ngbT->AllSquaresAccessible()) {
-							neighbors.push_back(ngbC);
-
-							for (unsigned int i = 0; i < QTPFS_MAX_NETPOINTS_PER_NODE_EDGE; i++) {
-								netpoints.push_back(INode::GetNeighborEdgeTransitionPoint(ngbC, {}, QTPFS_NETPOINT_EDGE_SPACING_SCALE * (i + 1)));
-							}
+							AddNeighbor(ngbC);
 						}
 					}
 				}
 				if ((ngbRels & REL_NGB_EDGE_B) != 0) {
 					const INode* ngbR = nodes[(zmax() - 1) * mapDims.mapx + (xmax() + 0)];
 					const INode* ngbB = nodes[(zmax() + 0) * mapDims.mapx + (xmax() - 1)];
-						  INode* ngbC = nodes[(zmax() + 0) * mapDims.mapx + (xmax() + 0)];
+					const INode* ngbC = nodes[(zmax() + 0) * mapDims.mapx + (xmax() + 0)];
 
 					// VERT_BR ngb must be distinct from EDGE_R and EDGE_B ngbs
 					if (ngbC != ngbR && ngbC != ngbB) {
 						if (ngbR->AllSquaresAccessible() && ngbB->AllSquaresAccessible()) {
-							neighbors.push_back(ngbC);
-
-							for (unsigned int i = 0; i < QTPFS_MAX_NETPOINTS_PER_NODE_EDGE; i++) {
-								netpoints.push_back(INode::GetNeighborEdgeTransitionPoint(ngbC, {}, QTPFS_NETPOINT_EDGE_SPACING_SCALE * (i + 1)));
-							}
+							AddNeighbor(ngbC);
 						}
 					}
 				}
@@ -872,6 +829,7 @@ bool QTPFS::QTNode::UpdateNeighborCache(const std::vector<INode*>& nodes) {
 			#endif
 		}
 
+		ngbsCount = ngbIndcs.size() - ngbsBegin;
 		return true;
 	}
 
@@ -38,12 +38,14 @@ namespace QTPFS {
 
 		#ifdef QTPFS_VIRTUAL_NODE_FUNCTIONS
 		virtual void Serialize(std::fstream&, NodeLayer&, unsigned int*, unsigned int, bool) = 0;
-		virtual unsigned int GetNeighbors(const std::vector<INode*>&, std::vector<INode*>&) = 0;
-		virtual const std::vector<INode*>& GetNeighbors(const std::vector<INode*>& v) = 0;
-		virtual bool UpdateNeighborCache(const std::vector<INode*>& nodes) = 0;
+		virtual bool UpdateNeighborCache(NodeLayer& nl) = 0;
 
-		virtual void SetNeighborEdgeTransitionPoint(unsigned int ngbIdx, const float2& point) = 0;
-		virtual const float2& GetNeighborEdgeTransitionPoint(unsigned int ngbIdx) const = 0;
+		virtual unsigned int GetNeighborsBegin() const = 0;
+		virtual unsigned int GetNumNeighbors() const = 0;
+		virtual unsigned int GetPoolIndex() const = 0;
+
+		virtual void SetNetPoint(const float2& point) = 0;
+		virtual const float2& GetNetPoint() const = 0;
 		#endif
 
 		unsigned int GetNeighborRelation(const INode* ngb) const;
@@ -145,12 +147,19 @@ namespace QTPFS {
 		bool Merge(NodeLayer& nl);
 
 		unsigned int GetMaxNumNeighbors() const;
-		unsigned int GetNeighbors(const std::vector<INode*>&, std::vector<INode*>&);
-		const std::vector<INode*>& GetNeighbors(const std::vector<INode*>&);
-		bool UpdateNeighborCache(const std::vector<INode*>& nodes);
+		bool UpdateNeighborCache(NodeLayer& nl);
+
+		// this leaf's range in NodeLayer::{nodeNeighbors,nodeNetPoints}
+		void SetNeighbors(unsigned int begin, unsigned int count) { ngbsBegin = begin; ngbsCount = count; }
+		unsigned int GetNeighborsBegin() const { return ngbsBegin; }
+		unsigned int GetNumNeighbors() const { return ngbsCount; }
 
-		void SetNeighborEdgeTransitionPoint(unsigned int ngbIdx, const float2& point) { netpoints[ngbIdx] = point; }
-		const float2& GetNeighborEdgeTransitionPoint(unsigned int ngbIdx) const { return netpoints[ngbIdx]; }
+		void SetPoolIndex(unsigned int i) { poolIndex = i; }
+		unsigned int GetPoolIndex() const { return poolIndex; }
+
+		// transition-point through which the current search entered us
+		void SetNetPoint(const float2& point) { netPoint = point; }
+		const float2& GetNetPoint() const { return netPoint; }
 
 		unsigned int xmin() const { return (_xminxmax  & 0xFFFF); }
 		unsigned int zmin() const { return (_zminzmax  & 0xFFFF); }
@@ -206,9 +215,13 @@ namespace QTPFS {
 		unsigned int prevMagicNum = -1u;
 
 		unsigned int childBaseIndex = -1u;
+		// -1u for the root, which never has neighbors
+		unsigned int poolIndex = -1u;
+
+		unsigned int ngbsBegin = 0;
+		unsigned int ngbsCount = 0;
 
-		std::vector<INode*> neighbors;
-		std::vector<float2> netpoints;
+		float2 netPoint;
 	};
 }
 
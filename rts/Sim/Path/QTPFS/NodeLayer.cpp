@@ -67,6 +67,11 @@ void QTPFS::NodeLayer::Clear() {
 	oldSpeedBins.clear();
 	curSpeedBins.clear();
 
+	nodeNeighbors.clear();
+	nodeNetPoints.clear();
+
+	numCompactNeighbors = 0;
+
 	#ifdef QTPFS_STAGGERED_LAYER_UPDATES
 	layerUpdates.clear();
 	#endif
@@ -246,8 +251,8 @@ void QTPFS::NodeLayer::ExecNodeNeighborCacheUpdate(unsigned int currFrameNum, un
 		// top-left quadrant: [0, mapDims.mapx >> 1) x [0, mapDims.mapy >> 1)
 		//
 		// update an 8x8 block of squares per quadrant per frame
-		// in row-major order; every GetNeighbors() call invokes
-		// UpdateNeighborCache if the magic numbers do not match
+		// in row-major order; every UpdateNeighborCache() call
+		// regenerates the cache if the magic numbers do not match
 		// (nodes can be visited multiple times per block update)
 		const int xmin =         (xoff +           0                   ), zmin =         (zoff +           0                   );
 		const int xmax = std::min(xmin + SQUARE_SIZE, mapDims.mapx >> 1), zmax = std::min(zmin + SQUARE_SIZE, mapDims.mapy >> 1);
@@ -263,7 +268,7 @@ void QTPFS::NodeLayer::ExecNodeNeighborCacheUpdate(unsigned int currFrameNum, un
 				zspan = std::max(zspan, 1u);
 
 				n->SetMagicNumber(currMagicNum);
-				n->GetNeighbors(nodeGrid);
+				n->UpdateNeighborCache(*this);
 			}
 
 			z += zspan;
@@ -285,7 +290,7 @@ void QTPFS::NodeLayer::ExecNodeNeighborCacheUpdate(unsigned int currFrameNum, un
 				zspan = std::max(zspan, 1u);
 
 				n->SetMagicNumber(currMagicNum);
-				n->GetNeighbors(nodeGrid);
+				n->UpdateNeighborCache(*this);
 			}
 
 			z += zspan;
@@ -307,7 +312,7 @@ void QTPFS::NodeLayer::ExecNodeNeighborCacheUpdate(unsigned int currFrameNum, un
 				zspan = std::max(zspan, 1u);
 
 				n->SetMagicNumber(currMagicNum);
-				n->GetNeighbors(nodeGrid);
+				n->UpdateNeighborCache(*this);
 			}
 
 			z += zspan;
@@ -329,12 +334,14 @@ void QTPFS::NodeLayer::ExecNodeNeighborCacheUpdate(unsigned int currFrameNum, un
 				zspan = std::max(zspan, 1u);
 
 				n->SetMagicNumber(currMagicNum);
-				n->GetNeighbors(nodeGrid);
+				n->UpdateNeighborCache(*this);
 			}
 
 			z += zspan;
 		}
 	}
+
+	CompactNodeNeighbors(false);
 }
 #endif
 #endif
@@ -364,10 +371,61 @@ void QTPFS::NodeLayer::ExecNodeNeighborCacheUpdates(const SRectangle& ur, unsign
 			//   during initialization, currMagicNum == 0 which nodes start with already 
 			//   (does not matter because prevMagicNum == -1, so updates are not no-ops)
 			n->SetMagicNumber(currMagicNum);
-			n->UpdateNeighborCache(nodeGrid);
+			n->UpdateNeighborCache(*this);
 		}
 
 		z += zspan;
 	}
+
+	CompactNodeNeighbors(false);
+}
+
+void QTPFS::NodeLayer::CompactNodeNeighbors(bool forced) {
+	// let the stale ranges grow as large as the live ones before collecting them
+	if (!forced && nodeNeighbors.size() <= (numCompactNeighbors * 2 + 1024))
+		return;
+
+	std::vector<unsigned int> ngbIndcs;
+	std::vector<float2> ngbPoints;
+	std::vector<INode*> nodeStack;
+
+	ngbIndcs.reserve(nodeNeighbors.size() >> 1);
+	ngbPoints.reserve(nodeNetPoints.size() >> 1);
+	nodeStack.reserve(64);
+	nodeStack.push_back(&rootNode);
+
+	// copy the live ranges in tree order, which also keeps
+	// those of spatially close leafs close together
+	while (!nodeStack.empty()) {
+		INode* n = nodeStack.back();
+
+		nodeStack.pop_back();
+
+		if (!n->IsLeaf()) {
+			for (unsigned int i = QTNODE_CHILD_COUNT; i > 0; i--) {
+				nodeStack.push_back(GetPoolNode(n->GetChildBaseIndex() + i - 1));
+			}
+
+			continue;
+		}
+
+		const unsigned int srcIdx = n->GetNeighborsBegin();
+		const unsigned int dstIdx = ngbIndcs.size();
+		const unsigned int numNgbs = n->GetNumNeighbors();
+
+		ngbIndcs.insert(ngbIndcs.end(), nodeNeighbors.begin() + srcIdx, nodeNeighbors.begin() + srcIdx + numNgbs);
+		ngbPoints.insert(
+			ngbPoints.end(),
+			nodeNetPoints.begin() + (srcIdx          ) * QTPFS_MAX_NETPOINTS_PER_NODE_EDGE,
+			nodeNetPoints.begin() + (srcIdx + numNgbs) * QTPFS_MAX_NETPOINTS_PER_NODE_EDGE
+		);
+
+		n->SetNeighbors(dstIdx, numNgbs);
+	}
+
+	nodeNeighbors.swap(ngbIndcs);
+	nodeNetPoints.swap(ngbPoints);
+
+	numCompactNeighbors = nodeNeighbors.size();
 }
 
@@ -89,6 +89,7 @@ namespace QTPFS {
 				poolNodes[idx / POOL_CHUNK_SIZE].resize(POOL_CHUNK_SIZE);
 
 			poolNodes[idx / POOL_CHUNK_SIZE][idx % POOL_CHUNK_SIZE].Init(parent, nn, x1, z1, x2, z2);
+			poolNodes[idx / POOL_CHUNK_SIZE][idx % POOL_CHUNK_SIZE].SetPoolIndex(idx);
 			nodeIndcs.pop_back();
 
 			return idx;
@@ -104,6 +105,17 @@ namespace QTPFS {
 
 		std::vector<INode*>& GetNodes() { return nodeGrid; }
 
+		std::vector<unsigned int>& GetNodeNeighbors() { return nodeNeighbors; }
+		std::vector<float2>& GetNodeNetPoints() { return nodeNetPoints; }
+
+		// pool-index of the i-th neighbor of <n>, and the first of its transition-points
+		unsigned int GetNodeNeighbor(const INode* n, unsigned int i) const { return nodeNeighbors[n->GetNeighborsBegin() + i]; }
+		const float2* GetNodeNetPoints(const INode* n, unsigned int i) const {
+			return &nodeNetPoints[(n->GetNeighborsBegin() + i) * QTPFS_MAX_NETPOINTS_PER_NODE_EDGE];
+		}
+
+		void CompactNodeNeighbors(bool forced);
+
 		void RegisterNode(INode* n);
 
 		void SetNumLeafNodes(unsigned int n) { numLeafNodes = n; }
@@ -126,6 +138,8 @@ namespace QTPFS {
 				memFootPrint += (poolNodes[i].size() * sizeof(QTNode));
 			}
 			memFootPrint += (nodeIndcs.size() * sizeof(decltype(nodeIndcs)::value_type));
+			memFootPrint += (nodeNeighbors.capacity() * sizeof(decltype(nodeNeighbors)::value_type));
+			memFootPrint += (nodeNetPoints.capacity() * sizeof(decltype(nodeNetPoints)::value_type));
 			return memFootPrint;
 		}
 
@@ -135,6 +149,15 @@ namespace QTPFS {
 		std::vector<QTNode> poolNodes[16];
 		std::vector<unsigned int> nodeIndcs;
 
+		// neighbor-caches of all leafs, each owns a contiguous range (with
+		// QTPFS_MAX_NETPOINTS_PER_NODE_EDGE points per neighbor) such that
+		// searches do not chase per-node heap allocations; regenerated lists
+		// are appended and stale ranges dropped by CompactNodeNeighbors
+		std::vector<unsigned int> nodeNeighbors;
+		std::vector<float2> nodeNetPoints;
+
+		unsigned int numCompactNeighbors = 0;
+
 		std::vector<SpeedModType> curSpeedMods;
 		std::vector<SpeedModType> oldSpeedMods;
 		std::vector<SpeedBinType> curSpeedBins;
@@ -158,8 +158,8 @@ namespace QTPFS {
 		void ResetState(INode* node);
 		void UpdateNode(INode* nextNode, INode* prevNode, unsigned int netPointIdx);
 
-		void IterateNodes(const std::vector<INode*>& allNodes);
-		void IterateNodeNeighbors(const std::vector<INode*>& nxtNodes);
+		void IterateNodes();
+		void IterateNodeNeighbors();
 
 		void TracePath(IPath* path);
 		void SmoothPath(IPath* path) const;
@@ -23,6 +23,7 @@
 #include "Sim/Units/UnitTypes/Builder.h"
 #include "Sim/Units/UnitTypes/Building.h"
 #include "Sim/Units/UnitTypes/Factory.h"
+#include "System/ContainerUtil.h"
 #include "System/SpringMath.h"
 #include "System/StringUtil.h"
 #include "System/EventHandler.h"
@@ -53,11 +54,12 @@ CR_REG_METADATA(CBuilderCAI , (
 ))
 
 // not adding to members, should repopulate itself
-spring::unordered_set<int> CBuilderCAI::reclaimers;
-spring::unordered_set<int> CBuilderCAI::featureReclaimers;
-spring::unordered_set<int> CBuilderCAI::resurrecters;
+CBuilderCAI::TargetClaims CBuilderCAI::reclaimers;
+CBuilderCAI::TargetClaims CBuilderCAI::featureReclaimers;
+CBuilderCAI::TargetClaims CBuilderCAI::resurrecters;
 
 std::vector<int> CBuilderCAI::removees;
+std::vector< std::pair<float, int> > CBuilderCAI::reclaimQuads;
 
 
 static std::string GetUnitDefBuildOptionToolTip(const UnitDef* ud, bool disabled) {
@@ -225,9 +227,9 @@ CBuilderCAI::~CBuilderCAI()
 
 void CBuilderCAI::InitStatic()
 {
-	spring::clear_unordered_set(reclaimers);
-	spring::clear_unordered_set(featureReclaimers);
-	spring::clear_unordered_set(resurrecters);
+	reclaimers.Clear();
+	featureReclaimers.Clear();
+	resurrecters.Clear();
 }
 
 void CBuilderCAI::PostLoad()
@@ -1009,7 +1011,7 @@ void CBuilderCAI::ExecuteReclaim(Command& c)
 					StopMoveAndFinishCommand();
 					RemoveUnitFromFeatureReclaimers(owner);
 				} else {
-					AddUnitToFeatureReclaimers(owner);
+					AddUnitToFeatureReclaimers(owner, uid);
 				}
 			} else {
 				StopMoveAndFinishCommand();
@@ -1044,7 +1046,7 @@ void CBuilderCAI::ExecuteReclaim(Command& c)
 				if (!ReclaimObject(unit)) {
 					StopMoveAndFinishCommand();
 				} else {
-					AddUnitToReclaimers(owner);
+					AddUnitToReclaimers(owner, uid);
 				}
 			} else {
 				RemoveUnitFromReclaimers(owner);
@@ -1117,7 +1119,7 @@ void CBuilderCAI::ExecuteResurrect(Command& c)
 					StopMoveAndFinishCommand();
 				}
 				else {
-					AddUnitToResurrecters(owner);
+					AddUnitToResurrecters(owner, id);
 				}
 			} else {
 				RemoveUnitFromResurrecters(owner);
@@ -1346,131 +1348,134 @@ int CBuilderCAI::GetDefaultCmd(const CUnit* pointed, const CFeature* feature)
 }
 
 
-void CBuilderCAI::AddUnitToReclaimers(CUnit* unit) { reclaimers.insert(unit->id); }
-void CBuilderCAI::RemoveUnitFromReclaimers(CUnit* unit) { reclaimers.erase(unit->id); }
+void CBuilderCAI::TargetClaims::Add(int unitID, int targetID)
+{
+	const auto it = unitTargets.find(unitID);
 
-void CBuilderCAI::AddUnitToFeatureReclaimers(CUnit* unit) { featureReclaimers.insert(unit->id); }
-void CBuilderCAI::RemoveUnitFromFeatureReclaimers(CUnit* unit) { featureReclaimers.erase(unit->id); }
+	if (it != unitTargets.end()) {
+		if (it->second == targetID)
+			return;
 
-void CBuilderCAI::AddUnitToResurrecters(CUnit* unit) { resurrecters.insert(unit->id); }
-void CBuilderCAI::RemoveUnitFromResurrecters(CUnit* unit) { resurrecters.erase(unit->id); }
+		Remove(unitID);
+	}
 
+	unitTargets[unitID] = targetID;
+	targetUnits[targetID].push_back(unitID);
+}
 
-/**
- * Checks if a unit is being reclaimed by a friendly con.
- *
- * We assume that there will not be a lot of reclaimers, because performance
- * would suck if there were. Ideally, reclaimers should be assigned on a
- * per-unit basis, but this requires tracking of deaths, which albeit
- * already done, is not exactly simple to follow.
- *
- * TODO easy: store reclaiming units per allyteam
- * TODO harder: update reclaimers as they start/finish reclaims and/or die
- */
-bool CBuilderCAI::IsUnitBeingReclaimed(const CUnit* unit, const CUnit* friendUnit)
+void CBuilderCAI::TargetClaims::Remove(int unitID)
 {
-	bool retval = false;
+	const auto it = unitTargets.find(unitID);
 
-	removees.clear();
-	removees.reserve(reclaimers.size());
+	if (it == unitTargets.end())
+		return;
 
-	for (auto it = reclaimers.begin(); it != reclaimers.end(); ++it) {
-		const CUnit* u = unitHandler.GetUnit(*it);
-		const CCommandAI* cai = u->commandAI;
-		const CCommandQueue& cq = cai->commandQue;
+	const auto jt = targetUnits.find(it->second);
 
-		if (cq.empty()) {
-			removees.push_back(u->id);
-			continue;
-		}
-		const Command& c = cq.front();
-		if (c.GetID() != CMD_RECLAIM || (c.GetNumParams() != 1 && c.GetNumParams() != 5)) {
-			removees.push_back(u->id);
-			continue;
-		}
-		const int cmdUnitId = (int)c.GetParam(0);
-		if (cmdUnitId == unit->id && (friendUnit == nullptr || teamHandler.Ally(friendUnit->allyteam, u->allyteam))) {
-			retval = true;
-			break;
-		}
-	}
+	assert(jt != targetUnits.end());
+	spring::VectorErase(jt->second, unitID);
 
-	for (auto it = removees.begin(); it != removees.end(); ++it)
-		RemoveUnitFromReclaimers(unitHandler.GetUnit(*it));
+	if (jt->second.empty())
+		targetUnits.erase(jt);
 
-	return retval;
+	unitTargets.erase(it);
 }
 
+void CBuilderCAI::TargetClaims::Clear()
+{
+	spring::clear_unordered_map(unitTargets);
+	spring::clear_unordered_map(targetUnits);
+}
 
-bool CBuilderCAI::IsFeatureBeingReclaimed(int featureId, const CUnit* friendUnit)
+std::vector<int> CBuilderCAI::TargetClaims::GetUnits(int targetID) const
 {
-	bool retval = false;
+	const auto it = targetUnits.find(targetID);
 
-	removees.clear();
-	removees.reserve(featureReclaimers.size());
+	if (it == targetUnits.end())
+		return {};
 
-	for (auto it = featureReclaimers.begin(); it != featureReclaimers.end(); ++it) {
-		const CUnit* u = unitHandler.GetUnit(*it);
-		const CCommandAI* cai = u->commandAI;
-		const CCommandQueue& cq = cai->commandQue;
+	return it->second;
+}
 
-		if (cq.empty()) {
-			removees.push_back(u->id);
-			continue;
-		}
-		const Command& c = cq.front();
-		if (c.GetID() != CMD_RECLAIM || (c.GetNumParams() != 1 && c.GetNumParams() != 5)) {
-			removees.push_back(u->id);
-			continue;
-		}
-		const int cmdFeatureId = (int)c.GetParam(0);
-		if ((cmdFeatureId - unitHandler.MaxUnits()) == featureId && (friendUnit == nullptr || teamHandler.Ally(friendUnit->allyteam, u->allyteam))) {
-			retval = true;
-			break;
-		}
-	}
 
-	for (auto it = removees.begin(); it != removees.end(); ++it)
-		RemoveUnitFromFeatureReclaimers(unitHandler.GetUnit(*it));
+void CBuilderCAI::AddUnitToReclaimers(CUnit* unit, int targetID) { reclaimers.Add(unit->id, targetID); }
+void CBuilderCAI::RemoveUnitFromReclaimers(CUnit* unit) { reclaimers.Remove(unit->id); }
 
-	return retval;
-}
+void CBuilderCAI::AddUnitToFeatureReclaimers(CUnit* unit, int targetID) { featureReclaimers.Add(unit->id, targetID); }
+void CBuilderCAI::RemoveUnitFromFeatureReclaimers(CUnit* unit) { featureReclaimers.Remove(unit->id); }
 
+void CBuilderCAI::AddUnitToResurrecters(CUnit* unit, int targetID) { resurrecters.Add(unit->id, targetID); }
+void CBuilderCAI::RemoveUnitFromResurrecters(CUnit* unit) { resurrecters.Remove(unit->id); }
 
-bool CBuilderCAI::IsFeatureBeingResurrected(int featureId, const CUnit* friendUnit)
+
+/**
+ * Checks if a target is claimed by a builder allied to friendUnit (or any
+ * builder if friendUnit is null) whose current command is <cmdID> on it.
+ */
+bool CBuilderCAI::IsTargetClaimed(TargetClaims& claims, int targetID, const CUnit* friendUnit, int cmdID, bool allowAreaParams)
 {
+	const auto it = claims.targetUnits.find(targetID);
+
+	if (it == claims.targetUnits.end())
+		return false;
+
 	bool retval = false;
 
 	removees.clear();
-	removees.reserve(resurrecters.size());
+	removees.reserve(it->second.size());
 
-	for (auto it = resurrecters.begin(); it != resurrecters.end(); ++it) {
-		const CUnit* u = unitHandler.GetUnit(*it);
-		const CCommandAI* cai = u->commandAI;
-		const CCommandQueue& cq = cai->commandQue;
+	for (const int unitID: it->second) {
+		const CUnit* u = unitHandler.GetUnit(unitID);
+		const CCommandQueue& cq = u->commandAI->commandQue;
 
 		if (cq.empty()) {
-			removees.push_back(u->id);
+			removees.push_back(unitID);
 			continue;
 		}
+
 		const Command& c = cq.front();
-		if (c.GetID() != CMD_RESURRECT || c.GetNumParams() != 1) {
-			removees.push_back(u->id);
+
+		if (c.GetID() != cmdID || (c.GetNumParams() != 1 && (!allowAreaParams || c.GetNumParams() != 5))) {
+			removees.push_back(unitID);
+			continue;
+		}
+		if (int(c.GetParam(0)) != targetID) {
+			removees.push_back(unitID);
 			continue;
 		}
-		const int cmdFeatureId = (int)c.GetParam(0);
-		if ((cmdFeatureId - unitHandler.MaxUnits()) == featureId && (friendUnit == nullptr || teamHandler.Ally(friendUnit->allyteam, u->allyteam))) {
+
+		if (friendUnit == nullptr || teamHandler.Ally(friendUnit->allyteam, u->allyteam)) {
 			retval = true;
 			break;
 		}
 	}
 
-	for (auto it = removees.begin(); it != removees.end(); ++it)
-		RemoveUnitFromResurrecters(unitHandler.GetUnit(*it));
+	// invalidates <it>
+	for (const int unitID: removees) {
+		claims.Remove(unitID);
+	}
 
 	return retval;
 }
 
+/**
+ * Checks if a unit is being reclaimed by a friendly con.
+ */
+bool CBuilderCAI::IsUnitBeingReclaimed(const CUnit* unit, const CUnit* friendUnit)
+{
+	return (IsTargetClaimed(reclaimers, unit->id, friendUnit, CMD_RECLAIM, true));
+}
+
+bool CBuilderCAI::IsFeatureBeingReclaimed(int featureId, const CUnit* friendUnit)
+{
+	return (IsTargetClaimed(featureReclaimers, featureId + unitHandler.MaxUnits(), friendUnit, CMD_RECLAIM, true));
+}
+
+bool CBuilderCAI::IsFeatureBeingResurrected(int featureId, const CUnit* friendUnit)
+{
+	return (IsTargetClaimed(resurrecters, featureId + unitHandler.MaxUnits(), friendUnit, CMD_RESURRECT, false));
+}
+
 
 bool CBuilderCAI::ReclaimObject(CSolidObject* object) {
 	if (MoveInBuildRange(object)) {
@@ -1537,42 +1542,63 @@ int CBuilderCAI::FindReclaimTarget(const float3& pos, float radius, unsigned cha
 	if ((!best || !stationary) && !recEnemyOnly) {
 		best = nullptr;
 		const CTeam* team = teamHandler.Team(owner->team);
-		QuadFieldQuery qfQuery;
-		quadField.GetFeaturesExact(qfQuery, pos, radius, false);
+		const bool needMetal  = (team->res.metal  < team->resStorage.metal );
+		const bool needEnergy = (team->res.energy < team->resStorage.energy);
 		bool metal = false;
 
-		for (const CFeature* f: *qfQuery.features) {
-			if (!f->def->reclaimable)
-				continue;
-			if (!recSpecial && !f->def->autoreclaim)
-				continue;
+		quadField.GetReclaimQuads(reclaimQuads, pos, radius, owner->pos);
 
-			if (recNonRez && f->udef != nullptr)
-				continue;
+		for (const auto& reclaimQuad: reclaimQuads) {
+			// quads are visited nearest-first, none of the remaining can hold
+			// a closer feature; only a CTRL-search for metal has to continue
+			if (reclaimQuad.first >= bestDist && (!recSpecial || metal))
+				break;
 
-			if (recSpecial && metal && f->defResources.metal <= 0.0)
-				continue;
+			const CQuadField::Quad& quad = quadField.GetQuad(reclaimQuad.second);
+			const int* counts = quad.reclaimCounts;
 
-			const float dist = f3SqDist(f->pos, owner->pos);
+			if (!recSpecial && counts[CQuadField::RECLAIM_COUNT_AUTORECLAIM] == 0)
+				continue;
+			if (recSpecial && metal && counts[CQuadField::RECLAIM_COUNT_METAL] == 0)
+				continue;
+			if (!noResCheck && !(needMetal && counts[CQuadField::RECLAIM_COUNT_METAL] > 0) && !(needEnergy && counts[CQuadField::RECLAIM_COUNT_ENERGY] > 0))
+				continue;
 
-			if ((dist < bestDist || (recSpecial && !metal && f->defResources.metal > 0.0)) &&
-				(noResCheck ||
-				((f->defResources.metal  > 0.0f) && (team->res.metal  < team->resStorage.metal)) ||
-				((f->defResources.energy > 0.0f) && (team->res.energy < team->resStorage.energy)))
-			) {
-				if (!f->IsInLosForAllyTeam(owner->allyteam))
+			for (const CFeature* f: quad.reclaimFeatures) {
+				if (!f->def->reclaimable)
+					continue;
+				if (pos.SqDistance2D(f->pos) >= Square(radius + f->radius))
+					continue;
+				if (!recSpecial && !f->def->autoreclaim)
 					continue;
 
-				if (!owner->unitDef->canmove && !IsInBuildRange(f))
+				if (recNonRez && f->udef != nullptr)
 					continue;
 
-				if (!(cmdopt & CONTROL_KEY) && IsFeatureBeingResurrected(f->id, owner))
+				if (recSpecial && metal && f->defResources.metal <= 0.0)
 					continue;
 
-				metal |= (recSpecial && !metal && f->defResources.metal > 0.0f);
+				const float dist = f3SqDist(f->pos, owner->pos);
 
-				bestDist = dist;
-				best = f;
+				if ((dist < bestDist || (recSpecial && !metal && f->defResources.metal > 0.0)) &&
+					(noResCheck ||
+					((f->defResources.metal  > 0.0f) && needMetal) ||
+					((f->defResources.energy > 0.0f) && needEnergy))
+				) {
+					if (!f->IsInLosForAllyTeam(owner->allyteam))
+						continue;
+
+					if (!owner->unitDef->canmove && !IsInBuildRange(f))
+						continue;
+
+					if (!(cmdopt & CONTROL_KEY) && IsFeatureBeingResurrected(f->id, owner))
+						continue;
+
+					metal |= (recSpecial && !metal && f->defResources.metal > 0.0f);
+
+					bestDist = dist;
+					best = f;
+				}
 			}
 		}
 
@@ -1613,33 +1639,45 @@ bool CBuilderCAI::FindResurrectableFeatureAndResurrect(
 	unsigned char options,
 	bool freshOnly
 ) {
-	QuadFieldQuery qfQuery;
-	quadField.GetFeaturesExact(qfQuery, pos, radius, false);
-
 	const CFeature* best = nullptr;
 	float bestDist = 1.0e30f;
 
-	for (const CFeature* f: *qfQuery.features) {
-		if (f->udef == nullptr)
-			continue;
+	quadField.GetReclaimQuads(reclaimQuads, pos, radius, owner->pos);
 
-		if (!f->IsInLosForAllyTeam(owner->allyteam))
-			continue;
+	for (const auto& reclaimQuad: reclaimQuads) {
+		if (reclaimQuad.first >= bestDist)
+			break;
 
-		if (freshOnly && f->reclaimLeft < 1.0f)
+		const CQuadField::Quad& quad = quadField.GetQuad(reclaimQuad.second);
+
+		if (quad.reclaimCounts[CQuadField::RECLAIM_COUNT_RESURRECT] == 0)
 			continue;
 
-		const float dist = f3SqDist(f->pos, owner->pos);
-		if (dist < bestDist) {
-			// dont lock-on to units outside of our reach (for immobile builders)
-			if (owner->immobile && !IsInBuildRange(f))
+		for (const CFeature* f: quad.reclaimFeatures) {
+			if (f->udef == nullptr)
+				continue;
+
+			if (pos.SqDistance2D(f->pos) >= Square(radius + f->radius))
 				continue;
 
-			if (!(options & CONTROL_KEY) && IsFeatureBeingReclaimed(f->id, owner))
+			if (!f->IsInLosForAllyTeam(owner->allyteam))
 				continue;
 
-			bestDist = dist;
-			best = f;
+			if (freshOnly && f->reclaimLeft < 1.0f)
+				continue;
+
+			const float dist = f3SqDist(f->pos, owner->pos);
+			if (dist < bestDist) {
+				// dont lock-on to units outside of our reach (for immobile builders)
+				if (owner->immobile && !IsInBuildRange(f))
+					continue;
+
+				if (!(options & CONTROL_KEY) && IsFeatureBeingReclaimed(f->id, owner))
+					continue;
+
+				bestDist = dist;
+				best = f;
+			}
 		}
 	}
 
@@ -6,6 +6,7 @@
 #include "MobileCAI.h"
 #include "Sim/Units/BuildInfo.h"
 #include "System/Misc/BitwiseEnum.h"
+#include "System/UnorderedMap.hpp"
 #include "System/UnorderedSet.hpp"
 
 #include <vector>
@@ -65,11 +66,30 @@ public:
 public:
 	spring::unordered_set<int> buildOptions;
 
-	static spring::unordered_set<int> reclaimers;
-	static spring::unordered_set<int> featureReclaimers;
-	static spring::unordered_set<int> resurrecters;
+	/**
+	 * Builders working on a reclaim- or resurrect-target, indexed by the
+	 * target's command-id (features are offset by MaxUnits). Claims are
+	 * validated against the builder's current command when queried and
+	 * dropped if stale, so only the claimants of one target are visited.
+	 */
+	struct TargetClaims {
+		void Add(int unitID, int targetID);
+		void Remove(int unitID);
+		void Clear();
+
+		/// copy of the units claiming targetID, safe to iterate while claims change
+		std::vector<int> GetUnits(int targetID) const;
+
+		spring::unordered_map<int, int> unitTargets;
+		spring::unordered_map<int, std::vector<int> > targetUnits;
+	};
+
+	static TargetClaims reclaimers;
+	static TargetClaims featureReclaimers;
+	static TargetClaims resurrecters;
 
 	static std::vector<int> removees;
+	static std::vector< std::pair<float, int> > reclaimQuads;
 
 private:
 	enum ReclaimOptions {
@@ -125,17 +145,19 @@ private:
 	void ReclaimFeature(CFeature* f);
 
 	/// fix for patrolling cons repairing/resurrecting stuff that's being reclaimed
-	static void AddUnitToReclaimers(CUnit*);
+	static void AddUnitToReclaimers(CUnit*, int targetID);
 	static void RemoveUnitFromReclaimers(CUnit*);
 
 	/// fix for cons wandering away from their target circle
-	static void AddUnitToFeatureReclaimers(CUnit*);
+	static void AddUnitToFeatureReclaimers(CUnit*, int targetID);
 	static void RemoveUnitFromFeatureReclaimers(CUnit*);
 
 	/// fix for patrolling cons reclaiming stuff that is being resurrected
-	static void AddUnitToResurrecters(CUnit*);
+	static void AddUnitToResurrecters(CUnit*, int targetID);
 	static void RemoveUnitFromResurrecters(CUnit*);
 
+	static bool IsTargetClaimed(TargetClaims& claims, int targetID, const CUnit* friendUnit, int cmdID, bool allowAreaParams);
+
 	inline float f3Dist(const float3& a, const float3& b) const {
 		return range3D ? a.distance(b) : a.distance2D(b);
 	}
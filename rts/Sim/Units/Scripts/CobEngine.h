@@ -64,6 +64,8 @@ public:
 		while (!sleepingThreadIDs.empty()) {
 			sleepingThreadIDs.pop();
 		}
+
+		CCobThread::FreeStackPool();
 	}
 
 	void Tick(int deltaTime);
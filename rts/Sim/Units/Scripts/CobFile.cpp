@@ -3,6 +3,7 @@
 
 #include "Sim/Misc/GlobalConstants.h"
 #include "CobFile.h"
+#include "CobOpcodes.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/Log/ILog.h"
 #include "System/Sound/ISound.h"
@@ -196,6 +197,40 @@ CCobFile::CCobFile(CFileHandler& in, const std::string& scriptName)
 
 		scriptIndex[pair.second] = fn;
 	}
+
+	DecodeInstructions();
+}
+
+
+void CCobFile::DecodeInstructions()
+{
+	// every word is decoded, not only those reachable as opcodes; operand
+	// words map to whatever instruction they happen to look like, which
+	// matches what the raw interpreter would run if a script jumped there
+	instrs.clear();
+	instrs.resize(code.size(), COB::INSTR_UNKNOWN);
+
+	for (size_t i = 0, n = code.size(); i < n; i++) {
+		// no instruction has more than two operands; rejecting any that
+		// would read past the end lets the interpreter skip range checks
+		if ((i + 2) >= n)
+			break;
+
+		COB::Instr instr = COB::DecodeOpcode(code[i]);
+
+		// resolve calls once here rather than patching the code at runtime
+		if (instr == COB::INSTR_CALL) {
+			const size_t fn = code[i + 1];
+
+			if (fn < scriptNames.size()) {
+				instr = (scriptNames[fn].find("lua_") == 0)? COB::INSTR_LUA_CALL: COB::INSTR_REAL_CALL;
+			} else {
+				instr = COB::INSTR_UNKNOWN;
+			}
+		}
+
+		instrs[i] = instr;
+	}
 }
 
 
@@ -4,6 +4,7 @@
 #define COB_FILE_H
 
 #include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -23,6 +24,7 @@ public:
 		numStaticVars = f.numStaticVars;
 
 		code = std::move(f.code);
+		instrs = std::move(f.instrs);
 		scriptNames = std::move(f.scriptNames);
 		scriptOffsets = std::move(f.scriptOffsets);
 
@@ -39,10 +41,15 @@ public:
 
 	int GetFunctionId(const std::string& name);
 
+private:
+	void DecodeInstructions();
+
 public:
 	int numStaticVars = 0;
 
 	std::vector<int> code;
+	/// pre-decoded COB::Instr for every word in code
+	std::vector<uint8_t> instrs;
 	std::vector<std::string> scriptNames;
 	std::vector<int> scriptOffsets;
 	/// Assumes that the scripts are sorted by offset in the file
@@ -0,0 +1,111 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef COB_OPCODES_H
+#define COB_OPCODES_H
+
+#include <cstdint>
+
+// Command documentation from http://visualta.tauniverse.com/Downloads/cob-commands.txt
+// And some information from basm0.8 source (basm ops.txt)
+//
+// X(name, raw opcode)
+#define COB_OPCODES(X) \
+	/* Model interaction */ \
+	X(MOVE      , 0x10001000) \
+	X(TURN      , 0x10002000) \
+	X(SPIN      , 0x10003000) \
+	X(STOP_SPIN , 0x10004000) \
+	X(SHOW      , 0x10005000) \
+	X(HIDE      , 0x10006000) \
+	X(CACHE     , 0x10007000) \
+	X(DONT_CACHE, 0x10008000) \
+	X(MOVE_NOW  , 0x1000B000) \
+	X(TURN_NOW  , 0x1000C000) \
+	X(SHADE     , 0x1000D000) \
+	X(DONT_SHADE, 0x1000E000) \
+	X(EMIT_SFX  , 0x1000F000) \
+	/* Blocking operations */ \
+	X(WAIT_TURN , 0x10011000) \
+	X(WAIT_MOVE , 0x10012000) \
+	X(SLEEP     , 0x10013000) \
+	/* Stack manipulation */ \
+	X(PUSH_CONSTANT   , 0x10021001) \
+	X(PUSH_LOCAL_VAR  , 0x10021002) \
+	X(PUSH_STATIC     , 0x10021004) \
+	X(CREATE_LOCAL_VAR, 0x10022000) \
+	X(POP_LOCAL_VAR   , 0x10023002) \
+	X(POP_STATIC      , 0x10023004) \
+	X(POP_STACK       , 0x10024000) /* Not sure what this is supposed to do */ \
+	/* Arithmetic operations */ \
+	X(ADD        , 0x10031000) \
+	X(SUB        , 0x10032000) \
+	X(MUL        , 0x10033000) \
+	X(DIV        , 0x10034000) \
+	X(MOD        , 0x10034001) /* spring specific */ \
+	X(BITWISE_AND, 0x10035000) \
+	X(BITWISE_OR , 0x10036000) \
+	X(BITWISE_XOR, 0x10037000) \
+	X(BITWISE_NOT, 0x10038000) \
+	/* Native function calls */ \
+	X(RAND          , 0x10041000) \
+	X(GET_UNIT_VALUE, 0x10042000) \
+	X(GET           , 0x10043000) \
+	/* Comparison */ \
+	X(SET_LESS            , 0x10051000) \
+	X(SET_LESS_OR_EQUAL   , 0x10052000) \
+	X(SET_GREATER         , 0x10053000) \
+	X(SET_GREATER_OR_EQUAL, 0x10054000) \
+	X(SET_EQUAL           , 0x10055000) \
+	X(SET_NOT_EQUAL       , 0x10056000) \
+	X(LOGICAL_AND         , 0x10057000) \
+	X(LOGICAL_OR          , 0x10058000) \
+	X(LOGICAL_XOR         , 0x10059000) \
+	X(LOGICAL_NOT         , 0x1005A000) \
+	/* Flow control */ \
+	X(START          , 0x10061000) \
+	X(CALL           , 0x10062000) /* resolved to REAL_CALL or LUA_CALL by CCobFile */ \
+	X(REAL_CALL      , 0x10062001) /* spring custom */ \
+	X(LUA_CALL       , 0x10062002) /* spring custom */ \
+	X(JUMP           , 0x10064000) \
+	X(RETURN         , 0x10065000) \
+	X(JUMP_NOT_EQUAL , 0x10066000) \
+	X(SIGNAL         , 0x10067000) \
+	X(SET_SIGNAL_MASK, 0x10068000) \
+	/* Piece destruction */ \
+	X(EXPLODE   , 0x10071000) \
+	X(PLAY_SOUND, 0x10072000) \
+	/* Special functions */ \
+	X(SET   , 0x10082000) \
+	X(ATTACH, 0x10083000) \
+	X(DROP  , 0x10084000)
+
+
+namespace COB {
+	#define COB_RAW_OPCODE(name, value) constexpr int name = value;
+	COB_OPCODES(COB_RAW_OPCODE)
+	#undef COB_RAW_OPCODE
+
+	// dense instruction indices, CCobFile translates every code word
+	// into one of these so the interpreter can dispatch via a table
+	enum Instr: uint8_t {
+		INSTR_UNKNOWN = 0,
+		#define COB_INSTR_ENUM(name, value) INSTR_##name,
+		COB_OPCODES(COB_INSTR_ENUM)
+		#undef COB_INSTR_ENUM
+		INSTR_COUNT
+	};
+
+	static inline Instr DecodeOpcode(int opcode) {
+		switch (opcode) {
+			#define COB_DECODE_CASE(name, value) case value: return INSTR_##name;
+			COB_OPCODES(COB_DECODE_CASE)
+			#undef COB_DECODE_CASE
+			default: {
+			} break;
+		}
+
+		return INSTR_UNKNOWN;
+	}
+};
+
+#endif // COB_OPCODES_H
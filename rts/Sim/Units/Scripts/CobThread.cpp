@@ -5,6 +5,7 @@
 #include "CobFile.h"
 #include "CobInstance.h"
 #include "CobEngine.h"
+#include "CobOpcodes.h"
 #include "Sim/Misc/GlobalConstants.h"
 #include "Sim/Misc/GlobalSynced.h"
 
@@ -48,17 +49,48 @@ CR_REG_METADATA_SUB(CCobThread, CallInfo,(
 ))
 
 
+CCobThread::StackPool CCobThread::stackPool;
+
+
 CCobThread::CCobThread(CCobInstance* _cobInst)
 	: cobInst(_cobInst)
 	, cobFile(_cobInst->cobFile)
 {
 	memset(&luaArgs[0], 0, MAX_LUA_COB_ARGS * sizeof(luaArgs[0]));
-	callStack.fill({});
-	dataStack.fill(0);
+	AcquireStacks();
+}
+
+
+void CCobThread::AcquireStacks()
+{
+	if (!stackPool.callStacks.empty()) {
+		callStack = std::move(stackPool.callStacks.back());
+		stackPool.callStacks.pop_back();
+	}
+	if (!stackPool.dataStacks.empty()) {
+		dataStack = std::move(stackPool.dataStacks.back());
+		stackPool.dataStacks.pop_back();
+	}
+
+	callStack.assign(MIN_CALL_STACK_SIZE, {});
+	dataStack.assign(MIN_DATA_STACK_SIZE, 0);
+}
+
+void CCobThread::ReleaseStacks()
+{
+	// only keep buffers of the common size, the few threads that grew
+	// deep stacks give their memory back instead of pinning it forever
+	if (callStack.capacity() != 0 && callStack.capacity() <= (MIN_CALL_STACK_SIZE * 2))
+		stackPool.callStacks.emplace_back(std::move(callStack));
+	if (dataStack.capacity() != 0 && dataStack.capacity() <= (MIN_DATA_STACK_SIZE * 2))
+		stackPool.dataStacks.emplace_back(std::move(dataStack));
+
+	callStack = {};
+	dataStack = {};
 }
 
 
-CCobThread& CCobThread::operator = (CCobThread&& t) {
+CCobThread& CCobThread::operator = (CCobThread&& t) noexcept {
 	id = t.id;
 	pc = t.pc;
 
@@ -76,8 +108,9 @@ CCobThread& CCobThread::operator = (CCobThread&& t) {
 
 	std::memcpy(luaArgs, t.luaArgs, sizeof(luaArgs));
 
-	std::memcpy(callStack.data(), t.callStack.data(), callStackSize * sizeof(callStack[0]));
-	std::memcpy(dataStack.data(), t.dataStack.data(), dataStackSize * sizeof(dataStack[0]));
+	// <t> takes our buffers and returns them to the pool when destroyed
+	std::swap(callStack, t.callStack);
+	std::swap(dataStack, t.dataStack);
 	// execTrace = std::move(t.execTrace);
 
 	state = t.state;
@@ -106,8 +139,8 @@ CCobThread& CCobThread::operator = (const CCobThread& t) {
 
 	std::memcpy(luaArgs, t.luaArgs, sizeof(luaArgs));
 
-	std::memcpy(callStack.data(), t.callStack.data(), callStackSize * sizeof(callStack[0]));
-	std::memcpy(dataStack.data(), t.dataStack.data(), dataStackSize * sizeof(dataStack[0]));
+	callStack = t.callStack;
+	dataStack = t.dataStack;
 	// execTrace = t.execTrace;
 
 	state = t.state;
@@ -137,7 +170,7 @@ void CCobThread::Start(int functionId, int sigMask, const std::array<int, 1 + MA
 	// copy arguments; args[0] holds the count
 	// handled by InitStack if thread has a parent that STARTs it,
 	// in which case args[0] is 0 and stack already contains data
-	if (paramCount > 0)
+	if (paramCount > 0 && GrowDataStack(paramCount))
 		std::memcpy(dataStack.data(), args.data() + 1, (dataStackSize = paramCount) * sizeof(args[0]));
 
 	// add to scheduler
@@ -188,7 +221,7 @@ int CCobThread::CheckStack(unsigned int size, bool warn)
 void CCobThread::InitStack(unsigned int n, CCobThread* t)
 {
 	assert(dataStackSize == 0);
-	dataStack.fill(0);
+	std::fill(dataStack.begin(), dataStack.end(), 0);
 
 	// move n arguments from caller's stack onto our own
 	for (unsigned int i = 0; i < n; ++i) {
@@ -198,86 +231,6 @@ void CCobThread::InitStack(unsigned int n, CCobThread* t)
 
 
 
-// Command documentation from http://visualta.tauniverse.com/Downloads/cob-commands.txt
-// And some information from basm0.8 source (basm ops.txt)
-
-// Model interaction
-constexpr int MOVE       = 0x10001000;
-constexpr int TURN       = 0x10002000;
-constexpr int SPIN       = 0x10003000;
-constexpr int STOP_SPIN  = 0x10004000;
-constexpr int SHOW       = 0x10005000;
-constexpr int HIDE       = 0x10006000;
-constexpr int CACHE      = 0x10007000;
-constexpr int DONT_CACHE = 0x10008000;
-constexpr int MOVE_NOW   = 0x1000B000;
-constexpr int TURN_NOW   = 0x1000C000;
-constexpr int SHADE      = 0x1000D000;
-constexpr int DONT_SHADE = 0x1000E000;
-constexpr int EMIT_SFX   = 0x1000F000;
-
-// Blocking operations
-constexpr int WAIT_TURN  = 0x10011000;
-constexpr int WAIT_MOVE  = 0x10012000;
-constexpr int SLEEP      = 0x10013000;
-
-// Stack manipulation
-constexpr int PUSH_CONSTANT    = 0x10021001;
-constexpr int PUSH_LOCAL_VAR   = 0x10021002;
-constexpr int PUSH_STATIC      = 0x10021004;
-constexpr int CREATE_LOCAL_VAR = 0x10022000;
-constexpr int POP_LOCAL_VAR    = 0x10023002;
-constexpr int POP_STATIC       = 0x10023004;
-constexpr int POP_STACK        = 0x10024000; ///< Not sure what this is supposed to do
-
-// Arithmetic operations
-constexpr int ADD         = 0x10031000;
-constexpr int SUB         = 0x10032000;
-constexpr int MUL         = 0x10033000;
-constexpr int DIV         = 0x10034000;
-constexpr int MOD		  = 0x10034001; ///< spring specific
-constexpr int BITWISE_AND = 0x10035000;
-constexpr int BITWISE_OR  = 0x10036000;
-constexpr int BITWISE_XOR = 0x10037000;
-constexpr int BITWISE_NOT = 0x10038000;
-
-// Native function calls
-constexpr int RAND           = 0x10041000;
-constexpr int GET_UNIT_VALUE = 0x10042000;
-constexpr int GET            = 0x10043000;
-
-// Comparison
-constexpr int SET_LESS             = 0x10051000;
-constexpr int SET_LESS_OR_EQUAL    = 0x10052000;
-constexpr int SET_GREATER          = 0x10053000;
-constexpr int SET_GREATER_OR_EQUAL = 0x10054000;
-constexpr int SET_EQUAL            = 0x10055000;
-constexpr int SET_NOT_EQUAL        = 0x10056000;
-constexpr int LOGICAL_AND          = 0x10057000;
-constexpr int LOGICAL_OR           = 0x10058000;
-constexpr int LOGICAL_XOR          = 0x10059000;
-constexpr int LOGICAL_NOT          = 0x1005A000;
-
-// Flow control
-constexpr int START           = 0x10061000;
-constexpr int CALL            = 0x10062000; ///< converted when executed
-constexpr int REAL_CALL       = 0x10062001; ///< spring custom
-constexpr int LUA_CALL        = 0x10062002; ///< spring custom
-constexpr int JUMP            = 0x10064000;
-constexpr int RETURN          = 0x10065000;
-constexpr int JUMP_NOT_EQUAL  = 0x10066000;
-constexpr int SIGNAL          = 0x10067000;
-constexpr int SET_SIGNAL_MASK = 0x10068000;
-
-// Piece destruction
-constexpr int EXPLODE    = 0x10071000;
-constexpr int PLAY_SOUND = 0x10072000;
-
-// Special functions
-constexpr int SET    = 0x10082000;
-constexpr int ATTACH = 0x10083000;
-constexpr int DROP   = 0x10084000;
-
 // Indices for SET, GET, and GET_UNIT_VALUE for LUA return values
 #define LUA0 110 // (LUA0 returns the lua call status, 0 or 1)
 #define LUA1 111
@@ -290,89 +243,16 @@ constexpr int DROP   = 0x10084000;
 #define LUA8 118
 #define LUA9 119
 
-#if 0
+// operands of decoded instructions are always in range (see
+// CCobFile::DecodeInstructions), only the opcode fetch is checked
 #define GET_LONG_PC() (cobFile->code[pc++])
-#else
-// mantis #5981
-#define GET_LONG_PC() (cobFile->code.at(pc++))
-#endif
-
-
-#if 0
-static const char* GetOpcodeName(int opcode)
-{
-	switch (opcode) {
-		case MOVE: return "move";
-		case TURN: return "turn";
-		case SPIN: return "spin";
-		case STOP_SPIN: return "stop-spin";
-		case SHOW: return "show";
-		case HIDE: return "hide";
-		case CACHE: return "cache";
-		case DONT_CACHE: return "dont-cache";
-		case TURN_NOW: return "turn-now";
-		case MOVE_NOW: return "move-now";
-		case SHADE: return "shade";
-		case DONT_SHADE: return "dont-shade";
-		case EMIT_SFX: return "sfx";
-
-		case WAIT_TURN: return "wait-for-turn";
-		case WAIT_MOVE: return "wait-for-move";
-		case SLEEP: return "sleep";
-
-		case PUSH_CONSTANT: return "pushc";
-		case PUSH_LOCAL_VAR: return "pushl";
-		case PUSH_STATIC: return "pushs";
-		case CREATE_LOCAL_VAR: return "clv";
-		case POP_LOCAL_VAR: return "popl";
-		case POP_STATIC: return "pops";
-		case POP_STACK: return "pop-stack";
-
-		case ADD: return "add";
-		case SUB: return "sub";
-		case MUL: return "mul";
-		case DIV: return "div";
-		case MOD: return "mod";
-		case BITWISE_AND: return "and";
-		case BITWISE_OR: return "or";
-		case BITWISE_XOR: return "xor";
-		case BITWISE_NOT: return "not";
-
-		case RAND: return "rand";
-		case GET_UNIT_VALUE: return "getuv";
-		case GET: return "get";
-
-		case SET_LESS: return "setl";
-		case SET_LESS_OR_EQUAL: return "setle";
-		case SET_GREATER: return "setg";
-		case SET_GREATER_OR_EQUAL: return "setge";
-		case SET_EQUAL: return "sete";
-		case SET_NOT_EQUAL: return "setne";
-		case LOGICAL_AND: return "land";
-		case LOGICAL_OR: return "lor";
-		case LOGICAL_XOR: return "lxor";
-		case LOGICAL_NOT: return "neg";
-
-		case START: return "start";
-		case CALL: return "call";
-		case REAL_CALL: return "call";
-		case LUA_CALL: return "lua_call";
-		case JUMP: return "jmp";
-		case RETURN: return "return";
-		case JUMP_NOT_EQUAL: return "jne";
-		case SIGNAL: return "signal";
-		case SET_SIGNAL_MASK: return "mask";
-
-		case EXPLODE: return "explode";
-		case PLAY_SOUND: return "play-sound";
-
-		case SET: return "set";
-		case ATTACH: return "attach";
-		case DROP: return "drop";
-	}
 
-	return "unknown";
-}
+// computed-goto dispatch where the compiler supports it, a dense
+// switch over the pre-decoded instructions everywhere else
+#if (defined(__GNUC__) || defined(__clang__))
+#define COB_THREADED_DISPATCH 1
+#else
+#define COB_THREADED_DISPATCH 0
 #endif
 
 
@@ -388,37 +268,60 @@ bool CCobThread::Tick()
 
 	int r1, r2, r3, r4, r5, r6;
 
+	const uint8_t* instrs = cobFile->instrs.data();
+	const unsigned int numInstrs = cobFile->instrs.size();
+
+	#define FETCH_INSTR() ((static_cast<unsigned int>(pc) < numInstrs)? instrs[pc++]: (pc++, COB::INSTR_UNKNOWN))
+
+	#if (COB_THREADED_DISPATCH == 1)
+	static const void* dispatchTable[COB::INSTR_COUNT] = {
+		&&INSTR_UNKNOWN,
+		#define COB_INSTR_LABEL(name, value) &&INSTR_##name,
+		COB_OPCODES(COB_INSTR_LABEL)
+		#undef COB_INSTR_LABEL
+	};
+
+	// can arrive here as dead, through CCobInstance::Signal()
+	#define COB_INSTR(name) INSTR_##name:
+	#define COB_NEXT() do { if (state != Run) goto done; goto *dispatchTable[FETCH_INSTR()]; } while (false)
+
+	COB_NEXT();
+	{
+	#else
+	#define COB_INSTR(name) case COB::INSTR_##name:
+	#define COB_NEXT() continue
+
 	while (state == Run) {
-		const int opcode = GET_LONG_PC();
+		switch (FETCH_INSTR()) {
+	#endif
 
-		switch (opcode) {
-			case PUSH_CONSTANT: {
+			COB_INSTR(PUSH_CONSTANT) {
 				r1 = GET_LONG_PC();
 				PushDataStack(r1);
-			} break;
-			case SLEEP: {
+			} COB_NEXT();
+			COB_INSTR(SLEEP) {
 				r1 = PopDataStack();
 				wakeTime = cobEngine->GetCurrentTime() + r1;
 				state = Sleep;
 
 				cobEngine->ScheduleThread(this);
 				return true;
-			} break;
-			case SPIN: {
+			} COB_NEXT();
+			COB_INSTR(SPIN) {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();         // speed
 				r4 = PopDataStack();         // accel
 				cobInst->Spin(r1, r2, r3, r4);
-			} break;
-			case STOP_SPIN: {
+			} COB_NEXT();
+			COB_INSTR(STOP_SPIN) {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();         // decel
 
 				cobInst->StopSpin(r1, r2, r3);
-			} break;
-			case RETURN: {
+			} COB_NEXT();
+			COB_INSTR(RETURN) {
 				retCode = PopDataStack();
 
 				if (LocalReturnAddr() == -1) {
@@ -433,44 +336,32 @@ bool CCobThread::Tick()
 				pc = LocalReturnAddr();
 				dataStackSize = std::min(dataStackSize, LocalStackFrame());
 				callStackSize -= 1;
-			} break;
+			} COB_NEXT();
 
 
-			case SHADE: {
+			COB_INSTR(SHADE) {
 				r1 = GET_LONG_PC();
-			} break;
-			case DONT_SHADE: {
+			} COB_NEXT();
+			COB_INSTR(DONT_SHADE) {
 				r1 = GET_LONG_PC();
-			} break;
-			case CACHE: {
+			} COB_NEXT();
+			COB_INSTR(CACHE) {
 				r1 = GET_LONG_PC();
-			} break;
-			case DONT_CACHE: {
+			} COB_NEXT();
+			COB_INSTR(DONT_CACHE) {
 				r1 = GET_LONG_PC();
-			} break;
+			} COB_NEXT();
 
 
-			case CALL: {
-				r1 = GET_LONG_PC();
-				pc--;
-
-				if (cobFile->scriptNames[r1].find("lua_") == 0) {
-					cobFile->code[pc - 1] = LUA_CALL;
-					LuaCall();
-					break;
-				}
-
-				cobFile->code[pc - 1] = REAL_CALL;
-
-				// fall-through
-			}
-			case REAL_CALL: {
+			// never produced by CCobFile::DecodeInstructions
+			COB_INSTR(CALL)
+			COB_INSTR(REAL_CALL) {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
 				// do not call zero-length functions
 				if (cobFile->scriptLengths[r1] == 0)
-					break;
+					COB_NEXT();
 
 				CallInfo& ci = PushCallStackRef();
 				ci.functionId = r1;
@@ -481,30 +372,30 @@ bool CCobThread::Tick()
 
 				// call cobFile->scriptNames[r1]
 				pc = cobFile->scriptOffsets[r1];
-			} break;
-			case LUA_CALL: {
+			} COB_NEXT();
+			COB_INSTR(LUA_CALL) {
 				LuaCall();
-			} break;
+			} COB_NEXT();
 
 
-			case POP_STATIC: {
+			COB_INSTR(POP_STATIC) {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 
 				if (static_cast<size_t>(r1) < cobInst->staticVars.size())
 					cobInst->staticVars[r1] = r2;
-			} break;
-			case POP_STACK: {
+			} COB_NEXT();
+			COB_INSTR(POP_STACK) {
 				PopDataStack();
-			} break;
+			} COB_NEXT();
 
 
-			case START: {
+			COB_INSTR(START) {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
 				if (cobFile->scriptLengths[r1] == 0)
-					break;
+					COB_NEXT();
 
 
 				CCobThread t(cobInst);
@@ -515,169 +406,171 @@ bool CCobThread::Tick()
 
 				// calling AddThread directly might move <this>, defer it
 				cobEngine->QueueAddThread(std::move(t));
-			} break;
+			} COB_NEXT();
 
-			case CREATE_LOCAL_VAR: {
+			COB_INSTR(CREATE_LOCAL_VAR) {
 				if (paramCount == 0) {
 					PushDataStack(0);
 				} else {
 					paramCount--;
 				}
-			} break;
-			case GET_UNIT_VALUE: {
+			} COB_NEXT();
+			COB_INSTR(GET_UNIT_VALUE) {
 				r1 = PopDataStack();
 				if ((r1 >= LUA0) && (r1 <= LUA9)) {
 					PushDataStack(luaArgs[r1 - LUA0]);
-					break;
+					COB_NEXT();
 				}
 				r1 = cobInst->GetUnitVal(r1, 0, 0, 0, 0);
 				PushDataStack(r1);
-			} break;
+			} COB_NEXT();
 
 
-			case JUMP_NOT_EQUAL: {
+			COB_INSTR(JUMP_NOT_EQUAL) {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 
 				if (r2 == 0)
 					pc = r1;
 
-			} break;
-			case JUMP: {
+			} COB_NEXT();
+			COB_INSTR(JUMP) {
 				r1 = GET_LONG_PC();
 				// this seem to be an error in the docs..
 				//r2 = cobFile->scriptOffsets[LocalFunctionID()] + r1;
 				pc = r1;
-			} break;
+			} COB_NEXT();
 
 
-			case POP_LOCAL_VAR: {
+			COB_INSTR(POP_LOCAL_VAR) {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
-				dataStack[LocalStackFrame() + r1] = r2;
-			} break;
-			case PUSH_LOCAL_VAR: {
+
+				if (GrowDataStack(LocalStackFrame() + r1 + 1))
+					dataStack[LocalStackFrame() + r1] = r2;
+			} COB_NEXT();
+			COB_INSTR(PUSH_LOCAL_VAR) {
 				r1 = GET_LONG_PC();
-				r2 = dataStack[LocalStackFrame() + r1];
+				r2 = (static_cast<size_t>(LocalStackFrame() + r1) < dataStack.size())? dataStack[LocalStackFrame() + r1]: 0;
 				PushDataStack(r2);
-			} break;
+			} COB_NEXT();
 
 
-			case BITWISE_AND: {
+			COB_INSTR(BITWISE_AND) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 & r2);
-			} break;
-			case BITWISE_OR: {
+			} COB_NEXT();
+			COB_INSTR(BITWISE_OR) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 | r2);
-			} break;
-			case BITWISE_XOR: {
+			} COB_NEXT();
+			COB_INSTR(BITWISE_XOR) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 ^ r2);
-			} break;
-			case BITWISE_NOT: {
+			} COB_NEXT();
+			COB_INSTR(BITWISE_NOT) {
 				r1 = PopDataStack();
 				PushDataStack(~r1);
-			} break;
+			} COB_NEXT();
 
-			case EXPLODE: {
+			COB_INSTR(EXPLODE) {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 				cobInst->Explode(r1, r2);
-			} break;
+			} COB_NEXT();
 
-			case PLAY_SOUND: {
+			COB_INSTR(PLAY_SOUND) {
 				r1 = GET_LONG_PC();
 				r2 = PopDataStack();
 				cobInst->PlayUnitSound(r1, r2);
-			} break;
+			} COB_NEXT();
 
-			case PUSH_STATIC: {
+			COB_INSTR(PUSH_STATIC) {
 				r1 = GET_LONG_PC();
 
 				if (static_cast<size_t>(r1) < cobInst->staticVars.size())
 					PushDataStack(cobInst->staticVars[r1]);
-			} break;
+			} COB_NEXT();
 
-			case SET_NOT_EQUAL: {
+			COB_INSTR(SET_NOT_EQUAL) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 
 				PushDataStack(int(r1 != r2));
-			} break;
-			case SET_EQUAL: {
+			} COB_NEXT();
+			COB_INSTR(SET_EQUAL) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 
 				PushDataStack(int(r1 == r2));
-			} break;
+			} COB_NEXT();
 
-			case SET_LESS: {
+			COB_INSTR(SET_LESS) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 < r2));
-			} break;
-			case SET_LESS_OR_EQUAL: {
+			} COB_NEXT();
+			COB_INSTR(SET_LESS_OR_EQUAL) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 <= r2));
-			} break;
+			} COB_NEXT();
 
-			case SET_GREATER: {
+			COB_INSTR(SET_GREATER) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 > r2));
-			} break;
-			case SET_GREATER_OR_EQUAL: {
+			} COB_NEXT();
+			COB_INSTR(SET_GREATER_OR_EQUAL) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 >= r2));
-			} break;
+			} COB_NEXT();
 
-			case RAND: {
+			COB_INSTR(RAND) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = gsRNG.NextInt(r2 - r1 + 1) + r1;
 				PushDataStack(r3);
-			} break;
-			case EMIT_SFX: {
+			} COB_NEXT();
+			COB_INSTR(EMIT_SFX) {
 				r1 = PopDataStack();
 				r2 = GET_LONG_PC();
 				cobInst->EmitSfx(r1, r2);
-			} break;
-			case MUL: {
+			} COB_NEXT();
+			COB_INSTR(MUL) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 * r2);
-			} break;
+			} COB_NEXT();
 
 
-			case SIGNAL: {
+			COB_INSTR(SIGNAL) {
 				r1 = PopDataStack();
 				cobInst->Signal(r1);
-			} break;
-			case SET_SIGNAL_MASK: {
+			} COB_NEXT();
+			COB_INSTR(SET_SIGNAL_MASK) {
 				r1 = PopDataStack();
 				signalMask = r1;
-			} break;
+			} COB_NEXT();
 
 
-			case TURN: {
+			COB_INSTR(TURN) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = GET_LONG_PC(); // piece
 				r4 = GET_LONG_PC(); // axis
 
 				cobInst->Turn(r3, r4, r1, r2);
-			} break;
-			case GET: {
+			} COB_NEXT();
+			COB_INSTR(GET) {
 				r5 = PopDataStack();
 				r4 = PopDataStack();
 				r3 = PopDataStack();
@@ -685,24 +578,24 @@ bool CCobThread::Tick()
 				r1 = PopDataStack();
 				if ((r1 >= LUA0) && (r1 <= LUA9)) {
 					PushDataStack(luaArgs[r1 - LUA0]);
-					break;
+					COB_NEXT();
 				}
 				r6 = cobInst->GetUnitVal(r1, r2, r3, r4, r5);
 				PushDataStack(r6);
-			} break;
-			case ADD: {
+			} COB_NEXT();
+			COB_INSTR(ADD) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				PushDataStack(r1 + r2);
-			} break;
-			case SUB: {
+			} COB_NEXT();
+			COB_INSTR(SUB) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = r1 - r2;
 				PushDataStack(r3);
-			} break;
+			} COB_NEXT();
 
-			case DIV: {
+			COB_INSTR(DIV) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
@@ -713,8 +606,8 @@ bool CCobThread::Tick()
 					ShowError("division by zero");
 				}
 				PushDataStack(r3);
-			} break;
-			case MOD: {
+			} COB_NEXT();
+			COB_INSTR(MOD) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
@@ -724,31 +617,31 @@ bool CCobThread::Tick()
 					PushDataStack(0);
 					ShowError("modulo division by zero");
 				}
-			} break;
+			} COB_NEXT();
 
 
-			case MOVE: {
+			COB_INSTR(MOVE) {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r4 = PopDataStack();
 				r3 = PopDataStack();
 				cobInst->Move(r1, r2, r3, r4);
-			} break;
-			case MOVE_NOW: {
+			} COB_NEXT();
+			COB_INSTR(MOVE_NOW) {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();
 				cobInst->MoveNow(r1, r2, r3);
-			} break;
-			case TURN_NOW: {
+			} COB_NEXT();
+			COB_INSTR(TURN_NOW) {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 				r3 = PopDataStack();
 				cobInst->TurnNow(r1, r2, r3);
-			} break;
+			} COB_NEXT();
 
 
-			case WAIT_TURN: {
+			COB_INSTR(WAIT_TURN) {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
@@ -758,8 +651,8 @@ bool CCobThread::Tick()
 					waitAxis = r2;
 					return true;
 				}
-			} break;
-			case WAIT_MOVE: {
+			} COB_NEXT();
+			COB_INSTR(WAIT_MOVE) {
 				r1 = GET_LONG_PC();
 				r2 = GET_LONG_PC();
 
@@ -769,61 +662,61 @@ bool CCobThread::Tick()
 					waitAxis = r2;
 					return true;
 				}
-			} break;
+			} COB_NEXT();
 
 
-			case SET: {
+			COB_INSTR(SET) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				if ((r1 >= LUA0) && (r1 <= LUA9)) {
 					luaArgs[r1 - LUA0] = r2;
-					break;
+					COB_NEXT();
 				}
 
 				cobInst->SetUnitVal(r1, r2);
-			} break;
+			} COB_NEXT();
 
 
-			case ATTACH: {
+			COB_INSTR(ATTACH) {
 				r3 = PopDataStack();
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				cobInst->AttachUnit(r2, r1);
-			} break;
-			case DROP: {
+			} COB_NEXT();
+			COB_INSTR(DROP) {
 				r1 = PopDataStack();
 				cobInst->DropUnit(r1);
-			} break;
+			} COB_NEXT();
 
 			// like bitwise ops, but only on values 1 and 0
-			case LOGICAL_NOT: {
+			COB_INSTR(LOGICAL_NOT) {
 				r1 = PopDataStack();
 				PushDataStack(int(r1 == 0));
-			} break;
-			case LOGICAL_AND: {
+			} COB_NEXT();
+			COB_INSTR(LOGICAL_AND) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int(r1 && r2));
-			} break;
-			case LOGICAL_OR: {
+			} COB_NEXT();
+			COB_INSTR(LOGICAL_OR) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int(r1 || r2));
-			} break;
-			case LOGICAL_XOR: {
+			} COB_NEXT();
+			COB_INSTR(LOGICAL_XOR) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int((!!r1) ^ (!!r2)));
-			} break;
+			} COB_NEXT();
 
 
-			case HIDE: {
+			COB_INSTR(HIDE) {
 				r1 = GET_LONG_PC();
 				cobInst->SetVisibility(r1, false);
-			} break;
+			} COB_NEXT();
 
-			case SHOW: {
+			COB_INSTR(SHOW) {
 				r1 = GET_LONG_PC();
 
 				int i;
@@ -837,27 +730,31 @@ bool CCobThread::Tick()
 				} else {
 					cobInst->SetVisibility(r1, true);
 				}
-			} break;
+			} COB_NEXT();
 
-			default: {
+	#if (COB_THREADED_DISPATCH == 0)
+			default:
+	#endif
+			COB_INSTR(UNKNOWN) {
 				const char* name = cobFile->name.c_str();
 				const char* func = cobFile->scriptNames[LocalFunctionID()].c_str();
+				const int opcode = (static_cast<size_t>(pc - 1) < cobFile->code.size())? cobFile->code[pc - 1]: 0;
 
 				LOG_L(L_ERROR, "[COBThread::%s] unknown opcode %x (in %s:%s at %x)", __func__, opcode, name, func, pc - 1);
 
-				#if 0
-				auto ei = execTrace.begin();
-				while (ei != execTrace.end()) {
-					LOG_L(L_ERROR, "\tprogctr: %3x  opcode: %s", __func__, *ei, GetOpcodeName(cobFile->code[*ei]));
-					++ei;
-				}
-				#endif
-
 				state = Dead;
 				return false;
-			} break;
+			} COB_NEXT();
 		}
+	#if (COB_THREADED_DISPATCH == 0)
 	}
+	#else
+done:
+	#endif
+
+	#undef COB_NEXT
+	#undef COB_INSTR
+	#undef FETCH_INSTR
 
 	// can arrive here as dead, through CCobInstance::Signal()
 	return (state != Dead);
@@ -3,8 +3,10 @@
 #ifndef COB_THREAD_H
 #define COB_THREAD_H
 
+#include <algorithm>
 #include <string>
 #include <array>
+#include <vector>
 
 #include "CobInstance.h"
 #include "Lua/LuaRules.h"
@@ -23,12 +25,12 @@ public:
 	CCobThread() {}
 
 	CCobThread(CCobInstance* _cobInst);
-	CCobThread(CCobThread&& t) { *this = std::move(t); }
+	CCobThread(CCobThread&& t) noexcept { *this = std::move(t); }
 	CCobThread(const CCobThread& t) { *this = t; }
 
-	~CCobThread() { Stop(); }
+	~CCobThread() { Stop(); ReleaseStacks(); }
 
-	CCobThread& operator = (CCobThread&& t);
+	CCobThread& operator = (CCobThread&& t) noexcept;
 	CCobThread& operator = (const CCobThread& t);
 
 	enum State {Init, Sleep, Run, Dead, WaitTurn, WaitMove};
@@ -45,6 +47,9 @@ public:
 	void Start(int functionId, int sigMask, const std::array<int, 1 + MAX_COB_ARGS>& args, bool schedule);
 	void Stop();
 
+	/// frees the recycled stack buffers of all dead threads
+	static void FreeStackPool() { stackPool = {}; }
+
 	void SetID(int threadID) { id = threadID; }
 	void SetState(State s) { state = s; }
 
@@ -107,14 +112,42 @@ protected:
 
 	void LuaCall();
 
-	bool PushCallStack(CallInfo v) { return (callStackSize < callStack.size() && PushCallStackRaw(v)); }
-	bool PushDataStack(     int v) { return (dataStackSize < dataStack.size() && PushDataStackRaw(v)); }
+	// stacks start small and double on demand up to these limits
+	static constexpr int MAX_CALL_STACK_SIZE = 64;
+	static constexpr int MAX_DATA_STACK_SIZE = 1024;
+	static constexpr int MIN_CALL_STACK_SIZE = 4;
+	static constexpr int MIN_DATA_STACK_SIZE = 16;
+
+	void AcquireStacks();
+	void ReleaseStacks();
+
+	bool GrowCallStack(unsigned int n) {
+		if (n <= callStack.size())
+			return true;
+		if (n > MAX_CALL_STACK_SIZE)
+			return false;
+
+		callStack.resize(std::min(std::max(n, unsigned(callStack.size() * 2)), unsigned(MAX_CALL_STACK_SIZE)));
+		return true;
+	}
+	bool GrowDataStack(unsigned int n) {
+		if (n <= dataStack.size())
+			return true;
+		if (n > MAX_DATA_STACK_SIZE)
+			return false;
+
+		dataStack.resize(std::min(std::max(n, unsigned(dataStack.size() * 2)), unsigned(MAX_DATA_STACK_SIZE)), 0);
+		return true;
+	}
+
+	bool PushCallStack(CallInfo v) { return (GrowCallStack(callStackSize + 1) && PushCallStackRaw(v)); }
+	bool PushDataStack(     int v) { return (GrowDataStack(dataStackSize + 1) && PushDataStackRaw(v)); }
 
 	bool PushCallStackRaw(CallInfo v) { assert(callStackSize < callStack.size()); callStack[callStackSize++] = v; return true; }
 	bool PushDataStackRaw(     int v) { assert(dataStackSize < dataStack.size()); dataStack[dataStackSize++] = v; return true; }
 
 	CallInfo& PushCallStackRef() {
-		if (callStackSize < callStack.size())
+		if (GrowCallStack(callStackSize + 1))
 			return (PushCallStackRefRaw());
 		return callStack[0];
 	}
@@ -155,13 +188,23 @@ protected:
 	int luaArgs[MAX_LUA_COB_ARGS] = {0};
 
 
-	std::array<CallInfo, 64> callStack;
-	std::array<int, 1024> dataStack;
+	// both are taken from (and returned to) stackPool, so most
+	// threads never allocate and moving a thread is a pointer swap
+	std::vector<CallInfo> callStack;
+	std::vector<int> dataStack;
 	// std::vector<int> execTrace;
 
 	State state = Init;
 
 	CCobInstance::ThreadCallbackType cbType = CCobInstance::CBNone;
+
+private:
+	struct StackPool {
+		std::vector< std::vector<CallInfo> > callStacks;
+		std::vector< std::vector<int> > dataStacks;
+	};
+
+	static StackPool stackPool;
 };
 
 #endif // COB_THREAD_H
@@ -53,6 +53,7 @@ CR_REG_METADATA(CUnitScript, (
 	CR_MEMBER(unit),
 	CR_MEMBER(busy),
 	CR_MEMBER(anims),
+	CR_IGNORED(doneAnims),
 
 	//Populated by children
 	CR_IGNORED(pieces),
@@ -86,7 +87,7 @@ CUnitScript::CUnitScript(CUnit* unit)
 CUnitScript::~CUnitScript()
 {
 	// Remove us from possible animation ticking
-	if (!HaveAnimations())
+	if (!HaveAnimations() && !HaveFinishedAnimations())
 		return;
 
 	unitScriptEngine->RemoveInstance(this);
@@ -199,16 +200,22 @@ void CUnitScript::TickAnims(int tickRate, const TickAnimFunc& tickAnimFunc, Anim
  */
 bool CUnitScript::Tick(int deltaTime)
 {
-	// vector of indexes of finished animations,
-	// so we can get rid of them in constant time
-	static AnimContainerType doneAnims[AMove + 1];
+	TickAnimations(deltaTime);
+	return (FinishAnimations());
+}
+
+void CUnitScript::TickAnimations(int deltaTime)
+{
 	// tick-functions; these never change address
 	static constexpr TickAnimFunc tickAnimFuncs[AMove + 1] = {&CUnitScript::TickTurnAnim, &CUnitScript::TickSpinAnim, &CUnitScript::TickMoveAnim};
 
 	for (int animType = ATurn; animType <= AMove; animType++) {
 		TickAnims(1000 / deltaTime, tickAnimFuncs[animType], anims[animType], doneAnims[animType]);
 	}
+}
 
+bool CUnitScript::FinishAnimations()
+{
 	// Tell listeners to unblock, and remove finished animations from the unit/script.
 	for (int animType = ATurn; animType <= AMove; animType++) {
 		for (AnimInfo& ai: doneAnims[animType]) {
@@ -247,7 +254,9 @@ void CUnitScript::RemoveAnim(AnimType type, const AnimContainerTypeIt& animInfoI
 
 	// If this was the last animation, remove from currently animating list
 	// FIXME: this could be done in a cleaner way
-	if (HaveAnimations())
+	// finished animations that are still waiting to be delivered keep us in
+	// the list, UnitScriptEngine removes us once FinishAnimations has run
+	if (HaveAnimations() || HaveFinishedAnimations())
 		return;
 
 	unitScriptEngine->RemoveInstance(this);
@@ -43,6 +43,9 @@ protected:
 	typedef bool(CUnitScript::*TickAnimFunc)(int, LocalModelPiece&, AnimInfo&);
 
 	AnimContainerType anims[AMove + 1];
+	// finished animations with waiting listeners, filled by TickAnimations
+	// and drained by FinishAnimations; always empty between sim-frames
+	AnimContainerType doneAnims[AMove + 1];
 
 
 	bool hasSetSFXOccupy;
@@ -106,7 +109,13 @@ public:
 	      CUnit* GetUnit()       { return unit; }
 	const CUnit* GetUnit() const { return unit; }
 
-	bool Tick(int tickRate);
+	bool Tick(int deltaTime);
+	// Tick is split into these two for CUnitScriptEngine; the first only
+	// touches this script's own pieces and may run concurrently with the
+	// same call on other scripts, the second must be called serially
+	void TickAnimations(int deltaTime);
+	bool FinishAnimations();
+
 	// note: must copy-and-set here (LMP dirty flag, etc)
 	bool TickMoveAnim(int tickRate, LocalModelPiece& lmp, AnimInfo& ai) { float3 pos = lmp.GetPosition(); const bool ret = MoveToward(pos[ai.axis], ai.dest, ai.speed / tickRate); lmp.SetPosition(pos); return ret; }
 	bool TickTurnAnim(int tickRate, LocalModelPiece& lmp, AnimInfo& ai) { float3 rot = lmp.GetRotation(); const bool ret = TurnToward(rot[ai.axis], ai.dest, ai.speed / tickRate); lmp.SetRotation(rot); return ret; }
@@ -144,6 +153,9 @@ public:
 	bool HaveAnimations() const {
 		return (!anims[ATurn].empty() || !anims[ASpin].empty() || !anims[AMove].empty());
 	}
+	bool HaveFinishedAnimations() const {
+		return (!doneAnims[ATurn].empty() || !doneAnims[ASpin].empty() || !doneAnims[AMove].empty());
+	}
 
 	// checks for callin existence
 	bool HasSetSFXOccupy () const { return hasSetSFXOccupy; }
@@ -13,6 +13,7 @@
 #include "Sim/Units/UnitHandler.h"
 #include "System/ContainerUtil.h"
 #include "System/SafeUtil.h"
+#include "System/Threading/ThreadPool.h"
 
 static CCobEngine gCobEngine;
 static CCobFileHandler gCobFileHandler;
@@ -118,11 +119,20 @@ void CUnitScriptEngine::Tick(int deltaTime)
 {
 	cobEngine->Tick(deltaTime);
 
-	// tick all (COB or LUS) script instances that have registered themselves as animating
+	// advance the piece animations of all (COB or LUS) script instances that have
+	// registered themselves as animating; each only writes to its own LocalModel
+	// pieces and done-lists so this can be spread over the thread-pool
+	for_mt(0, animating.size(), [&](const int i) {
+		animating[i]->TickAnimations(deltaTime);
+	});
+
+	// deliver AnimFinished events serially and in list order; callins can add or
+	// remove (and even destroy) instances so this has to be index-based, scripts
+	// added here will not have been ticked and start animating next frame
 	for (size_t i = 0; i < animating.size(); ) {
 		currentScript = animating[i];
 
-		if (!currentScript->Tick(deltaTime)) {
+		if (!currentScript->FinishAnimations()) {
 			animating[i] = animating.back();
 			animating.pop_back();
 			continue;
@@ -133,4 +143,3 @@ void CUnitScriptEngine::Tick(int deltaTime)
 
 	currentScript = nullptr;
 }
-
@@ -244,6 +244,9 @@ void CUnit::PreInit(const UnitLoadParams& params)
 	SetRadiusAndHeight(model);
 	UpdateMidAndAimPos();
 
+	// must be known when the unit is added to its team's aggregates
+	beingBuilt = params.beingBuilt;
+
 	unitHandler.AddUnit(this);
 	quadField.MovedUnit(this);
 
@@ -253,7 +256,6 @@ void CUnit::PreInit(const UnitLoadParams& params)
 
 	footprint = int2(unitDef->xsize, unitDef->zsize);
 
-	beingBuilt = params.beingBuilt;
 	mass = (beingBuilt)? mass: unitDef->mass;
 	crushResistance = unitDef->crushResistance;
 	power = unitDef->power;
@@ -399,7 +401,11 @@ void CUnit::FinishedBuilding(bool postInit)
 	if (!beingBuilt && !postInit)
 		return;
 
+	TeamAggregates& teamAggregates = teamHandler.Team(team)->unitAggregates;
+
+	teamAggregates.UpdateUnitBuildState(this, -1);
 	beingBuilt = false;
+	teamAggregates.UpdateUnitBuildState(this, +1);
 	buildProgress = 1.0f;
 	mass = unitDef->mass;
 
@@ -797,6 +803,9 @@ void CUnit::TransporteeKilled(const CObject* o)
 
 void CUnit::UpdateResources()
 {
+	const SResourcePack prevMake = resourcesMake;
+	const SResourcePack prevUse = resourcesUse;
+
 	resourcesMake.metal  = resourcesMakeI.metal  + resourcesMakeOld.metal;
 	resourcesUse.metal   = resourcesUseI.metal   + resourcesUseOld.metal;
 	resourcesMake.energy = resourcesMakeI.energy + resourcesMakeOld.energy;
@@ -808,6 +817,14 @@ void CUnit::UpdateResources()
 	resourcesUseOld.energy  = resourcesUseI.energy;
 
 	resourcesMakeI.metal = resourcesUseI.metal = resourcesMakeI.energy = resourcesUseI.energy = 0.0f;
+
+	SResourcePack deltaMake = resourcesMake;
+	SResourcePack deltaUse = resourcesUse;
+
+	deltaMake -= prevMake;
+	deltaUse -= prevUse;
+
+	teamHandler.Team(team)->unitAggregates.UpdateUnitResources(deltaMake, deltaUse);
 }
 
 void CUnit::SetLosStatus(int at, unsigned short newStatus)
@@ -856,7 +873,7 @@ void CUnit::SetLosStatus(int at, unsigned short newStatus)
 }
 
 
-unsigned short CUnit::CalcLosStatus(int at)
+unsigned short CUnit::CalcLosStatus(int at) const
 {
 	const unsigned short currStatus = losStatus[at];
 
@@ -1975,7 +1992,12 @@ bool CUnit::AddBuildPower(CUnit* builder, float amount)
 
 		// turn reclaimee into nanoframe (even living units)
 		if ((modInfo.reclaimUnitMethod == 0) && !beingBuilt) {
+			TeamAggregates& teamAggregates = teamHandler.Team(team)->unitAggregates;
+
+			teamAggregates.UpdateUnitBuildState(this, -1);
 			beingBuilt = true;
+			teamAggregates.UpdateUnitBuildState(this, +1);
+
 			SetMetalStorage(0);
 			SetEnergyStorage(0);
 			eventHandler.UnitReverseBuilt(this);
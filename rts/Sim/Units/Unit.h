@@ -76,6 +76,10 @@ public:
 	virtual void DoWaterDamage();
 	virtual void FinishedBuilding(bool postInit);
 
+	// build-speed (in UnitDef units) this unit adds to TeamAggregates
+	virtual float GetBuildPower() const { return 0.0f; }
+	virtual bool IsUsingBuildPower() const { return false; }
+
 	void ApplyDamage(CUnit* attacker, const DamageArray& damages, float& baseDamage, float& experienceMod);
 	void ApplyImpulse(const float3& impulse);
 
@@ -176,7 +180,7 @@ public:
 	bool IsInLosForAllyTeam(int allyTeam) const { return ((losStatus[allyTeam] & LOS_INLOS) != 0); }
 
 	void SetLosStatus(int allyTeam, unsigned short newStatus);
-	unsigned short CalcLosStatus(int allyTeam);
+	unsigned short CalcLosStatus(int allyTeam) const;
 	void UpdateLosStatus(int allyTeam);
 
 	void UpdateWeapons();
@@ -296,7 +300,7 @@ public:
 
 
 	// sufficient for the largest UnitScript (CLuaUnitScript)
-	uint8_t usMemBuffer[368];
+	uint8_t usMemBuffer[440];
 	// sufficient for the largest AMoveType (CGroundMoveType)
 	// need two buffers since ScriptMoveType might be enabled
 	uint8_t amtMemBuffer[498];
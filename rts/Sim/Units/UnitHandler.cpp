@@ -12,13 +12,16 @@
 
 #include "CommandAI/BuilderCAI.h"
 #include "Sim/Misc/GlobalSynced.h"
+#include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/TeamHandler.h"
+#include "Sim/MoveTypes/GroundMoveType.h"
 #include "Sim/MoveTypes/MoveType.h"
 #include "Sim/Weapons/Weapon.h"
 #include "System/EventHandler.h"
 #include "System/Log/ILog.h"
 #include "System/SpringMath.h"
 #include "System/TimeProfiler.h"
+#include "System/Threading/ThreadPool.h"
 #include "System/creg/STL_Deque.h"
 #include "System/creg/STL_Set.h"
 
@@ -31,6 +34,8 @@ CR_REG_METADATA(CUnitHandler, (
 	CR_MEMBER(unitsByDefs),
 	CR_MEMBER(activeUnits),
 	CR_MEMBER(unitsToBeRemoved),
+	CR_IGNORED(losUpdateUnits),
+	CR_IGNORED(losUpdateStates),
 
 	CR_MEMBER(builderCAIs),
 
@@ -319,15 +324,61 @@ void CUnitHandler::UpdateUnitMoveTypes()
 		unit->SanityCheck();
 		assert(activeUnits[activeUpdateUnit] == unit);
 	}
+
+	if (modInfo.allowUnitCollisionPass)
+		CGroundMoveType::HandleUnitCollisionPass(activeUnits);
 }
 
 void CUnitHandler::UpdateUnitLosStates()
 {
-	for (CUnit* unit: activeUnits) {
-		for (int at = 0; at < teamHandler.ActiveAllyTeams(); ++at) {
-			unit->UpdateLosStatus(at);
+	const int numAllyTeams = teamHandler.ActiveAllyTeams();
+
+	// the Entered/Left callins can create units (which are inserted at random
+	// positions), so work on a copy; deletion is deferred to the next update
+	losUpdateUnits.assign(activeUnits.begin(), activeUnits.end());
+	losUpdateStates.resize(losUpdateUnits.size() * numAllyTeams);
+
+	// first evaluate the new status of each unit for every allyteam; this
+	// only reads the LOS-maps and unit state so can be done in parallel
+	for_mt(0, losUpdateUnits.size(), [&](const int i) {
+		const CUnit* unit = losUpdateUnits[i];
+
+		for (int at = 0; at < numAllyTeams; ++at) {
+			UnitLosState& state = losUpdateStates[i * numAllyTeams + at];
+
+			state.currStatus = unit->losStatus[at];
+			state.nextStatus = state.currStatus;
+
+			// no need to update if all changes are masked
+			if ((state.currStatus & LOS_ALL_MASK_BITS) == LOS_ALL_MASK_BITS)
+				continue;
+
+			state.nextStatus = unit->CalcLosStatus(at);
+		}
+	});
+
+	// then apply the transitions and fire their events in canonical order
+	for (size_t i = 0, n = losUpdateUnits.size(); i < n; i++) {
+		CUnit* unit = losUpdateUnits[i];
+
+		for (int at = 0; at < numAllyTeams; ++at) {
+			const UnitLosState& state = losUpdateStates[i * numAllyTeams + at];
+
+			// status was changed by an earlier callin (e.g. SetUnitLosMask),
+			// the precomputed result is stale so re-evaluate it right here
+			if (unit->losStatus[at] != state.currStatus) {
+				unit->UpdateLosStatus(at);
+				continue;
+			}
+
+			if (state.nextStatus == state.currStatus)
+				continue;
+
+			unit->SetLosStatus(at, state.nextStatus);
 		}
 	}
+
+	losUpdateUnits.clear();
 }
 
 
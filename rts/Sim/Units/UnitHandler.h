@@ -94,6 +94,14 @@ private:
 	std::vector<CUnit*> activeUnits;                                     ///< used to get all active units
 	std::vector<CUnit*> unitsToBeRemoved;                                ///< units that will be removed at start of next update
 
+	struct UnitLosState {
+		unsigned char currStatus;
+		unsigned char nextStatus;
+	};
+
+	std::vector<CUnit*> losUpdateUnits;                                  ///< snapshot of activeUnits taken by UpdateUnitLosStates
+	std::vector<UnitLosState> losUpdateStates;                           ///< per {unit, allyteam} LOS-states computed by UpdateUnitLosStates
+
 	spring::unordered_map<unsigned int, CBuilderCAI*> builderCAIs;
 
 
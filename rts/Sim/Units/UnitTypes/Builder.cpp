@@ -55,7 +55,8 @@ CR_REG_METADATA(CBuilder, (
 	CR_MEMBER(terraformCenter),
 	CR_MEMBER(terraformRadius),
 	CR_MEMBER(terraformType),
-	CR_MEMBER(nanoPieceCache)
+	CR_MEMBER(nanoPieceCache),
+	CR_MEMBER(usingBuildPower)
 ))
 
 
@@ -89,7 +90,8 @@ CBuilder::CBuilder():
 	tz1(0),
 	tz2(0),
 	terraformCenter(ZeroVector),
-	terraformRadius(0)
+	terraformRadius(0),
+	usingBuildPower(false)
 {
 }
 
@@ -432,8 +434,14 @@ bool CBuilder::UpdateResurrect(const Command& fCommand)
 		// TODO: make configurable if this should happen
 		resurrectee->health *= 0.05f;
 
-		for (const int resurrecterID: cai->resurrecters) {
+		// the loop changes commands, which can drop claims; iterate a copy
+		for (const int resurrecterID: cai->resurrecters.GetUnits(curResurrectee->id + unitHandler.MaxUnits())) {
 			CBuilder* resurrecter = static_cast<CBuilder*>(unitHandler.GetUnit(resurrecterID));
+
+			// claims are dropped lazily
+			if (resurrecter == nullptr)
+				continue;
+
 			CCommandAI* resurrecterCAI = resurrecter->commandAI;
 
 			if (resurrecterCAI->commandQue.empty())
@@ -540,9 +548,26 @@ void CBuilder::Update()
 		updated = updated || UpdateCapture(fCommand);
 	}
 
+	UpdateBuildPowerUse();
 	CUnit::Update();
 }
 
+void CBuilder::UpdateBuildPowerUse()
+{
+	const bool inUse = (curBuild != nullptr || curReclaim != nullptr || curResurrect != nullptr || curCapture != nullptr || terraforming || helpTerraform != nullptr);
+
+	if (inUse == usingBuildPower)
+		return;
+
+	usingBuildPower = inUse;
+	teamHandler.Team(team)->unitAggregates.UpdateUnitBuildPowerUse(this, inUse);
+}
+
+float CBuilder::GetBuildPower() const
+{
+	return (buildSpeed * TEAM_SLOWUPDATE_RATE);
+}
+
 
 void CBuilder::SlowUpdate()
 {
@@ -58,6 +58,9 @@ public:
 	bool CanAssistUnit(const CUnit* u, const UnitDef* def = nullptr) const;
 	bool CanRepairUnit(const CUnit* u) const;
 
+	float GetBuildPower() const override;
+	bool IsUsingBuildPower() const override { return usingBuildPower; }
+
 	const NanoPieceCache& GetNanoPieceCache() const { return nanoPieceCache; }
 	      NanoPieceCache& GetNanoPieceCache()       { return nanoPieceCache; }
 
@@ -91,8 +94,14 @@ public:
 	float3 terraformCenter;
 	float terraformRadius;
 
+private:
+	void UpdateBuildPowerUse();
+
 private:
 	NanoPieceCache nanoPieceCache;
+
+	// whether our build-power is counted as used by TeamAggregates
+	bool usingBuildPower;
 };
 
 #endif // _BUILDER_H
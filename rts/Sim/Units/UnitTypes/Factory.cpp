@@ -34,7 +34,8 @@ CR_REG_METADATA(CFactory, (
 	CR_MEMBER(curBuildDef),
 	CR_MEMBER(curBuild),
 	CR_MEMBER(finishedBuildCommand),
-	CR_MEMBER(nanoPieceCache)
+	CR_MEMBER(nanoPieceCache),
+	CR_MEMBER(usingBuildPower)
 ))
 
 //////////////////////////////////////////////////////////////////////
@@ -46,7 +47,8 @@ CFactory::CFactory():
 	buildSpeed(100.0f),
 	curBuild(nullptr),
 	curBuildDef(nullptr),
-	lastBuildUpdateFrame(-1)
+	lastBuildUpdateFrame(-1),
+	usingBuildPower(false)
 {
 }
 
@@ -79,10 +81,20 @@ float3 CFactory::CalcBuildPos(int buildPiece)
 
 
 
+float CFactory::GetBuildPower() const
+{
+	return (buildSpeed * TEAM_SLOWUPDATE_RATE);
+}
+
 void CFactory::Update()
 {
 	nanoPieceCache.Update();
 
+	if (usingBuildPower != (curBuild != nullptr)) {
+		usingBuildPower = (curBuild != nullptr);
+		teamHandler.Team(team)->unitAggregates.UpdateUnitBuildPowerUse(this, usingBuildPower);
+	}
+
 	if (beingBuilt) {
 		// factory is under construction, cannot build anything yet
 		CUnit::Update();
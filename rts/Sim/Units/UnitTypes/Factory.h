@@ -38,6 +38,9 @@ public:
 	void PreInit(const UnitLoadParams& params);
 	bool ChangeTeam(int newTeam, ChangeType type);
 
+	float GetBuildPower() const override;
+	bool IsUsingBuildPower() const override { return usingBuildPower; }
+
 	const NanoPieceCache& GetNanoPieceCache() const { return nanoPieceCache; }
 	      NanoPieceCache& GetNanoPieceCache()       { return nanoPieceCache; }
 
@@ -63,6 +66,9 @@ private:
 	Command finishedBuildCommand;
 
 	NanoPieceCache nanoPieceCache;
+
+	// whether our build-power is counted as used by TeamAggregates
+	bool usingBuildPower;
 };
 
 #endif // _FACTORY_H
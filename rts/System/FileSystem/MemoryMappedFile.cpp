@@ -0,0 +1,104 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "MemoryMappedFile.h"
+
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#else
+	#include <windows.h>
+#endif
+
+
+
+bool CMemoryMappedFile::Open(const std::string& filePath)
+{
+	Close();
+
+	#ifndef _WIN32
+	const int fd = open(filePath.c_str(), O_RDONLY);
+
+	if (fd == -1)
+		return false;
+
+	struct stat info;
+
+	if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+		close(fd);
+		return false;
+	}
+
+	void* ptr = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// the mapping keeps its own reference to the file
+	close(fd);
+
+	if (ptr == MAP_FAILED)
+		return false;
+
+	// contents are normally consumed front to back
+	madvise(ptr, info.st_size, MADV_SEQUENTIAL);
+
+	data = static_cast<const std::uint8_t*>(ptr);
+	size = info.st_size;
+
+	#else
+
+	HANDLE fh = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (fh == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+
+	if (!GetFileSizeEx(fh, &fileSize) || fileSize.QuadPart <= 0) {
+		CloseHandle(fh);
+		return false;
+	}
+
+	HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (mh == nullptr) {
+		CloseHandle(fh);
+		return false;
+	}
+
+	void* ptr = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+
+	if (ptr == nullptr) {
+		CloseHandle(mh);
+		CloseHandle(fh);
+		return false;
+	}
+
+	fileHandle = fh;
+	mappingHandle = mh;
+
+	data = static_cast<const std::uint8_t*>(ptr);
+	size = fileSize.QuadPart;
+	#endif
+
+	return true;
+}
+
+void CMemoryMappedFile::Close()
+{
+	if (data == nullptr)
+		return;
+
+	#ifndef _WIN32
+	munmap(const_cast<std::uint8_t*>(data), size);
+	#else
+	UnmapViewOfFile(data);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+	#endif
+
+	data = nullptr;
+	size = 0;
+}
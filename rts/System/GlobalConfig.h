@@ -82,6 +82,14 @@ public:
 	 */
 	int linkIncomingMaxWaitingPackets = 512;
 
+	/**
+	 * @brief networkCompression
+	 *
+	 * Whether to ask the other end of a connection to deflate the
+	 * reliable chunk stream, and to do so when asked
+	 */
+	bool networkCompression = false;
+
 
 	/**
 	 * @brief useNetMessageSmoothingBuffer
@@ -14,7 +14,9 @@
 #include "Game/WaitCommandsAI.h"
 #include "Game/UI/Groups/GroupHandler.h"
 #include "Lua/LuaGaia.h"
+#include "Lua/LuaMessageBuffers.h"
 #include "Lua/LuaRules.h"
+#include "Lua/LuaRulesParams.h"
 #include "Net/GameServer.h"
 #include "Rendering/Textures/ColorMap.h"
 #include "Sim/Features/FeatureHandler.h"
@@ -33,6 +35,7 @@
 #include "Sim/Units/Scripts/UnitScriptEngine.h"
 #include "Sim/Units/Scripts/NullUnitScript.h"
 #include "Sim/Weapons/PlasmaRepulser.h"
+#include "System/ObjectDependenceRegistry.h"
 #include "System/SafeUtil.h"
 #include "System/Platform/errorhandler.h"
 #include "System/FileSystem/DataDirsAccess.h"
@@ -71,6 +74,8 @@ CR_REG_METADATA(CGameStateCollector, (
 
 void CGameStateCollector::Serialize(creg::ISerializer* s)
 {
+	// before any object whose rules-params refer to the interned names
+	LuaRulesParams::SerializeKeys(s);
 	s->SerializeObjectInstance(gs, gs->GetClass());
 	s->SerializeObjectInstance(gu, gu->GetClass());
 	s->SerializeObjectInstance(gameSetup, gameSetup->GetClass());
@@ -89,6 +94,8 @@ void CGameStateCollector::Serialize(creg::ISerializer* s)
 	s->SerializeObjectInstance(&projectileHandler, projectileHandler.GetClass());
 	CPlasmaRepulser::SerializeShieldSegmentCollectionPool(s);
 	CColorMap::SerializeColorMaps(s);
+	LuaMessageBuffers::SerializeBuffers(s);
+	CObjectDependenceRegistry::SerializeRegistry(s);
 	s->SerializeObjectInstance(&waitCommandsAI, waitCommandsAI.GetClass());
 	s->SerializeObjectInstance(&envResHandler, envResHandler.GetClass());
 	s->SerializeObjectInstance(&moveDefHandler, moveDefHandler.GetClass());
@@ -13,6 +13,10 @@
 #include <string>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
 #include <vector>
 
 
@@ -120,10 +124,7 @@ namespace log_file {
 		return (!getLogFiles().empty());
 	}
 
-	void writeToFile(FILE* outStream, const char* record, bool flush) {
-		char framePrefix[128] = {'\0'};
-		log_framePrefixer_createPrefix(framePrefix, sizeof(framePrefix));
-
+	void writeToFile(FILE* outStream, const char* framePrefix, const char* record, bool flush) {
 		FPRINTF(outStream, "%s%s\n", framePrefix, record);
 
 		if (flush)
@@ -132,18 +133,26 @@ namespace log_file {
 
 	/**
 	 * Writes to the individual log files, if they do want to log the section.
+	 * The prefix is created once here unless the caller already made one.
 	 */
-	void writeToFiles(int level, const char* section, const char* record)
+	void writeToFiles(int level, const char* section, const char* record, const char* prefix = nullptr)
 	{
 		const auto& logFiles = getLogFiles();
 
+		char framePrefix[128] = {'\0'};
+
+		if (prefix == nullptr) {
+			log_framePrefixer_createPrefix(framePrefix, sizeof(framePrefix));
+			prefix = framePrefix;
+		}
+
 		for (const auto& p: logFiles) {
 			if (!p.second.IsLogging(level, section))
 				continue;
 			if (p.second.GetOutStream() == nullptr)
 				continue;
 
-			writeToFile(p.second.GetOutStream(), record, p.second.FlushOnWrite(level));
+			writeToFile(p.second.GetOutStream(), prefix, record, p.second.FlushOnWrite(level));
 		}
 	}
 
@@ -184,6 +193,205 @@ namespace log_file {
 
 		logRecords.emplace_back(level, section, record);
 	}
+
+
+	/**
+	 * Bounded lock-free multi-producer single-consumer ring of records.
+	 * Logging threads create the frame prefix and copy the record into a
+	 * claimed slot (whose string keeps its capacity between uses), and a
+	 * background thread batches the actual file writes.
+	 */
+	struct AsyncRecordWriter {
+	public:
+		~AsyncRecordWriter() { Stop(); }
+
+		void Start(unsigned int numRecords, bool dropRecords) {
+			Stop();
+
+			unsigned int ringSize = 1;
+
+			// round up to a power of two so positions can be masked
+			while (ringSize < numRecords)
+				ringSize <<= 1;
+
+			slots.reset(new Slot[ringSize]);
+			slotMask = ringSize - 1;
+			dropOnOverflow = dropRecords;
+
+			for (unsigned int i = 0; i < ringSize; i++) {
+				slots[i].seq.store(i, std::memory_order_relaxed);
+			}
+
+			enqPos.store(0, std::memory_order_relaxed);
+			deqPos = 0;
+
+			running.store(true, std::memory_order_release);
+			writerThread = std::thread([this]() { WriterLoop(); });
+		}
+
+		void Stop() {
+			if (!writerThread.joinable())
+				return;
+
+			running.store(false, std::memory_order_release);
+			writerThread.join();
+
+			// catch anything pushed while the thread was shutting down
+			Drain(0);
+		}
+
+		bool IsRunning() const { return (running.load(std::memory_order_acquire)); }
+
+		void Push(int level, const char* section, const char* record) {
+			size_t pos = enqPos.load(std::memory_order_relaxed);
+
+			while (true) {
+				Slot& slot = slots[pos & slotMask];
+
+				const size_t seq = slot.seq.load(std::memory_order_acquire);
+				const intptr_t dif = intptr_t(seq) - intptr_t(pos);
+
+				if (dif == 0) {
+					if (enqPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+
+					continue;
+				}
+
+				if (dif > 0) {
+					pos = enqPos.load(std::memory_order_relaxed);
+					continue;
+				}
+
+				// ring is full
+				if (dropOnOverflow) {
+					numDropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				std::this_thread::yield();
+				pos = enqPos.load(std::memory_order_relaxed);
+			}
+
+			Slot& slot = slots[pos & slotMask];
+
+			log_framePrefixer_createPrefix(slot.prefix, sizeof(slot.prefix));
+
+			slot.level = level;
+			slot.section.assign(section);
+			slot.record.assign(record);
+			slot.seq.store(pos + 1, std::memory_order_release);
+		}
+
+		/**
+		 * Only one thread can consume at a time, and the log-files list
+		 * must not change while it does. Tries to take the consumer flag
+		 * at most <maxTries> times (0 means until it succeeds).
+		 */
+		bool LockConsumer(unsigned int maxTries) {
+			for (unsigned int n = 1; consuming.test_and_set(std::memory_order_acquire); n++) {
+				if (maxTries != 0 && n >= maxTries)
+					return false;
+
+				std::this_thread::yield();
+			}
+
+			return true;
+		}
+
+		void UnlockConsumer() { consuming.clear(std::memory_order_release); }
+
+		/**
+		 * Writes out all published records from the calling thread.
+		 * Returns false if another thread held the consumer flag for
+		 * all of <maxTries> attempts (see LockConsumer).
+		 */
+		bool Drain(unsigned int maxTries) {
+			if (slots == nullptr)
+				return true;
+
+			if (!LockConsumer(maxTries))
+				return false;
+
+			size_t numWritten = 0;
+
+			for (Slot* slot = &slots[deqPos & slotMask]; slot->seq.load(std::memory_order_acquire) == (deqPos + 1); slot = &slots[deqPos & slotMask]) {
+				writeToFiles(slot->level, slot->section.c_str(), slot->record.c_str(), slot->prefix);
+
+				slot->seq.store(deqPos + slotMask + 1, std::memory_order_release);
+				deqPos += 1;
+				numWritten += 1;
+			}
+
+			const size_t numLost = numDropped.exchange(0, std::memory_order_relaxed);
+
+			if (numLost > 0) {
+				char lostRecord[128];
+				SNPRINTF(lostRecord, sizeof(lostRecord), "[AsyncRecordWriter] %u log records dropped (ring full)", unsigned(numLost));
+				writeToFiles(LOG_LEVEL_WARNING, "", lostRecord);
+			}
+
+			UnlockConsumer();
+			return true;
+		}
+
+	private:
+		void WriterLoop() {
+			while (IsRunning()) {
+				Drain(1);
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			}
+		}
+
+	private:
+		struct Slot {
+			std::atomic<size_t> seq = {0};
+
+			int level = 0;
+
+			// copied like the record, sections need not outlive the call
+			// (e.g. those passed by Spring.Log are owned by Lua)
+			std::string section;
+
+			char prefix[128] = {'\0'};
+			std::string record;
+		};
+
+		std::unique_ptr<Slot[]> slots;
+		std::thread writerThread;
+
+		std::atomic<size_t> enqPos = {0};
+		std::atomic<size_t> numDropped = {0};
+		std::atomic<bool> running = {false};
+		std::atomic_flag consuming = ATOMIC_FLAG_INIT;
+
+		size_t deqPos = 0;
+		size_t slotMask = 0;
+
+		bool dropOnOverflow = false;
+	};
+
+
+	/**
+	 * Constructed after (and hence destructed before) the log-files
+	 * container, so the writer can still drain into open files at exit.
+	 */
+	inline AsyncRecordWriter& getAsyncWriter() {
+		static AsyncRecordWriter asyncWriter;
+		return asyncWriter;
+	}
+
+	std::atomic<bool> asyncWriting = {false};
+
+
+	/**
+	 * Keeps the writer thread out of the log-files list while it is
+	 * being modified; must not be held while logging.
+	 */
+	struct LogFilesGuard {
+		LogFilesGuard() { getAsyncWriter().LockConsumer(0); }
+		~LogFilesGuard() { getAsyncWriter().UnlockConsumer(); }
+	};
 }
 
 
@@ -220,6 +428,8 @@ void log_file_addLogFile(
 
 	setvbuf(tmpStream, nullptr, _IOFBF, std::min(BUFSIZ, 8192)); // limit buffer to 8kB
 
+	log_file::LogFilesGuard guard;
+
 	logFiles.emplace_back(filePathStr, log_file::LogFileDetails(tmpStream, sectionsStr, minLevel, flushLevel));
 
 	// swap into position; only a handful of files are ever added
@@ -243,6 +453,8 @@ void log_file_removeLogFile(const char* filePath) {
 	if (iter == logFiles.end() || strcmp(iter->first.c_str(), filePath) != 0)
 		return;
 
+	log_file::LogFilesGuard guard;
+
 	// turn off logging to this file
 	fclose(iter->second.GetOutStream());
 
@@ -258,6 +470,8 @@ void log_file_removeLogFile(const char* filePath) {
 void log_file_removeAllLogFiles() {
 	auto& logFiles = log_file::getLogFiles();
 
+	log_file_setAsyncWriter(0, false);
+
 	for (auto& logFilePair: logFiles) {
 		fclose(logFilePair.second.GetOutStream());
 	}
@@ -266,6 +480,34 @@ void log_file_removeAllLogFiles() {
 }
 
 
+void log_file_setAsyncWriter(unsigned int numRecords, bool dropOnOverflow) {
+	log_file::AsyncRecordWriter& asyncWriter = log_file::getAsyncWriter();
+
+	// route new records back through the synchronous path before stopping
+	log_file::asyncWriting.store(false);
+	asyncWriter.Stop();
+
+	if (numRecords == 0)
+		return;
+
+	asyncWriter.Start(numRecords, dropOnOverflow);
+	log_file::asyncWriting.store(true);
+}
+
+void log_file_flushAsyncRecords() {
+	if (!log_file::asyncWriting.load())
+		return;
+
+	// bounded, this also runs from the crash handlers and the crash might
+	// have happened on the writer thread while it held the consumer flag
+	if (log_file::getAsyncWriter().Drain(1024))
+		return;
+
+	// write whatever is logged from here on (e.g. the stack-trace) directly
+	log_file::asyncWriting.store(false);
+}
+
+
 FILE* log_file_getLogFileStream(const char* filePath) {
 	const auto& logFiles = log_file::getLogFiles();
 
@@ -290,6 +532,12 @@ FILE* log_file_getLogFileStream(const char* filePath) {
 /// Records a log entry
 static void log_sink_record_file(int level, const char* section, const char* record)
 {
+	if (log_file::asyncWriting.load(std::memory_order_relaxed)) {
+		// the writer thread only exists while log files do
+		log_file::getAsyncWriter().Push(level, section, record);
+		return;
+	}
+
 	if (log_file::validTracker && log_file::isActivelyLogging()) {
 		// write buffer to log file
 		log_file::writeBufferToFiles();
@@ -303,10 +551,13 @@ static void log_sink_record_file(int level, const char* section, const char* rec
 }
 
 /// Cleans up all log streams, by flushing them.
+/// Also runs from the crash handlers, so queued records are written first.
 static void log_sink_cleanup_file() {
 	if (!log_file::isActivelyLogging())
 		return;
 
+	log_file_flushAsyncRecords();
+
 	// flush the log buffers to files
 	log_file::flushFiles();
 }
@@ -41,6 +41,23 @@ void log_file_removeLogFile(const char* filePath);
 
 void log_file_removeAllLogFiles();
 
+/**
+ * Move the file writes off the logging threads.
+ * Records are queued in a lock-free ring and written by a background thread.
+ * @param numRecords ring capacity (rounded up to a power of two), 0 to go
+ *   back to writing synchronously
+ * @param dropOnOverflow discard records instead of stalling the logging
+ *   thread while the ring is full
+ */
+void log_file_setAsyncWriter(unsigned int numRecords, bool dropOnOverflow);
+
+/**
+ * Write out all queued records from the calling thread, e.g. when crashing.
+ * Never blocks indefinitely; if the writer thread keeps the queue busy the
+ * sink falls back to writing synchronously instead.
+ */
+void log_file_flushAsyncRecords();
+
 ///@}
 
 #ifdef __cplusplus
@@ -39,6 +39,15 @@ CONFIG(int, LogFlushLevel)
 	.defaultValue(LOG_LEVEL_ERROR)
 	.description("Flush the logfile when a message's level exceeds this value. ERROR is flushed by default, WARNING is not.");
 
+CONFIG(int, LogAsyncRingSize)
+	.defaultValue(0)
+	.minimumValue(0)
+	.description("Number of records queued for the asynchronous log writer thread. 0 writes the logfile from the logging thread itself.");
+
+CONFIG(bool, LogAsyncDropOnOverflow)
+	.defaultValue(false)
+	.description("Drop records instead of stalling the logging thread when the asynchronous log writer can not keep up.");
+
 CONFIG(int, LogRepeatLimit)
 	.defaultValue(10)
 	.description("Allow at most this many consecutive identical messages to be logged.");
@@ -184,6 +193,7 @@ void CLogOutput::Initialize()
 
 	log_filter_setRepeatLimit(configHandler->GetInt("LogRepeatLimit")); // all sinks
 	log_file_addLogFile(filePath.c_str(), nullptr, LOG_LEVEL_ALL, configHandler->GetInt("LogFlushLevel"));
+	log_file_setAsyncWriter(configHandler->GetInt("LogAsyncRingSize"), configHandler->GetBool("LogAsyncDropOnOverflow"));
 
 	LOG("LogOutput initialized. Logging to %s", filePath.c_str());
 }
@@ -298,13 +298,8 @@ CMatrix44f& CMatrix44f::Translate(const float x, const float y, const float z)
 
 
 __FORCE_ALIGN_STACK__
-static inline void MatrixMatrixMultiplySSE(const CMatrix44f& m1, const CMatrix44f& m2, CMatrix44f* mout)
+static inline void MatrixMatrixMultiplySSE(const __m128 m1c1, const __m128 m1c2, const __m128 m1c3, const __m128 m1c4, const CMatrix44f& m2, CMatrix44f* mout)
 {
-	const __m128 m1c1 = _mm_loadu_ps(&m1.md[0][0]);
-	const __m128 m1c2 = _mm_loadu_ps(&m1.md[1][0]);
-	const __m128 m1c3 = _mm_loadu_ps(&m1.md[2][0]);
-	const __m128 m1c4 = _mm_loadu_ps(&m1.md[3][0]);
-
 	// an optimization we assume
 	assert(m2.m[3] == 0.0f);
 	assert(m2.m[7] == 0.0f);
@@ -354,6 +349,17 @@ static inline void MatrixMatrixMultiplySSE(const CMatrix44f& m1, const CMatrix44
 	_mm_storeu_ps(&mout->md[3][0], moutc4);
 }
 
+__FORCE_ALIGN_STACK__
+static inline void MatrixMatrixMultiplySSE(const CMatrix44f& m1, const CMatrix44f& m2, CMatrix44f* mout)
+{
+	const __m128 m1c1 = _mm_loadu_ps(&m1.md[0][0]);
+	const __m128 m1c2 = _mm_loadu_ps(&m1.md[1][0]);
+	const __m128 m1c3 = _mm_loadu_ps(&m1.md[2][0]);
+	const __m128 m1c4 = _mm_loadu_ps(&m1.md[3][0]);
+
+	MatrixMatrixMultiplySSE(m1c1, m1c2, m1c3, m1c4, m2, mout);
+}
+
 
 CMatrix44f CMatrix44f::operator* (const CMatrix44f& m2) const
 {
@@ -363,6 +369,21 @@ CMatrix44f CMatrix44f::operator* (const CMatrix44f& m2) const
 }
 
 
+__FORCE_ALIGN_STACK__
+void CMatrix44f::Concat(const CMatrix44f& m1, const CMatrix44f* m2s, CMatrix44f* mouts, size_t count)
+{
+	// load once, mouts might alias m1
+	const __m128 m1c1 = _mm_loadu_ps(&m1.md[0][0]);
+	const __m128 m1c2 = _mm_loadu_ps(&m1.md[1][0]);
+	const __m128 m1c3 = _mm_loadu_ps(&m1.md[2][0]);
+	const __m128 m1c4 = _mm_loadu_ps(&m1.md[3][0]);
+
+	for (size_t i = 0; i < count; i++) {
+		MatrixMatrixMultiplySSE(m1c1, m1c2, m1c3, m1c4, m2s[i], &mouts[i]);
+	}
+}
+
+
 CMatrix44f& CMatrix44f::operator>>= (const CMatrix44f& m2)
 {
 	MatrixMatrixMultiplySSE(m2, *this, this);
@@ -110,6 +110,8 @@ public:
 
 
 	static CMatrix44f Identity() { return {}; }
+	/// mouts[i] = m1 * m2s[i], bit-identical to operator*
+	static void Concat(const CMatrix44f& m1, const CMatrix44f* m2s, CMatrix44f* mouts, size_t count);
 	static CMatrix44f PerspProj(float aspect, float thfov, float zn, float zf);
 	static CMatrix44f PerspProj(float l, float r, float b, float t, float zn, float zf);
 	static CMatrix44f OrthoProj(float l, float r, float b, float t, float zn, float zf);
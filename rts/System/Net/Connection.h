@@ -5,6 +5,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "RawPacket.h"
 
@@ -26,6 +27,20 @@ public:
 	 */
 	virtual void SendData(std::shared_ptr<const RawPacket> data) = 0;
 
+	/**
+	 * @brief Send a batch of packets shared between many connections
+	 * @param batch all packets concatenated into one buffer
+	 * @param packets the individual packets making up the batch
+	 *
+	 * Connections which chunk their outgoing stream anyway can queue the
+	 * (already serialized) batch as-is, the rest gets each packet separately.
+	 */
+	virtual void SendBatch(std::shared_ptr<const RawPacket> batch, const std::vector< std::shared_ptr<const RawPacket> >& packets) {
+		for (const std::shared_ptr<const RawPacket>& pkt: packets) {
+			SendData(pkt);
+		}
+	}
+
 	virtual bool HasIncomingData() const = 0;
 
 	/**
@@ -70,6 +85,8 @@ public:
 	virtual void Unmute() = 0;
 	virtual void Close(bool flush = false) = 0;
 	virtual void SetLossFactor(int factor) = 0;
+	/// only meaningful for connections that go over the wire
+	virtual void SetCompression(bool enable) {}
 
 	/**
 	 * @brief update internals
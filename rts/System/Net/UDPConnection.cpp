@@ -3,6 +3,7 @@
 #include "UDPConnection.h"
 
 #include <cinttypes>
+#include <zlib.h>
 
 
 #include "Socket.h"
@@ -137,7 +138,7 @@ private:
 
 void Chunk::UpdateChecksum(CRC& crc) const {
 
-	crc << chunkNumber;
+	crc << (chunkNumber | (deflatedFlag * deflated));
 	crc << (unsigned int)chunkSize;
 
 	if (!data.empty()) {
@@ -175,6 +176,9 @@ Packet::Packet(const unsigned char* data, unsigned length)
 		buf.Unpack(temp->chunkNumber);
 		buf.Unpack(temp->chunkSize);
 
+		temp->deflated = ((temp->chunkNumber & Chunk::deflatedFlag) != 0);
+		temp->chunkNumber &= ~Chunk::deflatedFlag;
+
 		// defective, ignore
 		if (buf.Remaining() < temp->chunkSize)
 			break;
@@ -222,7 +226,9 @@ void Packet::Serialize(std::vector<std::uint8_t>& data)
 	buf.Pack(naks);
 
 	for (auto ci = chunks.begin(); ci != chunks.end(); ++ci) {
-		buf.Pack((*ci)->chunkNumber);
+		std::int32_t chunkNumber = (*ci)->chunkNumber | (Chunk::deflatedFlag * (*ci)->deflated);
+
+		buf.Pack(chunkNumber);
 		buf.Pack((*ci)->chunkSize);
 		buf.Pack((*ci)->data);
 	}
@@ -281,6 +287,7 @@ void UDPConnection::Init()
 	waitingPackets.reserve(256);
 	incomingChunkNums.clear();
 	incomingChunkNums.reserve(256);
+	deflatedChunkNums.clear();
 
 	resendRequested.clear();
 	resendRequested.reserve(256);
@@ -302,7 +309,11 @@ void UDPConnection::Init()
 	lastNak = -1;
 	sentOverhead = 0;
 	recvOverhead = 0;
+	rawBytesDeflated = 0;
+	deflatedBytes = 0;
 
+	outgoingDataPos = 0;
+	sharedBatches = 0;
 	resentChunks = 0;
 	sentPackets = 0;
 	recvPackets = 0;
@@ -313,6 +324,7 @@ void UDPConnection::Init()
 	muted = true;
 	closed = false;
 	resend = false;
+	deflateOutgoing = false;
 
 	#ifndef UNIT_TEST
 	logMessages = configHandler->GetBool("UDPConnectionLogDebugMessages");
@@ -344,6 +356,14 @@ UDPConnection::~UDPConnection()
 	waitingPackets.clear();
 
 	Flush(true);
+
+	if (deflateStream != nullptr)
+		deflateEnd(deflateStream);
+	if (inflateStream != nullptr)
+		inflateEnd(inflateStream);
+
+	spring::SafeDelete(deflateStream);
+	spring::SafeDelete(inflateStream);
 }
 
 void UDPConnection::SendData(std::shared_ptr<const RawPacket> pkt)
@@ -352,6 +372,16 @@ void UDPConnection::SendData(std::shared_ptr<const RawPacket> pkt)
 	outgoingData.push_back(pkt);
 }
 
+void UDPConnection::SendBatch(std::shared_ptr<const RawPacket> batch, const std::vector< std::shared_ptr<const RawPacket> >& packets)
+{
+	// the batch is one contiguous run of valid messages, Flush
+	// only has to check the leading one and can chunk straight
+	// out of the shared buffer
+	assert(batch->length > 0);
+	outgoingData.push_back(batch);
+	sharedBatches += (packets.size() > 1);
+}
+
 std::shared_ptr<const RawPacket> UDPConnection::Peek(unsigned ahead) const
 {
 	if (ahead >= msgQueue.size())
@@ -528,6 +558,9 @@ void UDPConnection::ProcessRawPacket(Packet& incoming)
 		LOG_L(L_INFO, "\t[%s] checksum=(%u : %u) mtu=%u", __func__, incoming.GetChecksum(), incoming.checksum, mtu);
 	#endif
 
+	if (closed)
+		return;
+
 	lastPacketRecvTime = spring_gettime();
 	dataRecv += incoming.GetSize();
 	recvOverhead += Packet::headerSize;
@@ -602,6 +635,14 @@ void UDPConnection::ProcessRawPacket(Packet& incoming)
 
 		waitingPackets.emplace_back(c->chunkNumber, std::move(RawPacket(&c->data[0], c->data.size())));
 		incomingChunkNums.insert(c->chunkNumber);
+
+		if (!c->deflated)
+			continue;
+
+		deflatedChunkNums.insert(c->chunkNumber);
+
+		// the other side only deflates if we asked for it, so it can take our stream as well
+		deflateOutgoing |= globalConfig.networkCompression;
 	}
 
 
@@ -624,7 +665,15 @@ void UDPConnection::ProcessRawPacket(Packet& incoming)
 			fragmentBuffer.Delete();
 		}
 
-		std::copy(wpi->second.data, wpi->second.data + wpi->second.length, std::back_inserter(waitBuffer));
+		if (deflatedChunkNums.erase(wpi->first) != 0) {
+			// a broken stream can not be resynchronized, every later chunk depends on it
+			if (!InflateChunk(wpi->second.data, wpi->second.length)) {
+				Close(false);
+				return;
+			}
+		} else {
+			std::copy(wpi->second.data, wpi->second.data + wpi->second.length, std::back_inserter(waitBuffer));
+		}
 
 		incomingChunkNums.erase(wpi->first);
 		// waitingPackets.erase(wpi);
@@ -705,7 +754,7 @@ void UDPConnection::Flush(const bool forced)
 	// if the packet is tiny, reduce the send frequency further
 	const int requiredLength = ((200 >> netLossFactor) - spring_tomsecs(curTime - lastChunkCreatedTime)) / 10;
 
-	int outgoingLength = 0;
+	int outgoingLength = -int(outgoingDataPos);
 
 	if (!waitMore) {
 		for (auto pi = outgoingData.begin(); (pi != outgoingData.end()) && (outgoingLength <= requiredLength); ++pi) {
@@ -728,39 +777,47 @@ void UDPConnection::Flush(const bool forced)
 			sendMore |= ((globalConfig.linkOutgoingBandwidth <= 0) || partialPacket || forced);
 
 			if (!outgoingData.empty() && sendMore) {
-				std::shared_ptr<const RawPacket>& packet = *(outgoingData.begin());
+				const std::shared_ptr<const RawPacket>& packet = *(outgoingData.begin());
 
-				if (!partialPacket && !ProtocolDef::GetInstance()->IsValidPacket(packet->data, packet->length)) {
+				if (!partialPacket && outgoingDataPos == 0 && !ProtocolDef::GetInstance()->IsValidPacket(packet->data, packet->length)) {
 					LOG_L(L_ERROR,
 						"[UDPConnection::%s] discarding outgoing invalid packet: ID %d, LEN %d",
 						__func__, ((packet->length > 0) ? (int)packet->data[0] : -1), packet->length
 					);
 					outgoingData.pop_front();
 				} else {
-					const unsigned numBytes = std::min((unsigned)maxChunkSize - pos, packet->length);
+					const unsigned numBytes = std::min((unsigned)maxChunkSize - pos, packet->length - outgoingDataPos);
 
-					assert(packet->length > 0);
-					memcpy(buffer + pos, packet->data, numBytes);
+					assert(packet->length > outgoingDataPos);
+					memcpy(buffer + pos, packet->data + outgoingDataPos, numBytes);
 
 					pos += numBytes;
 					sentOverhead += Packet::headerSize;
 
 					outgoing.DataSent(numBytes, true);
 
-					if ((partialPacket = (numBytes != packet->length))) {
-						// partially transfered
-						packet.reset(new RawPacket(packet->data + numBytes, packet->length - numBytes));
+					if ((partialPacket = ((outgoingDataPos += numBytes) != packet->length))) {
+						// partially transfered; packets can be shared with
+						// other connections so only advance our read offset
 					} else {
 						// full packet copied
 						outgoingData.pop_front();
+						outgoingDataPos = 0;
 					}
 				}
 			}
 			if ((pos > 0) && (outgoingData.empty() || (pos == maxChunkSize) || !sendMore)) {
-				CreateChunk(buffer, pos, currentPacketChunkNum++);
+				if (deflateOutgoing) {
+					deflateBuffer.insert(deflateBuffer.end(), buffer, buffer + pos);
+				} else {
+					CreateChunk(buffer, pos, currentPacketChunkNum++);
+				}
 				pos = 0;
 			}
 		} while (!outgoingData.empty() && sendMore);
+
+		if (!deflateBuffer.empty())
+			CreateDeflatedChunks();
 	}
 
 	SendIfNecessary(forced);
@@ -768,6 +825,10 @@ void UDPConnection::Flush(const bool forced)
 
 bool UDPConnection::CheckTimeout(int seconds, bool initial) const {
 
+	// closed on our side (e.g. broken deflate stream), let the owner drop us
+	if (closed)
+		return true;
+
 	int timeout;
 
 	if (seconds == 0) {
@@ -809,6 +870,8 @@ std::string UDPConnection::Statistics() const
 		"\t{%.3fx, %.3fx} relative protocol overhead {up, down}\n",
 		"\t%u incoming chunks dropped, %u outgoing chunks resent\n",
 		"\t%u incoming chunks processed\n",
+		"\t%u shared broadcast batches queued\n",
+		"\t%u bytes deflated to %u before chunking (%.3fx)\n",
 	};
 
 	std::string msg = "[UDPConnection::Statistics]\n";
@@ -817,6 +880,8 @@ std::string UDPConnection::Statistics() const
 	msg += spring::format(fmts[2], spring::SafeDivide(sentOverhead * 1.0f, dataSent * 1.0f), spring::SafeDivide(recvOverhead * 1.0f, dataRecv * 1.0f));
 	msg += spring::format(fmts[3], droppedChunks, resentChunks);
 	msg += spring::format(fmts[4], lastInOrder + 1);
+	msg += spring::format(fmts[5], sharedBatches);
+	msg += spring::format(fmts[6], rawBytesDeflated, deflatedBytes, spring::SafeDivide(deflatedBytes * 1.0f, rawBytesDeflated * 1.0f));
 	return msg;
 }
 
@@ -832,17 +897,93 @@ void UDPConnection::SetMTU(unsigned mtu2)
 	}
 }
 
-void UDPConnection::CreateChunk(const unsigned char* data, const unsigned length, const int packetNum)
+void UDPConnection::CreateChunk(const unsigned char* data, const unsigned length, const int packetNum, const bool deflated)
 {
 	assert((length > 0) && (length < 255));
 	ChunkPtr buf(new Chunk);
 	buf->chunkNumber = packetNum;
 	buf->chunkSize = length;
-	std::copy(data, data + length, std::back_inserter(buf->data));
+	buf->deflated = deflated;
+	buf->data.assign(data, data + length);
 	newChunks.push_back(buf);
 	lastChunkCreatedTime = spring_gettime();
 }
 
+void UDPConnection::CreateDeflatedChunks()
+{
+	if (deflateStream == nullptr) {
+		deflateStream = new z_stream();
+
+		// favor speed, the server deflates a stream for every client
+		if (deflateInit(deflateStream, Z_BEST_SPEED) != Z_OK) {
+			LOG_L(L_ERROR, "[UDPConnection::%s] deflateInit failed, sending uncompressed", __func__);
+
+			spring::SafeDelete(deflateStream);
+			deflateOutgoing = false;
+			return;
+		}
+	}
+
+	std::uint8_t buffer[maxChunkSize];
+
+	deflateStream->next_in = deflateBuffer.data();
+	deflateStream->avail_in = deflateBuffer.size();
+
+	// a sync-flush per Flush call makes every chunk run decodable as soon
+	// as it arrives, deflate must be called until it leaves output space
+	do {
+		deflateStream->next_out = buffer;
+		deflateStream->avail_out = sizeof(buffer);
+
+		deflate(deflateStream, Z_SYNC_FLUSH);
+
+		const unsigned numBytes = sizeof(buffer) - deflateStream->avail_out;
+
+		if (numBytes == 0)
+			continue;
+
+		CreateChunk(buffer, numBytes, currentPacketChunkNum++, true);
+		deflatedBytes += numBytes;
+	} while (deflateStream->avail_out == 0);
+
+	rawBytesDeflated += deflateBuffer.size();
+	deflateBuffer.clear();
+}
+
+bool UDPConnection::InflateChunk(const std::uint8_t* data, const unsigned length)
+{
+	if (inflateStream == nullptr) {
+		inflateStream = new z_stream();
+
+		if (inflateInit(inflateStream) != Z_OK) {
+			LOG_L(L_ERROR, "[UDPConnection::%s] inflateInit failed, closing connection", __func__);
+			spring::SafeDelete(inflateStream);
+			return false;
+		}
+	}
+
+	std::uint8_t buffer[udpMaxPacketSize];
+
+	inflateStream->next_in = const_cast<std::uint8_t*>(data);
+	inflateStream->avail_in = length;
+
+	do {
+		inflateStream->next_out = buffer;
+		inflateStream->avail_out = sizeof(buffer);
+
+		const int ret = inflate(inflateStream, Z_SYNC_FLUSH);
+
+		if (ret != Z_OK && ret != Z_BUF_ERROR) {
+			LOG_L(L_ERROR, "[UDPConnection::%s] corrupted deflate stream data (error %d, LEN %u), closing connection", __func__, ret, length);
+			return false;
+		}
+
+		waitBuffer.insert(waitBuffer.end(), buffer, buffer + (sizeof(buffer) - inflateStream->avail_out));
+	} while (inflateStream->avail_out == 0);
+
+	return true;
+}
+
 void UDPConnection::SendIfNecessary(bool flushed)
 {
 	const spring_time curTime = spring_gettime();
@@ -12,6 +12,7 @@
 #include "System/UnorderedSet.hpp"
 
 class CRC;
+struct z_stream_s;
 
 
 namespace netcode {
@@ -33,8 +34,11 @@ public:
 	void UpdateChecksum(CRC& crc) const;
 	static constexpr unsigned maxSize = 254;
 	static constexpr unsigned headerSize = 5;
+	/// set on the wire chunkNumber when data is part of the deflate stream
+	static constexpr std::int32_t deflatedFlag = 1 << 30;
 	std::int32_t chunkNumber;
 	std::uint8_t chunkSize;
+	bool deflated = false;
 	std::vector<std::uint8_t> data;
 };
 typedef std::shared_ptr<Chunk> ChunkPtr;
@@ -94,6 +98,7 @@ public:
 
 	// START overriding CConnection
 	void SendData(std::shared_ptr<const RawPacket> pkt) override;
+	void SendBatch(std::shared_ptr<const RawPacket> batch, const std::vector< std::shared_ptr<const RawPacket> >& packets) override;
 	bool HasIncomingData() const override { return !msgQueue.empty(); }
 	std::shared_ptr<const RawPacket> Peek(unsigned ahead) const override;
 	std::shared_ptr<const RawPacket> GetData() override;
@@ -131,6 +136,7 @@ public:
 	void Unmute() override { muted = false; }
 	void Close(bool flush) override;
 	void SetLossFactor(int factor) override;
+	void SetCompression(bool enable) override { deflateOutgoing = enable; }
 
 	const asio::ip::udp::endpoint& GetEndpoint() const { return addr; }
 
@@ -145,7 +151,11 @@ private:
 	void Init();
 
 	/// add header to data and send it
-	void CreateChunk(const unsigned char* data, const unsigned length, const int packetNum);
+	void CreateChunk(const unsigned char* data, const unsigned length, const int packetNum, const bool deflated = false);
+	/// compress everything collected in deflateBuffer into new chunks
+	void CreateDeflatedChunks();
+	/// decompress an in-order chunk and append the result to waitBuffer
+	bool InflateChunk(const std::uint8_t* data, const unsigned length);
 	void SendIfNecessary(bool flushed);
 	void AckChunks(int lastAck);
 
@@ -179,15 +189,20 @@ private:
 	bool resend;
 	bool sharedSocket;
 	bool logMessages;
+	bool deflateOutgoing;
 
 	int netLossFactor;
 	int reconnectTime;
 
 	/// outgoing stuff (pure data without header) waiting to be sent
 	std::deque< std::shared_ptr<const RawPacket> > outgoingData;
+	/// number of bytes of outgoingData.front() already put into chunks
+	unsigned int outgoingDataPos;
 	/// packets we have received but not yet read
 	std::vector< std::pair<int, RawPacket> > waitingPackets;
 	spring::unordered_set<int> incomingChunkNums;
+	/// subset of incomingChunkNums that has to be inflated
+	spring::unordered_set<int> deflatedChunkNums;
 
 
 	/// Newly created and not yet sent
@@ -205,6 +220,12 @@ private:
 	std::vector<std::uint8_t> sendBuffer;
 	std::vector<std::uint8_t> recvBuffer;
 	std::vector<std::uint8_t> waitBuffer;
+	std::vector<std::uint8_t> deflateBuffer;
+
+	/// persistent across the whole connection so the dictionary is shared
+	/// between chunks, valid because chunks are consumed strictly in order
+	z_stream_s* deflateStream = nullptr;
+	z_stream_s* inflateStream = nullptr;
 
 	std::vector<int> droppedPackets;
 
@@ -237,11 +258,14 @@ private:
 	#endif
 	unsigned int currentPacketChunkNum;
 
+	/// shared broadcast batches queued
+	unsigned int sharedBatches;
 	/// packets that are resent
 	unsigned int resentChunks;
 	unsigned int droppedChunks;
 
 	unsigned int sentOverhead, recvOverhead;
+	unsigned int rawBytesDeflated, deflatedBytes;
 	unsigned int sentPackets, recvPackets;
 
 	class BandwidthUsage {
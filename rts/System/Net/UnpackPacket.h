@@ -64,6 +64,8 @@ public:
 		pos += (text.size() + 1);
 	}
 
+	size_t GetRemainingBytes() const { return (pckt->length - pos); }
+
 private:
 	std::shared_ptr<const RawPacket> pckt;
 	size_t pos;
@@ -2,8 +2,6 @@
 
 
 #include "System/Object.h"
-#include "System/ContainerUtil.h"
-#include "System/creg/STL_Map.h"
 #include "System/Log/ILog.h"
 #include "System/Platform/CrashHandler.h"
 
@@ -13,30 +11,14 @@ CR_REG_METADATA(CObject, (
 	CR_MEMBER(sync_id),
 
 	CR_MEMBER(detached),
-
-	CR_MEMBER(listening),
-	CR_MEMBER(listeners),
-	CR_MEMBER(listenersDepTbl),
-	CR_MEMBER(listeningDepTbl)
+	CR_MEMBER(depHandle)
 ))
 
 std::atomic<std::int64_t> CObject::cur_sync_id(0);
 
 
 
-static bool VectorInsertSorted(std::vector<CObject*>& v, CObject* o)
-{
-	return (spring::VectorInsertUniqueSorted(v, o, [](const CObject* a, const CObject* b) { return (a->GetSyncID() < b->GetSyncID()); }));
-}
-
-static bool VectorEraseSorted(std::vector<CObject*>& v, CObject* o)
-{
-	return (spring::VectorEraseUniqueSorted(v, o, [](const CObject* a, const CObject* b) { return (a->GetSyncID() < b->GetSyncID()); }));
-}
-
-
-
-CObject::CObject() : detached(false)
+CObject::CObject() : detached(false), depHandle(0)
 {
 	// Note1: this static var is shared between all different types of classes synced & unsynced (CUnit, CFeature, CProjectile, ...)
 	//  Still it doesn't break syncness even when synced objects have different sync_ids between clients as long as the sync_id is
@@ -54,35 +36,8 @@ CObject::~CObject()
 	assert(!detached);
 	detached = true;
 
-	for (const auto& p: listenersDepTbl) {
-		assert(p.first >= DEPENDENCE_ATTACKER && p.first < DEPENDENCE_COUNT);
-		assert(p.second < listeners.size());
-
-		for (CObject* obj: listeners[p.second]) {
-			obj->DependentDied(this);
-
-			const auto jt = obj->listeningDepTbl.find(p.first);
-
-			if (jt == obj->listeningDepTbl.end())
-				continue;
-
-			VectorEraseSorted(obj->listening[ jt->second ], this);
-		}
-	}
-
-	for (const auto& p: listeningDepTbl) {
-		assert(p.first >= DEPENDENCE_ATTACKER && p.first < DEPENDENCE_COUNT);
-		assert(p.second < listening.size());
-
-		for (CObject* obj: listening[p.second]) {
-			const auto jt = obj->listenersDepTbl.find(p.first);
-
-			if (jt == obj->listenersDepTbl.end())
-				continue;
-
-			VectorEraseSorted(obj->listeners[ jt->second ], this);
-		}
-	}
+	// informs our listeners (in sync-id order) and drops all links
+	CObjectDependenceRegistry::RemoveObject(this);
 }
 
 
@@ -99,8 +54,7 @@ void CObject::AddDeathDependence(CObject* obj, DependenceType dep)
 	if (detached || obj->detached)
 		return;
 
-	VectorInsertSorted(const_cast<TSyncSafeSet&>(     GetListening(dep)),  obj);
-	VectorInsertSorted(const_cast<TSyncSafeSet&>(obj->GetListeners(dep)), this);
+	CObjectDependenceRegistry::AddLink(this, obj, dep);
 }
 
 
@@ -111,10 +65,5 @@ void CObject::DeleteDeathDependence(CObject* obj, DependenceType dep)
 	if (detached || obj->detached)
 		return;
 
-	const auto it =      listeningDepTbl.find(dep);
-	const auto jt = obj->listenersDepTbl.find(dep);
-
-	if (it !=      listeningDepTbl.end()) VectorEraseSorted(     listening[ it->second ],  obj);
-	if (jt != obj->listenersDepTbl.end()) VectorEraseSorted(obj->listeners[ jt->second ], this);
+	CObjectDependenceRegistry::RemoveLink(this, obj, dep);
 }
-
@@ -3,10 +3,12 @@
 #ifndef OBJECT_H
 #define OBJECT_H
 
+#include <array>
 #include <atomic>
 #include <functional>
 #include <vector>
 
+#include "ObjectDependenceRegistry.h"
 #include "ObjectDependenceTypes.h"
 #include "System/creg/creg_cond.h"
 #include "System/UnorderedMap.hpp"
@@ -75,61 +77,36 @@ private:
 
 public:
 	typedef std::vector<CObject*> TSyncSafeSet;
-	typedef std::vector<TSyncSafeSet> TDependenceMap;
 	typedef std::function<bool(const CObject*, int*)> TObjFilterPred;
 
 	bool detached;
 
 protected:
-	const TSyncSafeSet& GetListeners(const DependenceType dep) {
-		const auto it = listenersDepTbl.find(dep);
-
-		if (it == listenersDepTbl.end()) {
-			listeners.emplace_back();
-			listenersDepTbl[dep] = listeners.size() - 1;
-			return (listeners.back());
-		}
-
-		return (listeners[it->second]);
-	}
-	const TSyncSafeSet& GetListening(const DependenceType dep) {
-		const auto it = listeningDepTbl.find(dep);
-
-		if (it == listeningDepTbl.end()) {
-			listening.emplace_back();
-			listeningDepTbl[dep] = listening.size() - 1;
-			return (listening.back());
-		}
-
-		return (listening[it->second]);
-	}
-
-	const TDependenceMap& GetAllListeners() const { return listeners; }
-	const TDependenceMap& GetAllListening() const { return listening; }
+	// both sorted by (dependence-type, sync-id); pass DEPENDENCE_COUNT for all types
+	TSyncSafeSet GetListeners(const int dep) const { return (CObjectDependenceRegistry::GetListeners(this, dep)); }
+	TSyncSafeSet GetListening(const int dep) const { return (CObjectDependenceRegistry::GetListening(this, dep)); }
 
 	template<size_t N> static void FilterDepObjects(
-		const TDependenceMap& depObjects,
+		const TSyncSafeSet& depObjects,
 		const TObjFilterPred& filterPred,
 		std::array<int, N>& objectIDs
 	) {
 		objectIDs[0] = 0;
 
-		for (const auto& objs: depObjects) {
-			for (const CObject* obj: objs) {
-				objectIDs[0] += ((objectIDs[0] < (N - 1)) && filterPred(obj, &objectIDs[objectIDs[0] + 1]));
-			}
+		for (const CObject* obj: depObjects) {
+			objectIDs[0] += ((objectIDs[0] < (N - 1)) && filterPred(obj, &objectIDs[objectIDs[0] + 1]));
 		}
 	}
 
-	template<size_t N> void FilterListeners(const TObjFilterPred& fp, std::array<int, N>& ids) const { FilterDepObjects(listeners, fp, ids); }
-	template<size_t N> void FilterListening(const TObjFilterPred& fp, std::array<int, N>& ids) const { FilterDepObjects(listening, fp, ids); }
+	template<size_t N> void FilterListeners(const TObjFilterPred& fp, std::array<int, N>& ids) const { FilterDepObjects(GetListeners(DEPENDENCE_COUNT), fp, ids); }
+	template<size_t N> void FilterListening(const TObjFilterPred& fp, std::array<int, N>& ids) const { FilterDepObjects(GetListening(DEPENDENCE_COUNT), fp, ids); }
 
-protected:
-	spring::unordered_map<int, size_t> listenersDepTbl; // maps dependence-type to index into listeners
-	spring::unordered_map<int, size_t> listeningDepTbl; // maps dependence-type to index into listening
+private:
+	friend class CObjectDependenceRegistry;
 
-	TDependenceMap listeners;
-	TDependenceMap listening;
+	// generational handle of this object's slot in CObjectDependenceRegistry,
+	// 0 while the object neither listens to nor is listened to by any other
+	unsigned int depHandle;
 };
 
 #endif /* OBJECT_H */
@@ -0,0 +1,336 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+
+#include "System/ObjectDependenceRegistry.h"
+#include "System/Object.h"
+#include "System/UnorderedMap.hpp"
+
+CR_BIND(CObjectDependenceRegistry::Link, )
+CR_REG_METADATA_SUB(CObjectDependenceRegistry, Link, (
+	CR_MEMBER(listener),
+	CR_MEMBER(target),
+	CR_MEMBER(listenerSlot),
+	CR_MEMBER(targetSlot),
+	CR_MEMBER(type),
+	CR_MEMBER(listeningIdx),
+	CR_MEMBER(listenersIdx)
+))
+
+CR_BIND(CObjectDependenceRegistry::Slot, )
+CR_REG_METADATA_SUB(CObjectDependenceRegistry, Slot, (
+	CR_MEMBER(object),
+	CR_MEMBER(listeners),
+	CR_MEMBER(listening),
+	CR_MEMBER(generation)
+))
+
+
+// handle layout: bits 0-23 are the slot index plus one (so 0 means no slot),
+// bits 24-31 hold the slot's generation at the time the handle was issued
+static constexpr unsigned int HANDLE_SLOT_BITS = 24;
+static constexpr unsigned int HANDLE_SLOT_MASK = (1u << HANDLE_SLOT_BITS) - 1;
+static constexpr unsigned int HANDLE_GEN_MASK  = 0xFF;
+
+static std::vector<CObjectDependenceRegistry::Slot> slots;
+static std::vector<CObjectDependenceRegistry::Link> links;
+static std::vector<int> freeSlots;
+static std::vector<int> freeLinks;
+
+// (listener-slot, target-slot, type) -> index into links
+static spring::unordered_map<std::uint64_t, int> linkIndices;
+
+
+
+int CObjectDependenceRegistry::GetSlotIndex(const CObject* obj)
+{
+	const unsigned int handle = obj->depHandle;
+
+	if (handle == 0)
+		return -1;
+
+	const int slotIdx = int(handle & HANDLE_SLOT_MASK) - 1;
+
+	assert(slotIdx < int(slots.size()));
+	assert(slots[slotIdx].object == obj);
+	assert(slots[slotIdx].generation == (handle >> HANDLE_SLOT_BITS));
+	return slotIdx;
+}
+
+int CObjectDependenceRegistry::GetOrAllocSlot(CObject* obj)
+{
+	int slotIdx = GetSlotIndex(obj);
+
+	if (slotIdx >= 0)
+		return slotIdx;
+
+	if (freeSlots.empty()) {
+		slotIdx = slots.size();
+		slots.emplace_back();
+	} else {
+		slotIdx = freeSlots.back();
+		freeSlots.pop_back();
+	}
+
+	assert(slotIdx < int(HANDLE_SLOT_MASK));
+
+	Slot& slot = slots[slotIdx];
+	slot.object = obj;
+
+	obj->depHandle = (slot.generation << HANDLE_SLOT_BITS) | (slotIdx + 1);
+	return slotIdx;
+}
+
+void CObjectDependenceRegistry::ReleaseSlotIfEmpty(int slotIdx)
+{
+	Slot& slot = slots[slotIdx];
+
+	if (!slot.listeners.empty() || !slot.listening.empty())
+		return;
+
+	slot.object->depHandle = 0;
+	slot.object = nullptr;
+	slot.generation = (slot.generation + 1) & HANDLE_GEN_MASK;
+
+	freeSlots.push_back(slotIdx);
+}
+
+
+int CObjectDependenceRegistry::FindLink(const CObject* listener, const CObject* target, int type)
+{
+	const int listenerSlot = GetSlotIndex(listener);
+	const int targetSlot = GetSlotIndex(target);
+
+	if (listenerSlot < 0 || targetSlot < 0)
+		return -1;
+
+	const auto it = linkIndices.find(GetLinkKey(listenerSlot, targetSlot, type));
+
+	if (it == linkIndices.end())
+		return -1;
+
+	return it->second;
+}
+
+void CObjectDependenceRegistry::EraseLink(int linkIdx)
+{
+	// swap the last entry of a link-list into the erased position
+	const auto EraseFromList = [](std::vector<int>& list, int pos, int Link::*linkPos) {
+		assert(pos >= 0 && pos < int(list.size()));
+
+		links[list[pos] = list.back()].*linkPos = pos;
+		list.pop_back();
+	};
+
+	Link& link = links[linkIdx];
+
+	const int listenerSlot = link.listenerSlot;
+	const int targetSlot = link.targetSlot;
+
+	EraseFromList(slots[listenerSlot].listening, link.listeningIdx, &Link::listeningIdx);
+	EraseFromList(slots[targetSlot].listeners, link.listenersIdx, &Link::listenersIdx);
+
+	linkIndices.erase(GetLinkKey(listenerSlot, targetSlot, link.type));
+
+	link = {};
+	freeLinks.push_back(linkIdx);
+
+	ReleaseSlotIfEmpty(listenerSlot);
+
+	if (targetSlot != listenerSlot)
+		ReleaseSlotIfEmpty(targetSlot);
+}
+
+
+bool CObjectDependenceRegistry::AddLink(CObject* listener, CObject* target, DependenceType type)
+{
+	assert(type >= DEPENDENCE_ATTACKER && type < DEPENDENCE_COUNT);
+
+	if (FindLink(listener, target, type) >= 0)
+		return false;
+
+	const int listenerSlot = GetOrAllocSlot(listener);
+	const int targetSlot = GetOrAllocSlot(target);
+
+	int linkIdx = -1;
+
+	if (freeLinks.empty()) {
+		linkIdx = links.size();
+		links.emplace_back();
+	} else {
+		linkIdx = freeLinks.back();
+		freeLinks.pop_back();
+	}
+
+	Link& link = links[linkIdx];
+	Slot& ls = slots[listenerSlot];
+	Slot& ts = slots[targetSlot];
+
+	link.listener = listener;
+	link.target = target;
+	link.listenerSlot = listenerSlot;
+	link.targetSlot = targetSlot;
+	link.type = type;
+	link.listeningIdx = ls.listening.size();
+	link.listenersIdx = ts.listeners.size();
+
+	ls.listening.push_back(linkIdx);
+	ts.listeners.push_back(linkIdx);
+
+	linkIndices[GetLinkKey(listenerSlot, targetSlot, type)] = linkIdx;
+	return true;
+}
+
+bool CObjectDependenceRegistry::RemoveLink(CObject* listener, CObject* target, DependenceType type)
+{
+	const int linkIdx = FindLink(listener, target, type);
+
+	if (linkIdx < 0)
+		return false;
+
+	EraseLink(linkIdx);
+	return true;
+}
+
+
+void CObjectDependenceRegistry::RemoveObject(CObject* obj)
+{
+	const int slotIdx = GetSlotIndex(obj);
+
+	if (slotIdx < 0)
+		return;
+
+	struct DeadLink {
+		CObject* listener;
+		int index;
+		int type;
+	};
+
+	std::vector<DeadLink> deadLinks;
+	deadLinks.reserve(slots[slotIdx].listeners.size());
+
+	for (const int linkIdx: slots[slotIdx].listeners) {
+		deadLinks.push_back({links[linkIdx].listener, linkIdx, links[linkIdx].type});
+	}
+
+	std::sort(deadLinks.begin(), deadLinks.end(), [](const DeadLink& a, const DeadLink& b) {
+		if (a.type != b.type)
+			return (a.type < b.type);
+
+		return (a.listener->GetSyncID() < b.listener->GetSyncID());
+	});
+
+	// listeners can not add or remove links to obj (it is detached), but might
+	// drop their links to others from DependentDied, so re-validate each entry
+	const auto IsLinkAlive = [&](const DeadLink& dl) {
+		const Link& link = links[dl.index];
+		return (link.target == obj && link.listener == dl.listener && link.type == dl.type);
+	};
+
+	for (const DeadLink& dl: deadLinks) {
+		if (!IsLinkAlive(dl))
+			continue;
+
+		dl.listener->DependentDied(obj);
+
+		if (!IsLinkAlive(dl))
+			continue;
+
+		EraseLink(dl.index);
+	}
+
+	// erasing the last link releases the slot
+	while (obj->depHandle != 0) {
+		const Slot& slot = slots[GetSlotIndex(obj)];
+
+		assert(slot.listeners.empty());
+		assert(!slot.listening.empty());
+
+		EraseLink(slot.listening.back());
+	}
+}
+
+
+std::vector<CObject*> CObjectDependenceRegistry::GetLinkedObjects(const std::vector<int>& linkList, int type, bool targets)
+{
+	std::vector<const Link*> typeLinks;
+	std::vector<CObject*> objects;
+
+	typeLinks.reserve(linkList.size());
+
+	for (const int linkIdx: linkList) {
+		if (type != DEPENDENCE_COUNT && links[linkIdx].type != type)
+			continue;
+
+		typeLinks.push_back(&links[linkIdx]);
+	}
+
+	std::sort(typeLinks.begin(), typeLinks.end(), [&](const Link* a, const Link* b) {
+		if (a->type != b->type)
+			return (a->type < b->type);
+
+		const CObject* oa = targets? a->target: a->listener;
+		const CObject* ob = targets? b->target: b->listener;
+
+		return (oa->GetSyncID() < ob->GetSyncID());
+	});
+
+	objects.reserve(typeLinks.size());
+
+	for (const Link* link: typeLinks) {
+		objects.push_back(targets? link->target: link->listener);
+	}
+
+	return objects;
+}
+
+std::vector<CObject*> CObjectDependenceRegistry::GetListeners(const CObject* obj, int type)
+{
+	const int slotIdx = GetSlotIndex(obj);
+
+	if (slotIdx < 0)
+		return {};
+
+	return (GetLinkedObjects(slots[slotIdx].listeners, type, false));
+}
+
+std::vector<CObject*> CObjectDependenceRegistry::GetListening(const CObject* obj, int type)
+{
+	const int slotIdx = GetSlotIndex(obj);
+
+	if (slotIdx < 0)
+		return {};
+
+	return (GetLinkedObjects(slots[slotIdx].listening, type, true));
+}
+
+
+#ifdef USING_CREG
+void CObjectDependenceRegistry::SerializeRegistry(creg::ISerializer* s)
+{
+	std::unique_ptr<creg::IType> slotsType = creg::DeduceType<decltype(slots)>::Get();
+	std::unique_ptr<creg::IType> linksType = creg::DeduceType<decltype(links)>::Get();
+	std::unique_ptr<creg::IType> freeSlotsType = creg::DeduceType<decltype(freeSlots)>::Get();
+	std::unique_ptr<creg::IType> freeLinksType = creg::DeduceType<decltype(freeLinks)>::Get();
+
+	slotsType->Serialize(s, &slots);
+	linksType->Serialize(s, &links);
+	freeSlotsType->Serialize(s, &freeSlots);
+	freeLinksType->Serialize(s, &freeLinks);
+
+	if (s->IsWriting())
+		return;
+
+	// object pointers are not resolved yet, rebuild from the slot indices
+	spring::clear_unordered_map(linkIndices);
+
+	for (size_t linkIdx = 0; linkIdx < links.size(); linkIdx++) {
+		const Link& link = links[linkIdx];
+
+		if (link.listenerSlot < 0)
+			continue;
+
+		linkIndices[GetLinkKey(link.listenerSlot, link.targetSlot, link.type)] = linkIdx;
+	}
+}
+#endif
@@ -0,0 +1,90 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef OBJECT_DEPENDENCE_REGISTRY_H
+#define OBJECT_DEPENDENCE_REGISTRY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ObjectDependenceTypes.h"
+#include "System/creg/creg_cond.h"
+
+class CObject;
+
+/**
+ * Central store of all death-dependencies between CObjects.
+ *
+ * Every object taking part in at least one dependence owns a slot, which it
+ * references through a generational handle (CObject::depHandle); slots are
+ * released again as soon as an object has no links left. Links are found by
+ * (listener, target, type) in a hash-table and know their own positions in
+ * both endpoints' link-lists, so adding and removing one is O(1) regardless
+ * of how many other objects depend on the same target.
+ *
+ * The link-lists are unordered; anything visible to the simulation (death
+ * notifications, Get{Listeners,Listening}) is sorted by (type, sync-id) at
+ * the point of use to keep it deterministic.
+ */
+class CObjectDependenceRegistry {
+	public:
+		/// returns false if the dependence already existed
+		static bool AddLink(CObject* listener, CObject* target, DependenceType type);
+		/// returns false if the dependence did not exist
+		static bool RemoveLink(CObject* listener, CObject* target, DependenceType type);
+
+		/// informs all listeners of obj about its death and drops all its links
+		static void RemoveObject(CObject* obj);
+
+		/// type=DEPENDENCE_COUNT returns the objects for all types
+		static std::vector<CObject*> GetListeners(const CObject* obj, int type);
+		static std::vector<CObject*> GetListening(const CObject* obj, int type);
+
+		#ifdef USING_CREG
+		static void SerializeRegistry(creg::ISerializer* s);
+		#endif
+
+	public:
+		struct Link {
+			CR_DECLARE_STRUCT(Link)
+
+			CObject* listener = nullptr;
+			CObject* target = nullptr;
+
+			int listenerSlot = -1;
+			int targetSlot = -1;
+			int type = DEPENDENCE_NONE;
+
+			/// positions of this link in slots[listener].listening and slots[target].listeners
+			int listeningIdx = -1;
+			int listenersIdx = -1;
+		};
+
+		struct Slot {
+			CR_DECLARE_STRUCT(Slot)
+
+			CObject* object = nullptr;
+
+			/// indices of links targeting resp. originating from object
+			std::vector<int> listeners;
+			std::vector<int> listening;
+
+			/// bumped whenever the slot is released, invalidates old handles
+			unsigned int generation = 0;
+		};
+
+	private:
+		static int GetSlotIndex(const CObject* obj);
+		static int GetOrAllocSlot(CObject* obj);
+		static void ReleaseSlotIfEmpty(int slotIdx);
+
+		static int FindLink(const CObject* listener, const CObject* target, int type);
+		static void EraseLink(int linkIdx);
+
+		static std::uint64_t GetLinkKey(int listenerSlot, int targetSlot, int type) {
+			return ((std::uint64_t(listenerSlot) << 32) | (std::uint64_t(targetSlot) << 5) | type);
+		}
+
+		static std::vector<CObject*> GetLinkedObjects(const std::vector<int>& linkList, int type, bool targets);
+};
+
+#endif /* OBJECT_DEPENDENCE_REGISTRY_H */
@@ -17,6 +17,9 @@
 	#include <shlobj.h>
 	#include <shlwapi.h>
 	#include <iphlpapi.h>
+	// resolves GetProcessMemoryInfo to K32GetProcessMemoryInfo from kernel32, no psapi.lib needed
+	#define PSAPI_VERSION 2
+	#include <psapi.h>
 
 	#ifndef SHGFP_TYPE_CURRENT
 		#define SHGFP_TYPE_CURRENT 0
@@ -40,6 +43,7 @@
 #if !defined(_WIN32)
 #include <dlfcn.h> // for dladdr(), dlopen()
 #include <pwd.h> // for getpw*()
+#include <sys/resource.h> // for getrusage()
 #include <sys/statvfs.h>
 #include <sys/types.h>
 #include <sys/utsname.h> // for uname()
@@ -514,6 +518,32 @@ namespace Platform
 	}
 
 
+	uint64_t GetPeakResidentMemory() {
+		#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS pmc;
+
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+			return 0;
+
+		return pmc.PeakWorkingSetSize;
+
+		#else
+
+		struct rusage ru;
+
+		if (getrusage(RUSAGE_SELF, &ru) != 0)
+			return 0;
+
+		#if defined(__APPLE__)
+		return ru.ru_maxrss;
+		#else
+		// kilobytes on Linux and the BSDs
+		return (uint64_t(ru.ru_maxrss) * 1024);
+		#endif
+		#endif
+	}
+
+
 	uint32_t NativeWordSize() { return (sizeof(void*)); }
 	uint32_t SystemWordSize() { return ((Is32BitEmulation())? 8: NativeWordSize()); }
 
@@ -93,6 +93,7 @@ namespace Platform
 	bool IsRunningInGDB();
 
 	uint64_t FreeDiskSpace(const std::string& path);
+	uint64_t GetPeakResidentMemory(); // in bytes, 0 if unknown
 	uint32_t NativeWordSize(); // compiled process code
 	uint32_t SystemWordSize(); // host operating system
 
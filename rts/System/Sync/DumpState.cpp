@@ -1,11 +1,15 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <string>
-#include <fstream>
 #include <vector>
-#include <list>
+
+#include <zlib.h>
 
 #include "DumpState.h"
+#include "DumpStateFormat.h"
 
 #include "Game/GameSetup.h"
 #include "Game/GlobalUnsynced.h"
@@ -27,8 +31,167 @@
 #include "Sim/Weapons/WeaponDefHandler.h"
 #include "System/StringUtil.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/SpringThreading.h"
+
+using namespace DumpStateFormat;
+
+// serializes one frame worth of records on the sim thread;
+// see DumpStateFormat.h for the layout
+class DumpStateBuffer {
+public:
+	void BeginObject(Object obj, int id) {
+		Append(uint8_t(obj));
+		Append(int32_t(id));
+	}
+
+	void AddInt(Field field, int value) {
+		assert(GetFieldType(field) == TYPE_INT);
+		Append(uint8_t(field));
+		Append(int32_t(value));
+	}
+	void AddFloat(Field field, float value) {
+		assert(GetFieldType(field) == TYPE_FLOAT);
+		Append(uint8_t(field));
+		Append(value);
+	}
+	void AddFloat3(Field field, const float3& value) {
+		assert(GetFieldType(field) == TYPE_FLOAT3);
+		Append(uint8_t(field));
+		Append(value.x);
+		Append(value.y);
+		Append(value.z);
+	}
+	void AddString(Field field, const std::string& value) {
+		assert(GetFieldType(field) == TYPE_STRING);
+
+		const uint16_t size = std::min(value.size(), size_t(0xFFFF));
+
+		Append(uint8_t(field));
+		Append(size);
+		data.insert(data.end(), value.begin(), value.begin() + size);
+	}
+
+public:
+	std::vector<uint8_t> data;
+
+private:
+	template<typename T> void Append(const T& value) {
+		const size_t size = data.size();
+
+		data.resize(size + sizeof(T));
+		std::memcpy(&data[size], &value, sizeof(T));
+	}
+};
+
+
+// compresses and writes serialized frames on a background thread,
+// so dumping does not stall the sim any more than necessary
+class DumpStateWriter {
+public:
+	~DumpStateWriter() { Close(); }
+
+	bool Open(const std::string& name) {
+		Close();
+
+		if ((gzf = gzopen(name.c_str(), "wb1")) == nullptr)
+			return false;
+
+		gzwrite(gzf, MAGIC, sizeof(MAGIC));
+		gzwrite(gzf, &VERSION, sizeof(VERSION));
+
+		quit = false;
+		thread = spring::thread(&DumpStateWriter::CompressLoop, this);
+		return true;
+	}
+
+	void Close() {
+		if (gzf == nullptr)
+			return;
+
+		{
+			std::unique_lock<spring::mutex> lock(mutex);
+			quit = true;
+			cond.notify_one();
+		}
+
+		// writes out all queued frames before returning
+		thread.join();
+
+		gzclose(gzf);
+		gzf = nullptr;
+	}
+
+	bool IsOpen() const { return (gzf != nullptr); }
+
+	// hands the buffer's data to the writer, leaves it with recycled storage
+	void Push(DumpStateBuffer& buffer) {
+		std::unique_lock<spring::mutex> lock(mutex);
+
+		queued.emplace_back();
+		queued.back().swap(buffer.data);
+
+		if (!spares.empty()) {
+			buffer.data.swap(spares.back());
+			spares.pop_back();
+		}
+
+		cond.notify_one();
+	}
+
+private:
+	void CompressLoop() {
+		std::vector<std::vector<uint8_t>> frames;
+
+		while (true) {
+			{
+				std::unique_lock<spring::mutex> lock(mutex);
+
+				cond.wait(lock, [&]() { return (quit || !queued.empty()); });
 
-static std::fstream file;
+				if (queued.empty())
+					return;
+
+				frames.swap(queued);
+			}
+
+			for (std::vector<uint8_t>& frame: frames) {
+				gzwrite(gzf, frame.data(), frame.size());
+			}
+
+			// the frames leading up to a crash are the interesting ones, so
+			// get every batch out of zlib's buffers and into the file at once
+			gzflush(gzf, Z_SYNC_FLUSH);
+
+			{
+				std::unique_lock<spring::mutex> lock(mutex);
+
+				for (std::vector<uint8_t>& frame: frames) {
+					frame.clear();
+					spares.emplace_back();
+					spares.back().swap(frame);
+				}
+			}
+
+			frames.clear();
+		}
+	}
+
+private:
+	gzFile gzf = nullptr;
+
+	spring::thread thread;
+	spring::mutex mutex;
+	spring::condition_variable cond;
+
+	std::vector<std::vector<uint8_t>> queued;
+	std::vector<std::vector<uint8_t>> spares;
+
+	bool quit = false;
+};
+
+
+static DumpStateBuffer buffer;
+static DumpStateWriter writer;
 
 static int gMinFrameNum = -1;
 static int gMaxFrameNum = -1;
@@ -58,11 +221,6 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod)
 
 	if ((gMinFrameNum != oldMinFrameNum) || (gMaxFrameNum != oldMaxFrameNum)) {
 		// bounds changed, open a new file
-		if (file.is_open()) {
-			file.flush();
-			file.close();
-		}
-
 		std::string name = (gameServer != nullptr)? "Server": "Client";
 		name += "GameState-";
 		name += IntToString(guRNG.NextInt());
@@ -70,23 +228,23 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod)
 		name += IntToString(gMinFrameNum);
 		name += "-";
 		name += IntToString(gMaxFrameNum);
-		name += "].txt";
-
-		file.open(name.c_str(), std::ios::out);
-
-		if (file.is_open()) {
-			file << " mapName: " << gameSetup->mapName << "\n";
-			file << " modName: " << gameSetup->modName << "\n";
-			file << "minFrame: " << gMinFrameNum << "\n";
-			file << "maxFrame: " << gMaxFrameNum << "\n";
-			file << "randSeed: " << gsRNG.GetLastSeed() << "\n";
-			file << "initSeed: " << gsRNG.GetInitSeed() << "\n";
+		name += "].dump.gz";
+
+		if (writer.Open(name)) {
+			buffer.BeginObject(OBJECT_HEADER, 0);
+			buffer.AddString(FIELD_mapName, gameSetup->mapName);
+			buffer.AddString(FIELD_modName, gameSetup->modName);
+			buffer.AddInt(FIELD_minFrame, gMinFrameNum);
+			buffer.AddInt(FIELD_maxFrame, gMaxFrameNum);
+			buffer.AddInt(FIELD_randSeed, gsRNG.GetLastSeed());
+			buffer.AddInt(FIELD_initSeed, gsRNG.GetInitSeed());
+			writer.Push(buffer);
 		}
 
-		LOG("[%s] using dump-file \"%s\"", __func__, name.c_str());
+		LOG("[%s] using dump-file \"%s\" (compare with DumpStateTool)", __func__, name.c_str());
 	}
 
-	if (file.bad() || !file.is_open())
+	if (!writer.IsOpen())
 		return;
 	// check if the CURRENT frame lies within the bounds
 	if (gs->frameNum < gMinFrameNum)
@@ -101,8 +259,8 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod)
 	const auto& activeFeatureIDs = featureHandler.GetActiveFeatureIDs();
 	const ProjectileContainer& projectiles = projectileHandler.projectileContainers[true];
 
-	file << "frame: " << gs->frameNum << ", seed: " << gsRNG.GetLastSeed() << "\n";
-	file << "\tunits: " << activeUnits.size() << "\n";
+	buffer.BeginObject(OBJECT_FRAME, gs->frameNum);
+	buffer.AddInt(FIELD_seed, gsRNG.GetLastSeed());
 
 	#define DUMP_UNIT_DATA
 	#define DUMP_UNIT_PIECE_DATA
@@ -112,7 +270,6 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod)
 	#define DUMP_FEATURE_DATA
 	#define DUMP_PROJECTILE_DATA
 	#define DUMP_TEAM_DATA
-	// #define DUMP_ALLYTEAM_DATA
 
 	#ifdef DUMP_UNIT_DATA
 	for (const CUnit* u: activeUnits) {
@@ -120,54 +277,48 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod)
 		const LocalModel& lm = u->localModel;
 		const std::vector<LocalModelPiece>& pieces = lm.pieces;
 
-		const float3& pos = u->pos;
-		const float3& xdir = u->rightdir;
-		const float3& ydir = u->updir;
-		const float3& zdir = u->frontdir;
-
-		file << "\t\tunitID: " << u->id << " (name: " << u->unitDef->name << ")\n";
-		file << "\t\t\tpos: <" << pos.x << ", " << pos.y << ", " << pos.z << ">\n";
-		file << "\t\t\txdir: <" << xdir.x << ", " << xdir.y << ", " << xdir.z << ">\n";
-		file << "\t\t\tydir: <" << ydir.x << ", " << ydir.y << ", " << ydir.z << ">\n";
-		file << "\t\t\tzdir: <" << zdir.x << ", " << zdir.y << ", " << zdir.z << ">\n";
-		file << "\t\t\theading: " << int(u->heading) << ", mapSquare: " << u->mapSquare << "\n";
-		file << "\t\t\thealth: " << u->health << ", experience: " << u->experience << "\n";
-		file << "\t\t\tisDead: " << u->isDead << ", activated: " << u->activated << "\n";
-		file << "\t\t\tphysicalState: " << u->physicalState << "\n";
-		file << "\t\t\tfireState: " << u->fireState << ", moveState: " << u->moveState << "\n";
-		file << "\t\t\tpieces: " << pieces.size() << "\n";
+		buffer.BeginObject(OBJECT_UNIT, u->id);
+		buffer.AddString(FIELD_name, u->unitDef->name);
+		buffer.AddFloat3(FIELD_pos, u->pos);
+		buffer.AddFloat3(FIELD_xdir, u->rightdir);
+		buffer.AddFloat3(FIELD_ydir, u->updir);
+		buffer.AddFloat3(FIELD_zdir, u->frontdir);
+		buffer.AddInt(FIELD_heading, u->heading);
+		buffer.AddInt(FIELD_mapSquare, u->mapSquare);
+		buffer.AddFloat(FIELD_health, u->health);
+		buffer.AddFloat(FIELD_experience, u->experience);
+		buffer.AddInt(FIELD_isDead, u->isDead);
+		buffer.AddInt(FIELD_activated, u->activated);
+		buffer.AddInt(FIELD_physicalState, u->physicalState);
+		buffer.AddInt(FIELD_fireState, u->fireState);
+		buffer.AddInt(FIELD_moveState, u->moveState);
+		buffer.AddInt(FIELD_numPieces, pieces.size());
+		buffer.AddInt(FIELD_numWeapons, weapons.size());
 
 		#ifdef DUMP_UNIT_PIECE_DATA
-		for (const LocalModelPiece& lmp: pieces) {
+		for (size_t n = 0; n < pieces.size(); n++) {
+			const LocalModelPiece& lmp = pieces[n];
 			const S3DModelPiece* omp = lmp.original;
 			const S3DModelPiece* par = omp->parent;
-			const float3& ppos = lmp.GetPosition();
-			const float3& prot = lmp.GetRotation();
-
-			file << "\t\t\t\tname: " << omp->name << " (parentName: " << ((par != nullptr)? par->name: "[null]") << ")\n";
-			file << "\t\t\t\tpos: <" << ppos.x << ", " << ppos.y << ", " << ppos.z << ">\n";
-			file << "\t\t\t\trot: <" << prot.x << ", " << prot.y << ", " << prot.z << ">\n";
-			file << "\t\t\t\tvisible: " << lmp.scriptSetVisible << "\n";
-			file << "\n";
+
+			buffer.BeginObject(OBJECT_PIECE, n);
+			buffer.AddString(FIELD_name, omp->name);
+			buffer.AddString(FIELD_parentName, (par != nullptr)? par->name: "[null]");
+			buffer.AddFloat3(FIELD_pos, lmp.GetPosition());
+			buffer.AddFloat3(FIELD_rot, lmp.GetRotation());
+			buffer.AddInt(FIELD_visible, lmp.scriptSetVisible);
 		}
 		#endif
 
-		file << "\t\t\tweapons: " << weapons.size() << "\n";
-
 		#ifdef DUMP_UNIT_WEAPON_DATA
 		for (const CWeapon* w: weapons) {
-			const float3& awp = w->aimFromPos;
-			const float3& rwp = w->relAimFromPos;
-			const float3& amp = w->weaponMuzzlePos;
-			const float3& rmp = w->relWeaponMuzzlePos;
-
-			file << "\t\t\t\tweaponID: " << w->weaponNum << " (name: " << w->weaponDef->name << ")\n";
-			file << "\t\t\t\tweaponDir: <" << w->weaponDir.x << ", " << w->weaponDir.y << ", " << w->weaponDir.z << ">\n";
-			file << "\t\t\t\tabsWeaponPos: <" << awp.x << ", " << awp.y << ", " << awp.z << ">\n";
-			file << "\t\t\t\trelAimFromPos: <" << rwp.x << ", " << rwp.y << ", " << rwp.z << ">\n";
-			file << "\t\t\t\tabsWeaponMuzzlePos: <" << amp.x << ", " << amp.y << ", " << amp.z << ">\n";
-			file << "\t\t\t\trelWeaponMuzzlePos: <" << rmp.x << ", " << rmp.y << ", " << rmp.z << ">\n";
-			file << "\n";
+			buffer.BeginObject(OBJECT_WEAPON, w->weaponNum);
+			buffer.AddString(FIELD_name, w->weaponDef->name);
+			buffer.AddFloat3(FIELD_weaponDir, w->weaponDir);
+			buffer.AddFloat3(FIELD_absWeaponPos, w->aimFromPos);
+			buffer.AddFloat3(FIELD_relAimFromPos, w->relAimFromPos);
+			buffer.AddFloat3(FIELD_absWeaponMuzzlePos, w->weaponMuzzlePos);
+			buffer.AddFloat3(FIELD_relWeaponMuzzlePos, w->relWeaponMuzzlePos);
 		}
 		#endif
 
@@ -175,93 +326,79 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod)
 		const CCommandAI* cai = u->commandAI;
 		const CCommandQueue& cq = cai->commandQue;
 
-		file << "\t\t\tcommandAI:\n";
-		file << "\t\t\t\torderTarget->id: " << ((cai->orderTarget != nullptr)? cai->orderTarget->id: -1) << "\n";
-		file << "\t\t\t\tcommandQue.size(): " << cq.size() << "\n";
+		buffer.BeginObject(OBJECT_COMMANDAI, u->id);
+		buffer.AddInt(FIELD_orderTarget, (cai->orderTarget != nullptr)? cai->orderTarget->id: -1);
+		buffer.AddInt(FIELD_numCommands, cq.size());
+
+		int commandIdx = 0;
 
 		for (const Command& c: cq) {
-			file << "\t\t\t\t\tcommandID: " << c.GetID() << "\n";
-			file << "\t\t\t\t\ttag: " << c.GetTag() << ", options: " << c.GetOpts() << "\n";
-			file << "\t\t\t\t\tparams: " << c.GetNumParams() << "\n";
+			buffer.BeginObject(OBJECT_COMMAND, commandIdx++);
+			buffer.AddInt(FIELD_commandID, c.GetID());
+			buffer.AddInt(FIELD_tag, c.GetTag());
+			buffer.AddInt(FIELD_options, c.GetOpts());
 
 			for (unsigned int n = 0; n < c.GetNumParams(); n++) {
-				file << "\t\t\t\t\t\t" << c.GetParam(n) << "\n";
+				buffer.AddFloat(FIELD_param, c.GetParam(n));
 			}
 		}
 		#endif
 
 		#ifdef DUMP_UNIT_MOVETYPE_DATA
 		const AMoveType* amt = u->moveType;
-		const float3& goalPos = amt->goalPos;
-		const float3& oldUpdatePos = amt->oldPos;
-		const float3& oldSlowUpPos = amt->oldSlowUpdatePos;
-
-		file << "\t\t\tmoveType:\n";
-		file << "\t\t\t\tgoalPos: <" << goalPos.x << ", " << goalPos.y << ", " << goalPos.z << ">\n";
-		file << "\t\t\t\toldUpdatePos: <" << oldUpdatePos.x << ", " << oldUpdatePos.y << ", " << oldUpdatePos.z << ">\n";
-		file << "\t\t\t\toldSlowUpPos: <" << oldSlowUpPos.x << ", " << oldSlowUpPos.y << ", " << oldSlowUpPos.z << ">\n";
-		file << "\t\t\t\tmaxSpeed: " << amt->GetMaxSpeed() << ", maxWantedSpeed: " << amt->GetMaxWantedSpeed() << "\n";
-		file << "\t\t\t\tprogressState: " << amt->progressState << "\n";
+
+		buffer.BeginObject(OBJECT_MOVETYPE, u->id);
+		buffer.AddFloat3(FIELD_goalPos, amt->goalPos);
+		buffer.AddFloat3(FIELD_oldUpdatePos, amt->oldPos);
+		buffer.AddFloat3(FIELD_oldSlowUpPos, amt->oldSlowUpdatePos);
+		buffer.AddFloat(FIELD_maxSpeed, amt->GetMaxSpeed());
+		buffer.AddFloat(FIELD_maxWantedSpeed, amt->GetMaxWantedSpeed());
+		buffer.AddInt(FIELD_progressState, amt->progressState);
 		#endif
 	}
 	#endif
 
-	file << "\tfeatures: " << activeFeatureIDs.size() << "\n";
-
 	#ifdef DUMP_FEATURE_DATA
 	for (const int featureID: activeFeatureIDs) {
 		const CFeature* f = featureHandler.GetFeature(featureID);
 
-		file << "\t\tfeatureID: " << f->id << " (name: " << f->def->name << ")\n";
-		file << "\t\t\tpos: <" << f->pos.x << ", " << f->pos.y << ", " << f->pos.z << ">\n";
-		file << "\t\t\thealth: " << f->health << ", reclaimLeft: " << f->reclaimLeft << "\n";
+		buffer.BeginObject(OBJECT_FEATURE, f->id);
+		buffer.AddString(FIELD_name, f->def->name);
+		buffer.AddFloat3(FIELD_pos, f->pos);
+		buffer.AddFloat(FIELD_health, f->health);
+		buffer.AddFloat(FIELD_reclaimLeft, f->reclaimLeft);
 	}
 	#endif
 
-	file << "\tprojectiles: " << projectiles.size() << "\n";
-
 	#ifdef DUMP_PROJECTILE_DATA
 	for (const CProjectile* p: projectiles) {
-		file << "\t\tprojectileID: " << p->id << "\n";
-		file << "\t\t\tpos: <" << p->pos.x << ", " << p->pos.y << ", " << p->pos.z << ">\n";
-		file << "\t\t\tdir: <" << p->dir.x << ", " << p->dir.y << ", " << p->dir.z << ">\n";
-		file << "\t\t\tspeed: <" << p->speed.x << ", " << p->speed.y << ", " << p->speed.z << ">\n";
-		file << "\t\t\tweapon: " << p->weapon << ", piece: " << p->piece << "\n";
-		file << "\t\t\tcheckCol: " << p->checkCol << ", deleteMe: " << p->deleteMe << "\n";
+		buffer.BeginObject(OBJECT_PROJECTILE, p->id);
+		buffer.AddFloat3(FIELD_pos, p->pos);
+		buffer.AddFloat3(FIELD_dir, p->dir);
+		buffer.AddFloat3(FIELD_speed, p->speed);
+		buffer.AddInt(FIELD_weapon, p->weapon);
+		buffer.AddInt(FIELD_piece, p->piece);
+		buffer.AddInt(FIELD_checkCol, p->checkCol);
+		buffer.AddInt(FIELD_deleteMe, p->deleteMe);
 	}
 	#endif
 
-	file << "\tteams: " << teamHandler.ActiveTeams() << "\n";
-
 	#ifdef DUMP_TEAM_DATA
 	for (int a = 0; a < teamHandler.ActiveTeams(); ++a) {
 		const CTeam* t = teamHandler.Team(a);
 
-		file << "\t\tteamID: " << t->teamNum << " (controller: " << t->GetControllerName() << ")\n";
-		file << "\t\t\tmetal: " << float(t->res.metal) << ", energy: " << float(t->res.energy) << "\n";
-		file << "\t\t\tmetalPull: " << t->resPull.metal << ", energyPull: " << t->resPull.energy << "\n";
-		file << "\t\t\tmetalIncome: " << t->resIncome.metal << ", energyIncome: " << t->resIncome.energy << "\n";
-		file << "\t\t\tmetalExpense: " << t->resExpense.metal << ", energyExpense: " << t->resExpense.energy << "\n";
-	}
-	#endif
-
-	file << "\tallyteams: " << teamHandler.ActiveAllyTeams() << "\n";
-
-	#ifdef DUMP_ALLYTEAM_DATA
-	for (int a = 0; a < teamHandler.ActiveAllyTeams(); ++a) {
-		file << "\t\tallyteamID: " << a << ", LOS-map:" << "\n";
-
-		for (int y = 0; y < losHandler->losSizeY; ++y) {
-			file << " ";
-
-			for (int x = 0; x < losHandler->losSizeX; ++x) {
-				file << "\t\t\t" << losHandler->losMaps[a][y * losHandler->losSizeX + x] << " ";
-			}
-
-			file << "\n";
-		}
+		buffer.BeginObject(OBJECT_TEAM, t->teamNum);
+		buffer.AddString(FIELD_controller, t->GetControllerName());
+		buffer.AddFloat(FIELD_metal, t->res.metal);
+		buffer.AddFloat(FIELD_energy, t->res.energy);
+		buffer.AddFloat(FIELD_metalPull, t->resPull.metal);
+		buffer.AddFloat(FIELD_energyPull, t->resPull.energy);
+		buffer.AddFloat(FIELD_metalIncome, t->resIncome.metal);
+		buffer.AddFloat(FIELD_energyIncome, t->resIncome.energy);
+		buffer.AddFloat(FIELD_metalExpense, t->resExpense.metal);
+		buffer.AddFloat(FIELD_energyExpense, t->resExpense.energy);
 	}
 	#endif
 
-	file.flush();
+	writer.Push(buffer);
 }
@@ -0,0 +1,171 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef DUMPSTATE_FORMAT_H
+#define DUMPSTATE_FORMAT_H
+
+#include <cstdint>
+
+// Layout of the (gzip-compressed) binary files written by DumpState and read
+// by tools/DumpStateTool; shared between both so it can not depend on any
+// other engine header.
+//
+// After decompression a dump is MAGIC, VERSION (uint32) and a flat sequence
+// of records. Each record starts with one code byte:
+//   code <  FIELD_BASE: begins an object, followed by its id (int32); later
+//                       fields belong to the most recent object
+//   code >= FIELD_BASE: a field, followed by its payload as given by the type
+//                       of the field (INT: int32, FLOAT: raw float bits as
+//                       uint32, FLOAT3: three of those, STRING: uint16 length
+//                       plus characters)
+// All values are stored in host byte-order, dumps are only ever compared
+// between clients of the same build. Floats are stored bit-exact so the diff
+// tool can spot divergence a text dump would have rounded away.
+namespace DumpStateFormat {
+	static constexpr char MAGIC[8] = "SPRDUMP";
+	static constexpr uint32_t VERSION = 1;
+
+	// X(name, depth); objects are nested in those of lower depth
+	#define DUMPSTATE_OBJECTS(X) \
+		X(HEADER    , 0) \
+		X(FRAME     , 0) \
+		X(UNIT      , 1) \
+		X(FEATURE   , 1) \
+		X(PROJECTILE, 1) \
+		X(TEAM      , 1) \
+		X(PIECE     , 2) \
+		X(WEAPON    , 2) \
+		X(COMMANDAI , 2) \
+		X(MOVETYPE  , 2) \
+		X(COMMAND   , 3)
+
+	// X(name, type)
+	#define DUMPSTATE_FIELDS(X) \
+		X(mapName           , STRING) \
+		X(modName           , STRING) \
+		X(minFrame          , INT   ) \
+		X(maxFrame          , INT   ) \
+		X(randSeed          , INT   ) \
+		X(initSeed          , INT   ) \
+		X(seed              , INT   ) \
+		X(name              , STRING) \
+		X(parentName        , STRING) \
+		X(pos               , FLOAT3) \
+		X(rot               , FLOAT3) \
+		X(dir               , FLOAT3) \
+		X(speed             , FLOAT3) \
+		X(xdir              , FLOAT3) \
+		X(ydir              , FLOAT3) \
+		X(zdir              , FLOAT3) \
+		X(heading           , INT   ) \
+		X(mapSquare         , INT   ) \
+		X(health            , FLOAT ) \
+		X(experience        , FLOAT ) \
+		X(reclaimLeft       , FLOAT ) \
+		X(isDead            , INT   ) \
+		X(activated         , INT   ) \
+		X(visible           , INT   ) \
+		X(physicalState     , INT   ) \
+		X(fireState         , INT   ) \
+		X(moveState         , INT   ) \
+		X(numPieces         , INT   ) \
+		X(numWeapons        , INT   ) \
+		X(weaponDir         , FLOAT3) \
+		X(absWeaponPos      , FLOAT3) \
+		X(relAimFromPos     , FLOAT3) \
+		X(absWeaponMuzzlePos, FLOAT3) \
+		X(relWeaponMuzzlePos, FLOAT3) \
+		X(orderTarget       , INT   ) \
+		X(numCommands       , INT   ) \
+		X(commandID         , INT   ) \
+		X(tag               , INT   ) \
+		X(options           , INT   ) \
+		X(param             , FLOAT ) \
+		X(goalPos           , FLOAT3) \
+		X(oldUpdatePos      , FLOAT3) \
+		X(oldSlowUpPos      , FLOAT3) \
+		X(maxSpeed          , FLOAT ) \
+		X(maxWantedSpeed    , FLOAT ) \
+		X(progressState     , INT   ) \
+		X(weapon            , INT   ) \
+		X(piece             , INT   ) \
+		X(checkCol          , INT   ) \
+		X(deleteMe          , INT   ) \
+		X(controller        , STRING) \
+		X(metal             , FLOAT ) \
+		X(energy            , FLOAT ) \
+		X(metalPull         , FLOAT ) \
+		X(energyPull        , FLOAT ) \
+		X(metalIncome       , FLOAT ) \
+		X(energyIncome      , FLOAT ) \
+		X(metalExpense      , FLOAT ) \
+		X(energyExpense     , FLOAT )
+
+
+	enum FieldType: uint8_t {
+		TYPE_INT,
+		TYPE_FLOAT,
+		TYPE_FLOAT3,
+		TYPE_STRING,
+	};
+
+	enum Object: uint8_t {
+		#define DUMPSTATE_OBJECT_ENUM(name, depth) OBJECT_##name,
+		DUMPSTATE_OBJECTS(DUMPSTATE_OBJECT_ENUM)
+		#undef DUMPSTATE_OBJECT_ENUM
+		OBJECT_COUNT
+	};
+
+	static constexpr uint8_t FIELD_BASE = 0x20;
+	static_assert(OBJECT_COUNT <= FIELD_BASE, "");
+
+	enum Field: uint8_t {
+		FIELD_FIRST = FIELD_BASE - 1,
+		#define DUMPSTATE_FIELD_ENUM(name, type) FIELD_##name,
+		DUMPSTATE_FIELDS(DUMPSTATE_FIELD_ENUM)
+		#undef DUMPSTATE_FIELD_ENUM
+		FIELD_LAST
+	};
+
+	static constexpr uint32_t MAX_OBJECT_DEPTH = 4;
+
+
+	static inline const char* GetObjectName(uint8_t code) {
+		constexpr const char* names[] = {
+			#define DUMPSTATE_OBJECT_NAME(name, depth) #name,
+			DUMPSTATE_OBJECTS(DUMPSTATE_OBJECT_NAME)
+			#undef DUMPSTATE_OBJECT_NAME
+		};
+		return ((code < OBJECT_COUNT)? names[code]: "[unknown]");
+	}
+
+	static inline uint32_t GetObjectDepth(uint8_t code) {
+		constexpr uint32_t depths[] = {
+			#define DUMPSTATE_OBJECT_DEPTH(name, depth) depth,
+			DUMPSTATE_OBJECTS(DUMPSTATE_OBJECT_DEPTH)
+			#undef DUMPSTATE_OBJECT_DEPTH
+		};
+		return ((code < OBJECT_COUNT)? depths[code]: 0);
+	}
+
+	static inline bool IsValidField(uint8_t code) { return (code > FIELD_FIRST && code < FIELD_LAST); }
+
+	static inline const char* GetFieldName(uint8_t code) {
+		constexpr const char* names[] = {
+			#define DUMPSTATE_FIELD_NAME(name, type) #name,
+			DUMPSTATE_FIELDS(DUMPSTATE_FIELD_NAME)
+			#undef DUMPSTATE_FIELD_NAME
+		};
+		return (IsValidField(code)? names[code - FIELD_BASE]: "[unknown]");
+	}
+
+	static inline FieldType GetFieldType(uint8_t code) {
+		constexpr FieldType types[] = {
+			#define DUMPSTATE_FIELD_TYPE(name, type) TYPE_##type,
+			DUMPSTATE_FIELDS(DUMPSTATE_FIELD_TYPE)
+			#undef DUMPSTATE_FIELD_TYPE
+		};
+		return (IsValidField(code)? types[code - FIELD_BASE]: TYPE_INT);
+	}
+};
+
+#endif // DUMPSTATE_FORMAT_H
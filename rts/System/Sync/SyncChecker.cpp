@@ -9,5 +9,8 @@
 unsigned CSyncChecker::g_checksum;
 int CSyncChecker::inSyncedCode;
 
+std::vector<CSyncChecker::Lane> CSyncChecker::laneChecksums;
+thread_local unsigned* CSyncChecker::curChecksum = &CSyncChecker::g_checksum;
+
 
 #endif // SYNCDEBUG
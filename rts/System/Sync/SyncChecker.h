@@ -10,6 +10,7 @@
 #endif
 
 #include <assert.h>
+#include <vector>
 
 /**
  * @brief sync checker class
@@ -33,48 +34,76 @@ class CSyncChecker {
 		static unsigned GetChecksum() { return g_checksum; }
 		static void NewFrame() { g_checksum = 0xfade1eaf; }
 
+		/**
+		 * Per-task checksum lanes, see CSyncLanes. While a thread is inside a
+		 * lane its assignments go to that lane's checksum instead of the global
+		 * one; EndLanes folds all lanes into it in lane-index order, so the
+		 * result does not depend on which thread ran which task or when.
+		 */
+		static void BeginLanes(unsigned numLanes) {
+			assert(laneChecksums.empty());
+			laneChecksums.resize(numLanes);
+		}
+		static void EndLanes() {
+			assert(curChecksum == &g_checksum);
+
+			for (const Lane& lane: laneChecksums) {
+				Sync(&lane.checksum, sizeof(lane.checksum));
+			}
+
+			laneChecksums.clear();
+		}
+		static void EnterLane(unsigned laneIdx) {
+			assert(laneIdx < laneChecksums.size());
+			assert(curChecksum == &g_checksum);
+			curChecksum = &laneChecksums[laneIdx].checksum;
+		}
+		static void LeaveLane() { curChecksum = &g_checksum; }
+
 		static void Sync(const void* p, unsigned size) {
+			unsigned& checksum = *curChecksum;
+
 			// most common cases first, make it easy for compiler to optimize for it
 			// simple xor is not enough to detect multiple zeroes, e.g.
 #ifdef TRACE_SYNC_HEAVY
-			g_checksum = HsiehHash((const char*)p, size, g_checksum);
+			checksum = HsiehHash((const char*)p, size, checksum);
 #else
 			switch(size) {
 			case 1:
-				g_checksum += *(const unsigned char*)p;
-				g_checksum ^= g_checksum << 10;
-				g_checksum += g_checksum >> 1;
+				checksum += *(const unsigned char*)p;
+				checksum ^= checksum << 10;
+				checksum += checksum >> 1;
 				break;
 			case 2:
-				g_checksum += *(const unsigned short*)(const char*)p;
-				g_checksum ^= g_checksum << 11;
-				g_checksum += g_checksum >> 17;
+				checksum += *(const unsigned short*)(const char*)p;
+				checksum ^= checksum << 11;
+				checksum += checksum >> 17;
 				break;
 			case 3:
 				// just here to make the switch statements contiguous (so it can be optimized)
 				for (unsigned i = 0; i < 3; ++i) {
-					g_checksum += *(const unsigned char*)p + i;
-					g_checksum ^= g_checksum << 10;
-					g_checksum += g_checksum >> 1;
+					checksum += *(const unsigned char*)p + i;
+					checksum ^= checksum << 10;
+					checksum += checksum >> 1;
 				}
 				break;
 			case 4:
-				g_checksum += *(const unsigned int*)(const char*)p;
-				g_checksum ^= g_checksum << 16;
-				g_checksum += g_checksum >> 11;
+				checksum += *(const unsigned int*)(const char*)p;
+				checksum ^= checksum << 16;
+				checksum += checksum >> 11;
 				break;
 			default:
 			{
 				unsigned i = 0;
 				for (; i < (size & ~3) / 4; ++i) {
-					g_checksum += *(reinterpret_cast<const unsigned int*>(p) + i);
-					g_checksum ^= g_checksum << 16;
-					g_checksum += g_checksum >> 11;
+					checksum += *(reinterpret_cast<const unsigned int*>(p) + i);
+					checksum ^= checksum << 16;
+					checksum += checksum >> 11;
 				}
 				for (; i < size; ++i) {
-					g_checksum += *(const unsigned char*)p + i;
-					g_checksum ^= g_checksum << 10;
-					g_checksum += g_checksum >> 1;
+					checksum += *(const unsigned char*)p + i;
+					checksum ^= checksum << 10;
+					checksum += checksum >> 1;
 				}
 				break;
 			}
@@ -89,6 +118,19 @@ class CSyncChecker {
 		 */
 		static unsigned g_checksum;
 
+		// one cache-line per lane, adjacent tasks tend to run on different threads
+		struct alignas(64) Lane {
+			unsigned checksum = 0xfade1eaf;
+		};
+
+		static std::vector<Lane> laneChecksums;
+
+		/**
+		 * Where Sync accumulates into for the calling thread;
+		 * either g_checksum or the checksum of a lane.
+		 */
+		static thread_local unsigned* curChecksum;
+
 		/**
 		 * @brief in synced code
 		 *
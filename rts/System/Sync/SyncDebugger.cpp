@@ -53,6 +53,9 @@ LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_SYNC_DEBUGGER)
 static CLogger logger;
 
 
+thread_local int CSyncDebugger::curLane = -1;
+
+
 CSyncDebugger* CSyncDebugger::GetInstance() {
 	static CSyncDebugger instance;
 	return &instance;
@@ -120,15 +123,25 @@ void CSyncDebugger::Sync(const void* p, unsigned size, const char* op)
 	}
 
 	HistItem* h = &history[historyIndex];
+	HistItemWithBacktrace* hbt = nullptr;
+
+	if (curLane >= 0) {
+		// buffered until EndLanes, the item is committed in lane order
+		laneHistories[curLane].emplace_back();
+		h = hbt = &laneHistories[curLane].back();
+	}
 
 #ifdef HAVE_BACKTRACE
 	if (historybt) {
+		if (hbt == nullptr)
+			hbt = &historybt[historyIndex];
+
 		// HACK to skip the uppermost 2 or 3 (32 resp. 64 bit) frames without memcpy'ing the whole backtrace
 		const int frameskip = (8 + sizeof(void*)) / sizeof(void*);
-		historybt[historyIndex].bt_size = backtrace(historybt[historyIndex].bt - frameskip, MAX_STACK + frameskip) - frameskip;
-		historybt[historyIndex].op = op;
-		historybt[historyIndex].frameNum = gs->frameNum;
-		h = &historybt[historyIndex];
+		hbt->bt_size = backtrace(hbt->bt - frameskip, MAX_STACK + frameskip) - frameskip;
+		hbt->op = op;
+		hbt->frameNum = gs->frameNum;
+		h = hbt;
 	}
 #endif
 
@@ -151,6 +164,25 @@ void CSyncDebugger::Sync(const void* p, unsigned size, const char* op)
 			h->data ^= *((const unsigned char*) p + i);
 	}
 
+	if (curLane >= 0) {
+		return;
+	}
+
+	if (++historyIndex == HISTORY_SIZE * BLOCK_SIZE) {
+		historyIndex = 0; // wrap around
+	}
+	++flop;
+}
+
+
+void CSyncDebugger::CommitLaneItem(const HistItemWithBacktrace& item)
+{
+	if (historybt) {
+		historybt[historyIndex] = item;
+	} else {
+		history[historyIndex].data = item.data;
+	}
+
 	if (++historyIndex == HISTORY_SIZE * BLOCK_SIZE) {
 		historyIndex = 0; // wrap around
 	}
@@ -158,6 +190,28 @@ void CSyncDebugger::Sync(const void* p, unsigned size, const char* op)
 }
 
 
+void CSyncDebugger::BeginLanes(unsigned numLanes)
+{
+	// inner vectors keep their capacity between phases
+	laneHistories.resize(numLanes);
+}
+
+void CSyncDebugger::EndLanes()
+{
+	assert(curLane == -1);
+
+	for (std::vector<HistItemWithBacktrace>& laneHistory: laneHistories) {
+		if (history || historybt) {
+			for (const HistItemWithBacktrace& item: laneHistory) {
+				CommitLaneItem(item);
+			}
+		}
+
+		laneHistory.clear();
+	}
+}
+
+
 void CSyncDebugger::Backtrace(int index, const char* prefix) const
 {
 	if (historybt) {
@@ -98,6 +98,16 @@ class CSyncDebugger {
 		bool mayEnableHistory;             ///< Is it safe already to set disableHistory = false?
 		std::uint64_t flop;                ///< Current (local) operation number.
 
+		/**
+		 * @brief per-lane history, see CSyncLanes
+		 *
+		 * Assignments made inside a lane are buffered here and appended to the
+		 * history in lane-index order by EndLanes, so history blocks compare
+		 * equal between clients even if the lanes ran in a different order.
+		 */
+		std::vector<std::vector<HistItemWithBacktrace>> laneHistories;
+		static thread_local int curLane;   ///< Lane the calling thread is in, or -1.
+
 		// server thread
 
 		struct PlayerStruct
@@ -177,6 +187,13 @@ class CSyncDebugger {
 		 * & line number.
 		 */
 		void ServerDumpStack();
+		/**
+		 * @brief append an item to the history
+		 *
+		 * Copies item (including its backtrace when the history has them) to
+		 * the current history index and advances it.
+		 */
+		void CommitLaneItem(const HistItemWithBacktrace& item);
 
 	public:
 
@@ -189,6 +206,18 @@ class CSyncDebugger {
 		 */
 		void Sync(const void* p, unsigned size, const char* op);
 
+		/**
+		 * @brief lanes for parallel sim phases
+		 *
+		 * Called through CSyncLanes; between BeginLanes and EndLanes threads
+		 * must EnterLane with their task-index before assigning to synced
+		 * variables, EndLanes must be called by the sim thread.
+		 */
+		void BeginLanes(unsigned numLanes);
+		void EndLanes();
+		void EnterLane(unsigned laneIdx) { assert(laneIdx < laneHistories.size()); curLane = laneIdx; }
+		void LeaveLane() { curLane = -1; }
+
 		/**
 		 * @brief initialize
 		 *
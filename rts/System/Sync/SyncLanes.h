@@ -0,0 +1,91 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SYNC_LANES_H
+#define SYNC_LANES_H
+
+#include "SyncedPrimitiveBase.h"
+#include "System/Threading/ThreadPool.h"
+
+/**
+ * @brief sync accounting for parallel sim phases
+ *
+ * The sync checker and debugger normally fold every assignment to a synced
+ * variable into one running checksum / history, which makes such assignments
+ * from worker threads racy and their order non-deterministic. Within a phase
+ * each task instead accounts to its own lane (selected by task-index, NOT by
+ * thread) and the lanes are merged in index order when the phase ends. The
+ * result is the same on every client regardless of thread count or timing,
+ * provided each task itself is deterministic.
+ *
+ * Phases can not be nested and must be begun and ended by the sim thread.
+ */
+class CSyncLanes {
+public:
+	static void BeginPhase(unsigned numLanes) {
+	#ifdef SYNCCHECK
+		CSyncChecker::BeginLanes(numLanes);
+	#endif
+	#ifdef SYNCDEBUG
+		CSyncDebugger::GetInstance()->BeginLanes(numLanes);
+	#endif
+	}
+
+	static void EndPhase() {
+	#ifdef SYNCDEBUG
+		CSyncDebugger::GetInstance()->EndLanes();
+	#endif
+	#ifdef SYNCCHECK
+		CSyncChecker::EndLanes();
+	#endif
+	}
+
+	/**
+	 * Routes all synced assignments made by the calling thread to lane
+	 * <laneIdx> while in scope.
+	 */
+	class Scope {
+	public:
+		Scope(unsigned laneIdx) {
+		#ifdef SYNCCHECK
+			CSyncChecker::EnterLane(laneIdx);
+		#endif
+		#ifdef SYNCDEBUG
+			CSyncDebugger::GetInstance()->EnterLane(laneIdx);
+		#endif
+		}
+		~Scope() {
+		#ifdef SYNCDEBUG
+			CSyncDebugger::GetInstance()->LeaveLane();
+		#endif
+		#ifdef SYNCCHECK
+			CSyncChecker::LeaveLane();
+		#endif
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator = (const Scope&) = delete;
+	};
+};
+
+
+/**
+ * for_mt whose body may assign to synced variables; every index gets its own
+ * lane so the merged checksum is independent of how work is distributed
+ */
+template<typename F>
+static inline void for_mt_synced(int start, int end, F&& f)
+{
+	if (start >= end)
+		return;
+
+	CSyncLanes::BeginPhase(end - start);
+
+	for_mt(start, end, [&](const int i) {
+		CSyncLanes::Scope lane(i - start);
+		f(i);
+	});
+
+	CSyncLanes::EndPhase();
+}
+
+#endif // SYNC_LANES_H
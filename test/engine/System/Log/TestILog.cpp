@@ -9,6 +9,7 @@
 #include "lib/catch.hpp"
 
 #include <cstdarg>
+#include <cstring>
 #include <sstream>
 
 
@@ -233,3 +234,36 @@ TEST_CASE("IsEnabled")
 	TLOG_SL(   "other-one-time-section", L_DEBUG, "Testing LOG_IS_ENABLED_S");
 }
 
+
+
+TEST_CASE("AsyncFileSink")
+{
+	const auto CountLines = [](const std::string& fileName, const char* pattern) {
+		FILE* file = fopen(fileName.c_str(), "r");
+		char line[1024];
+		int count = 0;
+
+		REQUIRE(file != NULL);
+
+		while (fgets(line, sizeof(line), file) != NULL) {
+			count += (strstr(line, pattern) != NULL);
+		}
+
+		fclose(file);
+		return count;
+	};
+
+	// ring smaller than the number of records, so producers have to wait for the writer
+	log_file_setAsyncWriter(16, false);
+
+	for (int i = 0; i < 1000; i++) {
+		LOG("Testing asynchronous file sink: %i", i);
+	}
+
+	log_file_flushAsyncRecords();
+	log_file_setAsyncWriter(0, false);
+	fflush(log_file_getLogFileStream(ls.logFile.c_str()));
+
+	CHECK(CountLines(ls.logFile, "Testing asynchronous file sink") == 1000);
+	ls.logStream.str(std::string());
+}
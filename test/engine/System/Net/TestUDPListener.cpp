@@ -1,11 +1,18 @@
 
+#include "Net/Protocol/BaseNetProtocol.h"
+#include "System/Net/UDPConnection.h"
 #include "System/Net/UDPListener.h"
+#include "System/Misc/SpringTime.h"
 #include "System/Log/ILog.h"
 
+#include <cstring>
+
 
 #define CATCH_CONFIG_MAIN
 #include "lib/catch.hpp"
 
+InitSpringTime ist;
+
 class SocketTest {
 public:
 	SocketTest(){
@@ -89,3 +96,64 @@ TEST_CASE("TryBindSocket")
 	t.TestPort(-1, false);
 }
 
+
+TEST_CASE("DeflateRoundTrip")
+{
+	// two ends talking over loopback, only the first deflates its stream
+	netcode::UDPConnection a(11112, "127.0.0.1", 11113);
+	netcode::UDPConnection b(11113, "127.0.0.1", 11112);
+
+	a.Unmute();
+	b.Unmute();
+	a.SetCompression(true);
+
+	// packets with lastContinuous=-1 from a would otherwise look like
+	// reconnection attempts to b, so a must have received something
+	b.SendData(CBaseNetProtocol::Get().SendKeyFrame(0));
+
+	std::vector< std::shared_ptr<const netcode::RawPacket> > sent;
+
+	for (int i = 0; i < 256; ++i) {
+		// compressible text (some messages spanning several chunks) and frame-numbers
+		sent.push_back(CBaseNetProtocol::Get().SendQuit(std::string(1 + (i * 7) % 600, 'a' + (i % 26))));
+		sent.push_back(CBaseNetProtocol::Get().SendKeyFrame(i));
+	}
+
+	size_t numReceived = 0;
+
+	const auto Exchange = [&]() {
+		a.Flush(true);
+		b.Update();
+		b.Flush(true);
+		a.Update();
+
+		while (a.HasIncomingData()) {
+			a.GetData();
+		}
+
+		while (b.HasIncomingData()) {
+			const std::shared_ptr<const netcode::RawPacket> pkt = b.GetData();
+
+			REQUIRE(numReceived < sent.size());
+			REQUIRE(pkt->length == sent[numReceived]->length);
+			CHECK(std::memcmp(pkt->data, sent[numReceived]->data, pkt->length) == 0);
+
+			numReceived++;
+		}
+	};
+
+	for (size_t i = 0; i < sent.size(); ++i) {
+		a.SendData(sent[i]);
+
+		if ((i % 16) == 15)
+			Exchange();
+	}
+
+	for (int n = 0; n < 100 && numReceived < sent.size(); ++n) {
+		spring_sleep(spring_msecs(10));
+		Exchange();
+	}
+
+	CHECK(numReceived == sent.size());
+	CHECK(!b.CheckTimeout(1));
+}
@@ -2,6 +2,7 @@
 	#error "This test requires SYNCCHECK to be defined on the compiler command line."
 #endif
 #include "System/Sync/SyncedPrimitive.h"
+#include "System/Sync/SyncLanes.h"
 
 #define CATCH_CONFIG_MAIN
 #include "lib/catch.hpp"
@@ -39,3 +40,40 @@ TEST_CASE("ImplicitConversions")
 
 	LEAVE_SYNCED_CODE();
 }
+
+
+TEST_CASE("SyncLanes")
+{
+	ENTER_SYNCED_CODE();
+
+	// simulates a parallel phase whose tasks finish in arbitrary order
+	const auto RunPhase = [](const int order[4], int lastValue) {
+		SyncedSint values[4];
+
+		CSyncChecker::NewFrame();
+		CSyncLanes::BeginPhase(4);
+
+		for (int n = 0; n < 4; n++) {
+			const int i = order[n];
+
+			CSyncLanes::Scope lane(i);
+			values[i] = (i == 3)? lastValue: (i * 7);
+			values[i] += 1;
+		}
+
+		CSyncLanes::EndPhase();
+		return CSyncChecker::GetChecksum();
+	};
+
+	const int fwdOrder[4] = {0, 1, 2, 3};
+	const int revOrder[4] = {3, 2, 1, 0};
+	const int mixOrder[4] = {2, 0, 3, 1};
+
+	const unsigned fwdChecksum = RunPhase(fwdOrder, 21);
+
+	CHECK(fwdChecksum == RunPhase(revOrder, 21));
+	CHECK(fwdChecksum == RunPhase(mixOrder, 21));
+	CHECK(fwdChecksum != RunPhase(fwdOrder, 22));
+
+	LEAVE_SYNCED_CODE();
+}
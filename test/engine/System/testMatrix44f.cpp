@@ -1,6 +1,8 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include <xmmintrin.h> //SSE1
+#include <cstring>
+#include <vector>
 
 #include "System/Matrix44f.h"
 #include "System/float4.h"
@@ -284,3 +286,59 @@ TEST_CASE("Matrix44MatrixMultiply")
 		}
 	}
 }
+
+
+TEST_CASE("Matrix44MatrixConcat")
+{
+	static constexpr int numPoints = 1024;
+	static constexpr int numBatchRuns = testRuns / numPoints;
+
+	m44 mt;
+	for (int i = 0; i < 16; ++i) {
+		mt[i] = ((i == 3) || (i == 7))? 0.0f: float(i + 1) / 31.3125f;
+	}
+
+	std::vector<CMatrix44f> min(numPoints);
+	std::vector<CMatrix44f> mout(numPoints);
+
+	for (int i = 0; i < numPoints; ++i) {
+		min[i].RotateY(i * 0.01f);
+		min[i].Translate(float3(i * 0.5f - 100.0f, i * 0.25f, 3000.0f - i * 1.75f));
+	}
+
+	// batched results must be bit-identical to operator*
+	CMatrix44f::Concat(mt, min.data(), mout.data(), numPoints);
+	for (int i = 0; i < numPoints; ++i) {
+		const CMatrix44f mm = mt * min[i];
+		CHECK(memcmp(&mm, &mout[i], sizeof(CMatrix44f)) == 0);
+	}
+
+	// in-place, as CCollisionHandler uses it
+	mout = min;
+	CMatrix44f::Concat(mt, mout.data(), mout.data(), numPoints);
+	for (int i = 0; i < numPoints; ++i) {
+		const CMatrix44f mm = mt * min[i];
+		CHECK(memcmp(&mm, &mout[i], sizeof(CMatrix44f)) == 0);
+	}
+
+	int hashes[2] = {0, 0};
+
+	{
+		ScopedOnceTimer timer("Matrix-Matrix-Mult: spring (m * m2[i])");
+		for (int j = 0; j < numBatchRuns; ++j) {
+			for (int i = 0; i < numPoints; ++i) {
+				mout[i] = mt * min[i];
+			}
+		}
+		hashes[0] = HsiehHash(mout.data(), numPoints * sizeof(CMatrix44f), 0);
+	}
+	{
+		ScopedOnceTimer timer("Matrix-Matrix-Mult: batch (Concat)");
+		for (int j = 0; j < numBatchRuns; ++j) {
+			CMatrix44f::Concat(mt, min.data(), mout.data(), numPoints);
+		}
+		hashes[1] = HsiehHash(mout.data(), numPoints * sizeof(CMatrix44f), 0);
+	}
+
+	CHECK(hashes[0] == hashes[1]);
+}
@@ -0,0 +1,310 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gflags/gflags.h>
+#include <zlib.h>
+
+#include "System/Sync/DumpStateFormat.h"
+
+/*
+Usage:
+	dumpstatetool [options] ClientGameState-A.dump.gz [ClientGameState-B.dump.gz]
+
+With one file the dump is printed as text, with two files they are compared
+record by record and the first diverging object and field is reported. Both
+dumps have to cover the same frame range (same arguments to /DumpState).
+*/
+
+	DEFINE_bool  (print,     false, "Print the dump(s) as text instead of comparing them");
+	DEFINE_int32 (context,   0,     "Number of records preceding the first divergence to print");
+
+
+using namespace DumpStateFormat;
+
+struct Record {
+	uint8_t code = 0;
+
+	int32_t ivalue = 0;
+	uint32_t fvalue[3] = {0, 0, 0};
+	std::string svalue;
+
+	bool IsObject() const { return (code < FIELD_BASE); }
+
+	bool operator == (const Record& r) const {
+		if (code != r.code)
+			return false;
+		if (IsObject())
+			return (ivalue == r.ivalue);
+
+		switch (GetFieldType(code)) {
+			case TYPE_INT   : return (ivalue == r.ivalue);
+			case TYPE_FLOAT : return (fvalue[0] == r.fvalue[0]);
+			case TYPE_FLOAT3: return (std::memcmp(fvalue, r.fvalue, sizeof(fvalue)) == 0);
+			case TYPE_STRING: return (svalue == r.svalue);
+		}
+
+		return false;
+	}
+	bool operator != (const Record& r) const { return !(*this == r); }
+
+	std::string ValueToString() const {
+		std::ostringstream s;
+		s.precision(9);
+
+		const auto toFloat = [](uint32_t bits) { float f; std::memcpy(&f, &bits, sizeof(f)); return f; };
+
+		if (IsObject()) {
+			s << ivalue;
+			return s.str();
+		}
+
+		switch (GetFieldType(code)) {
+			case TYPE_INT   : { s << ivalue; } break;
+			case TYPE_FLOAT : { s << toFloat(fvalue[0]) << std::hex << " (0x" << fvalue[0] << ")"; } break;
+			case TYPE_FLOAT3: { s << "<" << toFloat(fvalue[0]) << ", " << toFloat(fvalue[1]) << ", " << toFloat(fvalue[2]) << ">"; } break;
+			case TYPE_STRING: { s << svalue; } break;
+		}
+
+		return s.str();
+	}
+
+	std::string ToString() const {
+		if (IsObject())
+			return (std::string(GetObjectName(code)) + " " + ValueToString());
+
+		return (std::string(GetFieldName(code)) + ": " + ValueToString());
+	}
+};
+
+
+class DumpReader {
+public:
+	DumpReader(const std::string& fileName): name(fileName) {
+		if ((gzf = gzopen(fileName.c_str(), "rb")) == nullptr) {
+			std::cerr << "could not open " << fileName << std::endl;
+			return;
+		}
+
+		char magic[sizeof(MAGIC)];
+		uint32_t version = 0;
+
+		if (!Read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+			std::cerr << fileName << " is not a DumpState file" << std::endl;
+			Close();
+			return;
+		}
+		if (!Read(&version, sizeof(version)) || version != VERSION) {
+			std::cerr << fileName << " has version " << version << ", expected " << VERSION << std::endl;
+			Close();
+			return;
+		}
+	}
+
+	~DumpReader() { Close(); }
+
+	bool IsOpen() const { return (gzf != nullptr); }
+	const std::string& GetName() const { return name; }
+
+	bool Next(Record& r) {
+		if (!Read(&r.code, sizeof(r.code)))
+			return false;
+
+		if (r.IsObject()) {
+			if (r.code >= OBJECT_COUNT)
+				return Corrupt(r);
+			return Read(&r.ivalue, sizeof(r.ivalue));
+		}
+
+		if (!IsValidField(r.code))
+			return Corrupt(r);
+
+		switch (GetFieldType(r.code)) {
+			case TYPE_INT   : { return Read(&r.ivalue, sizeof(r.ivalue)); } break;
+			case TYPE_FLOAT : { return Read(&r.fvalue[0], sizeof(r.fvalue[0])); } break;
+			case TYPE_FLOAT3: { return Read(&r.fvalue[0], sizeof(r.fvalue)); } break;
+			case TYPE_STRING: {
+				uint16_t size = 0;
+
+				if (!Read(&size, sizeof(size)))
+					return false;
+
+				r.svalue.resize(size);
+				return (size == 0 || Read(&r.svalue[0], size));
+			} break;
+		}
+
+		return false;
+	}
+
+private:
+	bool Read(void* dst, unsigned int size) {
+		return (gzf != nullptr && gzread(gzf, dst, size) == int(size));
+	}
+
+	bool Corrupt(const Record& r) {
+		std::cerr << name << " contains unknown record code " << int(r.code) << std::endl;
+		return false;
+	}
+
+	void Close() {
+		if (gzf != nullptr)
+			gzclose(gzf);
+
+		gzf = nullptr;
+	}
+
+private:
+	std::string name;
+	gzFile gzf = nullptr;
+};
+
+
+// tracks which (nested) objects the current record belongs to
+class ObjectPath {
+public:
+	void Update(const Record& r) {
+		if (!r.IsObject())
+			return;
+
+		depth = std::min(GetObjectDepth(r.code), MAX_OBJECT_DEPTH - 1);
+		objects[depth] = r;
+	}
+
+	std::string ToString() const {
+		std::string s;
+
+		for (uint32_t i = 0; i <= depth; i++) {
+			if (i > 0)
+				s += " > ";
+
+			s += objects[i].ToString();
+		}
+
+		return s;
+	}
+
+private:
+	Record objects[MAX_OBJECT_DEPTH];
+	uint32_t depth = 0;
+};
+
+
+static int PrintDump(DumpReader& reader)
+{
+	Record r;
+
+	uint32_t depth = 0;
+
+	while (reader.Next(r)) {
+		if (r.IsObject()) {
+			depth = GetObjectDepth(r.code);
+			std::cout << std::string(depth, '\t') << r.ToString() << "\n";
+		} else {
+			std::cout << std::string(depth + 1, '\t') << r.ToString() << "\n";
+		}
+	}
+
+	return 0;
+}
+
+static int DiffDumps(DumpReader& readerA, DumpReader& readerB)
+{
+	// ring of the most recent records for --context
+	std::vector<Record> history(std::max(FLAGS_context, 0));
+
+	Record ra;
+	Record rb;
+
+	ObjectPath pathA;
+	ObjectPath pathB;
+
+	for (uint64_t n = 0; ; n++) {
+		const bool haveA = readerA.Next(ra);
+		const bool haveB = readerB.Next(rb);
+
+		if (!haveA && !haveB) {
+			std::cout << "dumps are identical (" << n << " records)" << std::endl;
+			return 0;
+		}
+
+		pathA.Update(ra);
+		pathB.Update(rb);
+
+		if (haveA && haveB && ra == rb) {
+			if (!history.empty())
+				history[n % history.size()] = ra;
+
+			continue;
+		}
+
+		std::cout << "first divergence at record " << n << ":" << std::endl;
+
+		for (uint64_t k = std::min(n, uint64_t(history.size())); k > 0; k--) {
+			std::cout << "\t" << history[(n - k) % history.size()].ToString() << "\n";
+		}
+
+		if (!haveA) { std::cout << "\t" << readerA.GetName() << " ends here" << std::endl; return 1; }
+		if (!haveB) { std::cout << "\t" << readerB.GetName() << " ends here" << std::endl; return 1; }
+
+		std::cout << "\t" << readerA.GetName() << ": " << pathA.ToString();
+		std::cout << (ra.IsObject()? "\n": (" > " + ra.ToString() + "\n"));
+		std::cout << "\t" << readerB.GetName() << ": " << pathB.ToString();
+		std::cout << (rb.IsObject()? "\n": (" > " + rb.ToString() + "\n"));
+		return 1;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	gflags::SetUsageMessage(std::string("Usage: ") + argv[0] + " [options] dumpA.dump.gz [dumpB.dump.gz]");
+	gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+	if (argc < 2) {
+		std::cout << "No dump file given" << std::endl;
+		gflags::ShowUsageWithFlags(argv[0]);
+		return 1;
+	}
+
+	if (FLAGS_print) {
+		int ret = 0;
+
+		// print every given dump, each under its own name when there are several
+		for (int i = 1; i < argc; i++) {
+			DumpReader reader(argv[i]);
+
+			if (!reader.IsOpen()) {
+				ret = 1;
+				continue;
+			}
+
+			if (argc > 2)
+				std::cout << "== " << reader.GetName() << " ==\n";
+
+			ret |= PrintDump(reader);
+		}
+
+		return ret;
+	}
+
+	DumpReader readerA(argv[1]);
+
+	if (!readerA.IsOpen())
+		return 1;
+
+	if (argc < 3)
+		return (PrintDump(readerA));
+
+	DumpReader readerB(argv[2]);
+
+	if (!readerB.IsOpen())
+		return 1;
+
+	return (DiffDumps(readerA, readerB));
+}
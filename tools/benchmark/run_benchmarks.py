@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+# This file is part of the Spring engine (GPL v2 or later), see LICENSE.html
+
+"""
+Runs the canned sim benchmark scenarios on spring-headless and collects the
+JSON written by the engine (see BenchmarkFrames) into one results file. With
+--baseline the results are compared against an earlier run and the script
+exits non-zero if any scenario regressed by more than --threshold percent.
+
+See README.md in this directory for details.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+
+SCENARIOS = ["mass_spawn", "large_battle", "terraform", "path_flood", "projectile_storm"]
+
+MUTATOR_NAME = "Spring Benchmark Scenarios"
+MUTATOR_DIR = "spring_benchmark_scenarios.sdd"
+
+# compared against the baseline, lower is better for all of them
+TRACKED_METRICS = [
+	("frameTimeMs.mean", lambda r: r["frameTimeMs"]["mean"]),
+	("frameTimeMs.p99",  lambda r: r["frameTimeMs"]["p99"]),
+	("peakRSSBytes",     lambda r: r["peakRSSBytes"]),
+]
+
+SCRIPT_TEMPLATE = """[GAME]
+{{
+	HostIP=127.0.0.1;
+	IsHost=1;
+	MyPlayerName=Benchmark;
+	Mapname={map};
+	GameType={game};
+	GameID=00000000000000000000000000000000;
+	StartPosType=0;
+
+	[MODOPTIONS]
+	{{
+		MinSpeed=1;
+		MaxSpeed=1000;
+		benchmark_scenario={scenario};
+{extraModOptions}
+	}}
+
+	[PLAYER0]
+	{{
+		Name=Benchmark;
+		Spectator=1;
+		Team=0;
+	}}
+
+	[AI0]
+	{{
+		Name=Bench0;
+		ShortName=NullAI;
+		Version=0.1;
+		Team=0;
+		Host=0;
+	}}
+	[AI1]
+	{{
+		Name=Bench1;
+		ShortName=NullAI;
+		Version=0.1;
+		Team=1;
+		Host=0;
+	}}
+
+	[TEAM0]
+	{{
+		TeamLeader=0;
+		AllyTeam=0;
+	}}
+	[TEAM1]
+	{{
+		TeamLeader=0;
+		AllyTeam=1;
+	}}
+
+	[ALLYTEAM0]
+	{{
+		NumAllies=0;
+	}}
+	[ALLYTEAM1]
+	{{
+		NumAllies=0;
+	}}
+}}
+"""
+
+
+def InstallMutator(writeDir, baseGame):
+	srcDir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "scenarios")
+	dstDir = os.path.join(writeDir, "games", MUTATOR_DIR)
+
+	if os.path.isdir(dstDir):
+		shutil.rmtree(dstDir)
+
+	shutil.copytree(srcDir, dstDir)
+
+	with open(os.path.join(dstDir, "modinfo.lua"), "w") as f:
+		f.write('return {\n')
+		f.write('\tname = "%s",\n' % MUTATOR_NAME)
+		f.write('\tshortname = "SBS",\n')
+		f.write('\tversion = "1",\n')
+		f.write('\tmutator = "1",\n')
+		f.write('\tdescription = "sim benchmark scenarios, see tools/benchmark",\n')
+		f.write('\tmodtype = 1,\n')
+		f.write('\tdepend = {\n\t\t"%s",\n\t},\n' % baseGame)
+		f.write('}\n')
+
+	return MUTATOR_NAME + " 1"
+
+
+def RunScenario(args, gameName, scenario):
+	runDir = os.path.join(args.output, scenario)
+	os.makedirs(runDir, exist_ok=True)
+
+	resultFile = os.path.join(runDir, "benchmark.json")
+	scriptFile = os.path.join(runDir, "script.txt")
+	configFile = os.path.join(runDir, "springsettings.cfg")
+
+	if os.path.exists(resultFile):
+		os.remove(resultFile)
+
+	extraModOptions = "".join("\t\t%s;\n" % o for o in args.modoption)
+
+	with open(scriptFile, "w") as f:
+		f.write(SCRIPT_TEMPLATE.format(map=args.map, game=gameName, scenario=scenario, extraModOptions=extraModOptions.rstrip("\n")))
+
+	with open(configFile, "w") as f:
+		f.write("BenchmarkFrames = %d\n" % args.frames)
+		f.write("BenchmarkStartFrame = %d\n" % args.warmup)
+		f.write("BenchmarkOutput = %s\n" % resultFile)
+
+	cmd = [args.spring, "--write-dir", args.write_dir, "--config", configFile, scriptFile]
+
+	with open(os.path.join(runDir, "stdout.txt"), "w") as log:
+		try:
+			subprocess.run(cmd, stdout=log, stderr=subprocess.STDOUT, timeout=args.timeout, check=False)
+		except subprocess.TimeoutExpired:
+			print("[%s] timed out after %ds" % (scenario, args.timeout))
+			return None
+
+	if not os.path.exists(resultFile):
+		print("[%s] no results written, see %s" % (scenario, os.path.join(runDir, "stdout.txt")))
+		return None
+
+	with open(resultFile) as f:
+		return json.load(f)
+
+
+def CompareResults(results, baseline, threshold):
+	regressions = 0
+
+	print("%-18s %-18s %14s %14s %9s" % ("scenario", "metric", "baseline", "current", "change"))
+
+	for scenario, result in sorted(results.items()):
+		if scenario not in baseline:
+			continue
+
+		for name, getter in TRACKED_METRICS:
+			old = getter(baseline[scenario])
+			new = getter(result)
+			change = ((new - old) * 100.0 / old) if (old > 0) else 0.0
+			regressed = (change > threshold)
+			regressions += regressed
+
+			print("%-18s %-18s %14.3f %14.3f %+8.2f%%%s" % (scenario, name, old, new, change, "  REGRESSION" if regressed else ""))
+
+	return regressions
+
+
+def main():
+	parser = argparse.ArgumentParser(description="run the headless sim benchmark scenarios")
+	parser.add_argument("--spring", default="./spring-headless", help="path to the spring-headless binary")
+	parser.add_argument("--write-dir", required=True, help="spring data-dir containing the game and map")
+	parser.add_argument("--game", required=True, help="base game (archive name) to run the scenarios on")
+	parser.add_argument("--map", required=True, help="map to run the scenarios on")
+	parser.add_argument("--scenario", action="append", choices=SCENARIOS, help="scenario to run, may be repeated (default: all)")
+	parser.add_argument("--modoption", action="append", default=[], help="extra modoption key=value, e.g. benchmark_unit=armpw")
+	parser.add_argument("--frames", type=int, default=1800, help="number of sim-frames to measure")
+	parser.add_argument("--warmup", type=int, default=150, help="number of sim-frames to skip before measuring")
+	parser.add_argument("--timeout", type=int, default=1800, help="seconds after which a scenario is aborted")
+	parser.add_argument("--output", default="benchmark_results", help="directory for per-scenario logs and results")
+	parser.add_argument("--baseline", help="results.json of an earlier run to compare against")
+	parser.add_argument("--threshold", type=float, default=10.0, help="percentage by which a metric may grow before it counts as regression")
+	args = parser.parse_args()
+
+	args.write_dir = os.path.abspath(args.write_dir)
+	args.output = os.path.abspath(args.output)
+
+	os.makedirs(args.output, exist_ok=True)
+
+	gameName = InstallMutator(args.write_dir, args.game)
+	results = {}
+	failures = 0
+
+	for scenario in (args.scenario or SCENARIOS):
+		print("[%s] running %d (+%d warm-up) frames" % (scenario, args.frames, args.warmup))
+		result = RunScenario(args, gameName, scenario)
+
+		if result is None:
+			failures += 1
+			continue
+
+		results[scenario] = result
+		print("[%s] mean %.3fms, p99 %.3fms, peak RSS %.1fMB" % (
+			scenario,
+			result["frameTimeMs"]["mean"],
+			result["frameTimeMs"]["p99"],
+			result["peakRSSBytes"] / (1024.0 * 1024.0)
+		))
+
+	with open(os.path.join(args.output, "results.json"), "w") as f:
+		json.dump(results, f, indent=1, sort_keys=True)
+
+	regressions = 0
+
+	if args.baseline:
+		with open(args.baseline) as f:
+			regressions = CompareResults(results, json.load(f), args.threshold)
+
+	return (1 if (failures > 0 or regressions > 0) else 0)
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,256 @@
+--------------------------------------------------------------------------------
+-- Canned sim benchmark scenarios, selected through the benchmark_scenario
+-- modoption; see tools/benchmark/README.md. Picks its units and weapons from
+-- whatever game this is mutated onto, override them with the benchmark_unit
+-- and benchmark_weapon modoptions if the automatic choice is unsuitable.
+--------------------------------------------------------------------------------
+
+function gadget:GetInfo()
+	return {
+		name    = "Benchmark Scenarios",
+		desc    = "Sets up reproducible sim load for headless benchmarking",
+		author  = "Spring engine developers",
+		date    = "2026",
+		license = "GNU GPL, v2 or later",
+		layer   = -10000,
+		enabled = true,
+	}
+end
+
+local modOptions = Spring.GetModOptions() or {}
+local scenarioName = modOptions.benchmark_scenario or ""
+
+if (scenarioName == "") then
+	return false
+end
+
+if (not gadgetHandler:IsSyncedCode()) then
+	function gadget:Initialize()
+		-- run the sim as fast as it can go; the engine measures frame-times
+		Spring.SendCommands("setmaxspeed 1000", "setminspeed 1000")
+	end
+
+	return
+end
+
+--------------------------------------------------------------------------------
+
+local spCreateUnit       = Spring.CreateUnit
+local spGiveOrderToUnit  = Spring.GiveOrderToUnit
+local spGetGroundHeight  = Spring.GetGroundHeight
+local spAdjustHeightMap  = Spring.AdjustHeightMap
+local spSpawnProjectile  = Spring.SpawnProjectile
+
+local CMD_MOVE  = CMD.MOVE
+local CMD_FIGHT = CMD.FIGHT
+
+local mapSizeX = Game.mapSizeX
+local mapSizeZ = Game.mapSizeZ
+
+local unitCount = tonumber(modOptions.benchmark_count or "")
+
+local teams = {}
+local units = {}
+
+--------------------------------------------------------------------------------
+
+local function RandomMapPos(minX, maxX)
+	local x = math.random(minX or 64, maxX or (mapSizeX - 64))
+	local z = math.random(64, mapSizeZ - 64)
+	return x, spGetGroundHeight(x, z), z
+end
+
+-- cheapest armed ground unit, ties broken by name so the pick is stable
+local function PickUnitDef()
+	if (modOptions.benchmark_unit and UnitDefNames[modOptions.benchmark_unit]) then
+		return modOptions.benchmark_unit
+	end
+
+	local bestName = nil
+	local bestCost = math.huge
+
+	for _, ud in pairs(UnitDefs) do
+		local mobile = (ud.canMove and (not ud.canFly) and ud.speed > 0 and ud.moveDef ~= nil)
+		local armed = (#ud.weapons > 0)
+
+		if (mobile and armed and (not ud.isBuilder)) then
+			local cost = ud.metalCost or ud.cost or 0
+
+			if (cost < bestCost or (cost == bestCost and ud.name < bestName)) then
+				bestName = ud.name
+				bestCost = cost
+			end
+		end
+	end
+
+	return bestName
+end
+
+-- first ballistic weapon (by id), it looks the least odd raining down
+local function PickWeaponDef()
+	if (modOptions.benchmark_weapon and WeaponDefNames[modOptions.benchmark_weapon]) then
+		return WeaponDefNames[modOptions.benchmark_weapon].id
+	end
+
+	for wdID = 0, #WeaponDefs do
+		local wd = WeaponDefs[wdID]
+
+		if (wd ~= nil and wd.type == "Cannon") then
+			return wdID
+		end
+	end
+
+	return nil
+end
+
+local function SpawnUnits(unitDefName, count, teamIdx, minX, maxX)
+	for i = 1, count do
+		local x, y, z = RandomMapPos(minX, maxX)
+		local unitID = spCreateUnit(unitDefName, x, y, z, math.random(0, 3), teams[teamIdx])
+
+		if (unitID ~= nil) then
+			units[#units + 1] = unitID
+		end
+	end
+end
+
+local function OrderRandomMoves(first, step)
+	for i = first, #units, step do
+		local x, y, z = RandomMapPos()
+		spGiveOrderToUnit(units[i], CMD_MOVE, {x, y, z}, {})
+	end
+end
+
+--------------------------------------------------------------------------------
+
+local scenarios = {}
+
+-- many idle units; stresses per-unit update and collision overhead
+scenarios.mass_spawn = {
+	GameFrame = function(n, unitDefName)
+		if (n >= 1 and n <= 30) then
+			SpawnUnits(unitDefName, (unitCount or 3000) / 30, 1 + (n % #teams))
+		end
+	end,
+}
+
+-- two armies fighting across the middle of the map
+scenarios.large_battle = {
+	GameFrame = function(n, unitDefName)
+		if (n == 1) then
+			SpawnUnits(unitDefName, (unitCount or 1000) / 2, 1,                     64, mapSizeX * 0.3)
+			SpawnUnits(unitDefName, (unitCount or 1000) / 2, math.min(2, #teams), mapSizeX * 0.7, mapSizeX - 64)
+		end
+		if (n == 2) then
+			for i = 1, #units do
+				local x = (i <= #units / 2) and (mapSizeX * 0.8) or (mapSizeX * 0.2)
+				local z = mapSizeZ * 0.5
+				spGiveOrderToUnit(units[i], CMD_FIGHT, {x, spGetGroundHeight(x, z), z}, {})
+			end
+		end
+	end,
+}
+
+-- continuous heightmap changes under moving units
+scenarios.terraform = {
+	GameFrame = function(n, unitDefName)
+		if (n == 1) then
+			SpawnUnits(unitDefName, (unitCount or 300), 1)
+		end
+		if ((n % 30) == 2) then
+			OrderRandomMoves(1, 1)
+		end
+
+		for i = 1, 8 do
+			local x1 = math.random(0, mapSizeX - 256)
+			local z1 = math.random(0, mapSizeZ - 256)
+			local size = math.random(32, 256)
+
+			spAdjustHeightMap(x1, z1, x1 + size, z1 + size, math.random(-8, 8))
+		end
+	end,
+}
+
+-- a steady stream of long-distance path requests
+scenarios.path_flood = {
+	GameFrame = function(n, unitDefName)
+		if (n == 1) then
+			SpawnUnits(unitDefName, (unitCount or 1500), 1 + (n % #teams))
+		end
+		if (n >= 2) then
+			-- re-path a fifteenth of all units every frame
+			OrderRandomMoves(1 + (n % 15), 15)
+		end
+	end,
+}
+
+-- lots of short-lived projectiles and explosions
+scenarios.projectile_storm = {
+	GameFrame = function(n, unitDefName, weaponDefID)
+		if (n == 1) then
+			SpawnUnits(unitDefName, (unitCount or 300), 1)
+		end
+		if (n < 2 or weaponDefID == nil) then
+			return
+		end
+
+		for i = 1, 100 do
+			local x, y, z = RandomMapPos()
+
+			spSpawnProjectile(weaponDefID, {
+				pos = {x, y + 1000, z},
+				speed = {0, -10, 0},
+				team = teams[1],
+				ttl = 300,
+			})
+		end
+	end,
+}
+
+--------------------------------------------------------------------------------
+
+local scenario = scenarios[scenarioName]
+local unitDefName = nil
+local weaponDefID = nil
+
+function gadget:Initialize()
+	if (scenario == nil) then
+		Spring.Log(gadget:GetInfo().name, LOG.ERROR, "unknown scenario \"" .. scenarioName .. "\"")
+		gadgetHandler:RemoveGadget(self)
+		return
+	end
+
+	local gaiaTeamID = Spring.GetGaiaTeamID()
+
+	for _, teamID in ipairs(Spring.GetTeamList()) do
+		if (teamID ~= gaiaTeamID) then
+			teams[#teams + 1] = teamID
+		end
+	end
+
+	unitDefName = PickUnitDef()
+	weaponDefID = PickWeaponDef()
+
+	if (unitDefName == nil or #teams == 0) then
+		Spring.Log(gadget:GetInfo().name, LOG.ERROR, "no usable unit or team for scenario \"" .. scenarioName .. "\"")
+		gadgetHandler:RemoveGadget(self)
+		return
+	end
+
+	Spring.Log(gadget:GetInfo().name, LOG.INFO, "running \"" .. scenarioName .. "\" with unit " .. unitDefName)
+end
+
+function gadget:GameFrame(n)
+	scenario.GameFrame(n, unitDefName, weaponDefID)
+end
+
+function gadget:UnitDestroyed(unitID)
+	-- keep the list dense; order does not matter beyond being deterministic
+	for i = 1, #units do
+		if (units[i] == unitID) then
+			units[i] = units[#units]
+			units[#units] = nil
+			return
+		end
+	end
+end